@@ -0,0 +1,201 @@
+#include "MRBench.h"
+#include "MRMesh/MRSystem.h"
+#include "MRPch/MRJson.h"
+#include "MRPch/MRFmt.h"
+#include "MRPch/MRTBB.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <regex>
+#include <thread>
+
+namespace MR::Bench
+{
+
+State::State( int size, int threads, double minTimeSec, int maxIterations )
+    : size_( size )
+    , threads_( threads )
+    , minTimeSec_( minTimeSec )
+    , maxIterations_( maxIterations )
+{
+}
+
+bool State::keepRunning()
+{
+    const auto now = Clock::now();
+    if ( running_ )
+    {
+        const auto t = std::chrono::duration_cast<std::chrono::nanoseconds>( now - iterStart_ ) - paused_;
+        iterationTimes_.push_back( t );
+        total_ += t;
+        running_ = false;
+    }
+    if ( !error_.empty() )
+        return false;
+    if ( !iterationTimes_.empty() &&
+        ( total_.count() * 1e-9 >= minTimeSec_ || (int)iterationTimes_.size() >= maxIterations_ ) )
+        return false;
+
+    running_ = true;
+    paused_ = {};
+    iterStart_ = Clock::now();
+    return true;
+}
+
+void State::pauseTiming()
+{
+    pauseStart_ = Clock::now();
+}
+
+void State::resumeTiming()
+{
+    paused_ += std::chrono::duration_cast<std::chrono::nanoseconds>( Clock::now() - pauseStart_ );
+}
+
+static std::vector<Benchmark> & benchmarks()
+{
+    static std::vector<Benchmark> res;
+    return res;
+}
+
+bool registerBenchmark( std::string name, std::vector<int> sizes, BenchmarkFunc func )
+{
+    benchmarks().push_back( { std::move( name ), std::move( sizes ), std::move( func ) } );
+    return true;
+}
+
+const std::vector<Benchmark> & getBenchmarks()
+{
+    return benchmarks();
+}
+
+static RunResult makeResult( const Benchmark & b, const State & state )
+{
+    RunResult res;
+    res.family = b.name;
+    res.size = state.size();
+    res.threads = state.threads();
+    res.name = fmt::format( "{}/size:{}/threads:{}", b.name, res.size, res.threads );
+    res.iterations = state.iterations();
+    res.error = state.error();
+    if ( res.iterations == 0 )
+        return res;
+
+    auto times = state.iterationTimes();
+    std::chrono::nanoseconds sum{ 0 };
+    for ( auto t : times )
+        sum += t;
+    res.meanTime = sum / res.iterations;
+    std::sort( times.begin(), times.end() );
+    res.minTime = times.front();
+    res.medianTime = times[times.size() / 2];
+
+    const double meanSec = res.meanTime.count() * 1e-9;
+    if ( meanSec > 0 )
+    {
+        res.itemsPerSecond = state.itemsProcessed() / meanSec;
+        res.bytesPerSecond = state.bytesProcessed() / meanSec;
+    }
+    return res;
+}
+
+std::vector<RunResult> runBenchmarks( const RunSettings & settings )
+{
+    std::vector<RunResult> res;
+    const std::regex filter( settings.filter );
+    const int hwThreads = (int)std::max( 1u, std::thread::hardware_concurrency() );
+
+    for ( const auto & b : getBenchmarks() )
+    {
+        if ( !std::regex_search( b.name, filter ) )
+            continue;
+        const auto & sizes = settings.sizes.empty() ? b.sizes : settings.sizes;
+        for ( int threads : settings.threads )
+        {
+            if ( threads <= 0 )
+                threads = hwThreads;
+            tbb::global_control control( tbb::global_control::max_allowed_parallelism, threads );
+            for ( int size : sizes )
+            {
+                State state( size, threads, settings.minTimeSec, settings.maxIterations );
+                try
+                {
+                    b.func( state );
+                }
+                catch ( const std::exception & e )
+                {
+                    state.setError( e.what() );
+                }
+                auto r = makeResult( b, state );
+                if ( !r.error.empty() )
+                    fmt::print( "{:<60} failed: {}\n", r.name, r.error );
+                else
+                    fmt::print( "{:<60} {:>14.3f} ms {:>8} iterations{}\n", r.name, r.meanTime.count() * 1e-6, r.iterations,
+                        r.itemsPerSecond > 0 ? fmt::format( " {:>12.3g} items/s", r.itemsPerSecond ) : std::string() );
+                std::fflush( stdout );
+                res.push_back( std::move( r ) );
+            }
+        }
+    }
+    return res;
+}
+
+bool saveResultsJson( const std::vector<RunResult> & results, const std::string & fileName )
+{
+    Json::Value root;
+    auto & context = root["context"];
+    const auto now = std::time( nullptr );
+    char date[64] = {};
+    std::strftime( date, sizeof( date ), "%Y-%m-%dT%H:%M:%S", std::localtime( &now ) );
+    context["date"] = date;
+    context["executable"] = "MRBench";
+    context["num_cpus"] = (int)std::thread::hardware_concurrency();
+    context["meshlib_version"] = GetMRVersionString();
+    context["cpu"] = GetCpuId();
+#ifdef NDEBUG
+    context["library_build_type"] = "release";
+#else
+    context["library_build_type"] = "debug";
+#endif
+
+    auto & benchmarks = root["benchmarks"] = Json::arrayValue;
+    for ( const auto & r : results )
+    {
+        Json::Value b;
+        b["name"] = r.name;
+        b["run_name"] = r.name;
+        b["run_type"] = "iteration";
+        b["family"] = r.family;
+        b["size"] = r.size;
+        b["threads"] = r.threads;
+        b["iterations"] = r.iterations;
+        b["real_time"] = double( r.meanTime.count() );
+        b["min_time"] = double( r.minTime.count() );
+        b["median_time"] = double( r.medianTime.count() );
+        b["time_unit"] = "ns";
+        if ( r.itemsPerSecond > 0 )
+            b["items_per_second"] = r.itemsPerSecond;
+        if ( r.bytesPerSecond > 0 )
+            b["bytes_per_second"] = r.bytesPerSecond;
+        if ( !r.error.empty() )
+        {
+            b["error_occurred"] = true;
+            b["error_message"] = r.error;
+        }
+        benchmarks.append( std::move( b ) );
+    }
+
+    std::ofstream out( fileName, std::ofstream::binary );
+    if ( !out )
+        return false;
+    Json::StreamWriterBuilder builder;
+    builder["indentation"] = "  ";
+    std::unique_ptr<Json::StreamWriter> writer( builder.newStreamWriter() );
+    writer->write( root, &out );
+    out << '\n';
+    return bool( out );
+}
+
+} // namespace MR::Bench
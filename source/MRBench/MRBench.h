@@ -0,0 +1,121 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace MR::Bench
+{
+
+/// the state of one benchmark run (given problem size and number of threads):
+/// the benchmark body repeats the measured operation while keepRunning() returns true
+class State
+{
+public:
+    State( int size, int threads, double minTimeSec, int maxIterations );
+
+    /// problem size of this run (e.g. the number of mesh vertices or voxels along each axis)
+    [[nodiscard]] int size() const { return size_; }
+    /// maximal number of threads allowed in this run
+    [[nodiscard]] int threads() const { return threads_; }
+
+    /// finishes the measurement of previous iteration (if any) and returns true if one more iteration is necessary
+    bool keepRunning();
+
+    /// excludes the time until resumeTiming() from the measurement, e.g. to prepare a copy of input data
+    void pauseTiming();
+    void resumeTiming();
+
+    /// sets the number of processed items or bytes per one iteration to report the throughput
+    void setItemsProcessed( double items ) { items_ = items; }
+    void setBytesProcessed( double bytes ) { bytes_ = bytes; }
+
+    /// marks this run as failed with given message, keepRunning() will return false afterwards
+    void setError( std::string message ) { error_ = std::move( message ); }
+
+    [[nodiscard]] int iterations() const { return (int)iterationTimes_.size(); }
+    [[nodiscard]] const std::vector<std::chrono::nanoseconds> & iterationTimes() const { return iterationTimes_; }
+    [[nodiscard]] double itemsProcessed() const { return items_; }
+    [[nodiscard]] double bytesProcessed() const { return bytes_; }
+    [[nodiscard]] const std::string & error() const { return error_; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    int size_ = 0;
+    int threads_ = 0;
+    double minTimeSec_ = 0;
+    int maxIterations_ = 0;
+
+    bool running_ = false;
+    Clock::time_point iterStart_;
+    Clock::time_point pauseStart_;
+    std::chrono::nanoseconds paused_{ 0 };
+    std::chrono::nanoseconds total_{ 0 };
+    std::vector<std::chrono::nanoseconds> iterationTimes_;
+
+    double items_ = 0;
+    double bytes_ = 0;
+    std::string error_;
+};
+
+using BenchmarkFunc = std::function<void( State & )>;
+
+struct Benchmark
+{
+    std::string name;
+    /// the benchmark is run for each of these problem sizes
+    std::vector<int> sizes;
+    BenchmarkFunc func;
+};
+
+/// adds the benchmark in the global list, returns true to be used in static initialization
+bool registerBenchmark( std::string name, std::vector<int> sizes, BenchmarkFunc func );
+
+/// returns all registered benchmarks in the order of registration
+[[nodiscard]] const std::vector<Benchmark> & getBenchmarks();
+
+struct RunSettings
+{
+    /// only benchmarks with names matching this regular expression are run
+    std::string filter = ".*";
+    /// each benchmark is run with each of these thread counts, 0 means all hardware threads
+    std::vector<int> threads = { 1, 0 };
+    /// if not empty, overrides benchmark's own problem sizes
+    std::vector<int> sizes;
+    /// minimal total measured time of one run
+    double minTimeSec = 0.5;
+    /// maximal number of iterations in one run
+    int maxIterations = 1000;
+};
+
+struct RunResult
+{
+    std::string name;
+    std::string family;
+    int size = 0;
+    int threads = 0;
+    int iterations = 0;
+    std::chrono::nanoseconds meanTime{ 0 };
+    std::chrono::nanoseconds minTime{ 0 };
+    std::chrono::nanoseconds medianTime{ 0 };
+    double itemsPerSecond = 0;
+    double bytesPerSecond = 0;
+    std::string error;
+};
+
+/// runs all matching benchmarks printing a line per run in the standard output, and returns their results
+std::vector<RunResult> runBenchmarks( const RunSettings & settings );
+
+/// saves the results in Google Benchmark compatible JSON format, suitable for trend tracking tools
+bool saveResultsJson( const std::vector<RunResult> & results, const std::string & fileName );
+
+} // namespace MR::Bench
+
+/// defines and registers a benchmark with given name and problem sizes:
+/// MR_BENCHMARK( myKernel, 1000, 100000 ) { while ( state.keepRunning() ) { ... } }
+#define MR_BENCHMARK( name, ... ) \
+    static void name##Bench( MR::Bench::State & state ); \
+    [[maybe_unused]] static const bool name##Registered = MR::Bench::registerBenchmark( #name, { __VA_ARGS__ }, name##Bench ); \
+    static void name##Bench( MR::Bench::State & state )
@@ -0,0 +1,134 @@
+#include "MRBench.h"
+#include "MRMesh/MRTimerTrace.h"
+#include "MRMesh/MRTimer.h"
+
+#pragma warning(push)
+#if _MSC_VER >= 1937 // Visual Studio 2022 version 17.7
+#pragma warning(disable: 5267) //definition of implicit copy constructor is deprecated because it has a user-provided destructor
+#endif
+
+#if (defined(__APPLE__) && defined(__clang__))
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-copy-with-dtor"
+#endif
+
+#include <boost/program_options.hpp>
+
+#if (defined(__APPLE__) && defined(__clang__))
+#pragma clang diagnostic pop
+#endif
+
+#pragma warning(pop)
+
+#include <boost/exception/diagnostic_information.hpp>
+#include <iostream>
+#include <sstream>
+
+namespace
+{
+
+// parses comma-separated list of integers like "1,4,0"
+std::vector<int> parseIntList( const std::string & s )
+{
+    std::vector<int> res;
+    std::istringstream in( s );
+    std::string item;
+    while ( std::getline( in, item, ',' ) )
+        if ( !item.empty() )
+            res.push_back( std::stoi( item ) );
+    return res;
+}
+
+int mainInternal( int argc, char **argv )
+{
+    MR::printTimingTreeAtEnd( false );
+
+    MR::Bench::RunSettings settings;
+    std::string threads = "1,0";
+    std::string sizes;
+    std::string jsonFile;
+    std::string traceFile;
+
+    namespace po = boost::program_options;
+    po::options_description options( "Options" );
+    options.add_options()
+        ( "help", "produce help message" )
+        ( "list", "print names of all benchmarks and exit" )
+        ( "filter", po::value<std::string>( &settings.filter ), "run only benchmarks with names matching this regular expression" )
+        ( "threads", po::value<std::string>( &threads ), "comma-separated list of thread counts, 0 means all hardware threads (default: 1,0)" )
+        ( "sizes", po::value<std::string>( &sizes ), "comma-separated list of problem sizes overriding the default ones" )
+        ( "min-time", po::value<double>( &settings.minTimeSec ), "minimal measured time of each run in seconds (default: 0.5)" )
+        ( "max-iterations", po::value<int>( &settings.maxIterations ), "maximal number of iterations in each run (default: 1000)" )
+        ( "json", po::value<std::string>( &jsonFile ), "save results in this JSON file (Google Benchmark format)" )
+        ( "trace", po::value<std::string>( &traceFile ), "save timer trace of all runs in this Chrome trace-event JSON file" )
+        ;
+
+    po::variables_map vm;
+    po::store( po::parse_command_line( argc, argv, options ), vm );
+    po::notify( vm );
+
+    if ( vm.count( "help" ) )
+    {
+        std::cout <<
+            "MRBench runs microbenchmarks of MeshLib core algorithms on synthetic meshes\n"
+            "Usage: MRBench [options]\n"
+            << options << "\n";
+        return 0;
+    }
+
+    if ( vm.count( "list" ) )
+    {
+        for ( const auto & b : MR::Bench::getBenchmarks() )
+        {
+            std::cout << b.name << ":";
+            for ( int size : b.sizes )
+                std::cout << " " << size;
+            std::cout << "\n";
+        }
+        return 0;
+    }
+
+    settings.threads = parseIntList( threads );
+    settings.sizes = parseIntList( sizes );
+
+    if ( !traceFile.empty() )
+        MR::setTimerTracing( true );
+
+    const auto results = MR::Bench::runBenchmarks( settings );
+
+    if ( !traceFile.empty() )
+    {
+        MR::setTimerTracing( false );
+        if ( auto res = MR::saveTimerTraceJson( std::filesystem::path( traceFile ) ); !res )
+        {
+            std::cerr << res.error() << "\n";
+            return 1;
+        }
+    }
+
+    if ( !jsonFile.empty() && !MR::Bench::saveResultsJson( results, jsonFile ) )
+    {
+        std::cerr << "Cannot save results in " << jsonFile << "\n";
+        return 1;
+    }
+
+    for ( const auto & r : results )
+        if ( !r.error.empty() )
+            return 1;
+    return 0;
+}
+
+} // anonymous namespace
+
+int main( int argc, char **argv )
+{
+    try
+    {
+        return mainInternal( argc, argv );
+    }
+    catch ( ... )
+    {
+        std::cerr << "Exception: " << boost::current_exception_diagnostic_information();
+        return 2;
+    }
+}
@@ -0,0 +1,69 @@
+#include "MRBenchMeshes.h"
+#include "MRMesh/MRMesh.h"
+#include "MRMesh/MRMakeSphereMesh.h"
+#include "MRMesh/MRRegularGridMesh.h"
+#include "MRMesh/MRTorus.h"
+
+#include <cmath>
+#include <map>
+#include <mutex>
+
+namespace MR::Bench
+{
+
+namespace
+{
+
+template <typename F>
+const Mesh & cached( std::map<int, Mesh> & cache, int numVerts, F && make )
+{
+    static std::mutex mutex;
+    std::lock_guard lock( mutex );
+    auto it = cache.find( numVerts );
+    if ( it == cache.end() )
+        it = cache.emplace( numVerts, make() ).first;
+    return it->second;
+}
+
+} // anonymous namespace
+
+const Mesh & benchSphere( int numVerts )
+{
+    static std::map<int, Mesh> cache;
+    return cached( cache, numVerts, [numVerts]
+    {
+        return makeSphere( { .radius = 1.0f, .numMeshVertices = numVerts } );
+    } );
+}
+
+const Mesh & benchTorus( int numVerts )
+{
+    static std::map<int, Mesh> cache;
+    return cached( cache, numVerts, [numVerts]
+    {
+        // primary resolution is about 3 times larger than secondary one to keep triangles well-shaped
+        const int secondary = std::max( 3, (int)std::sqrt( numVerts / 3.0 ) );
+        const int primary = std::max( 3, numVerts / secondary );
+        return makeTorus( 1.0f, 0.3f, primary, secondary );
+    } );
+}
+
+const Mesh & benchGrid( int numVerts )
+{
+    static std::map<int, Mesh> cache;
+    return cached( cache, numVerts, [numVerts]
+    {
+        const size_t side = std::max( 2, (int)std::sqrt( (double)numVerts ) );
+        const float step = 1.0f / ( side - 1 );
+        auto res = makeRegularGridMesh( side, side,
+            [] ( size_t, size_t ) { return true; },
+            [step] ( size_t x, size_t y )
+            {
+                const float fx = x * step, fy = y * step;
+                return Vector3f( fx, fy, 0.05f * std::sin( 20 * fx ) * std::cos( 15 * fy ) );
+            } );
+        return res ? std::move( *res ) : Mesh{};
+    } );
+}
+
+} // namespace MR::Bench
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "MRMesh/MRMeshFwd.h"
+
+namespace MR::Bench
+{
+
+/// deterministic synthetic meshes shared between benchmarks;
+/// each mesh is created once per size and then returned by reference
+
+/// irregular sphere of unit radius with approximately given number of vertices
+[[nodiscard]] const Mesh & benchSphere( int numVerts );
+
+/// torus with major radius 1 and minor radius 0.3 having approximately given number of vertices
+[[nodiscard]] const Mesh & benchTorus( int numVerts );
+
+/// open wavy surface on a square regular grid with approximately given number of vertices
+[[nodiscard]] const Mesh & benchGrid( int numVerts );
+
+} // namespace MR::Bench
@@ -0,0 +1,69 @@
+#include "MRBench.h"
+#include "MRBenchMeshes.h"
+#include "MRMesh/MRMesh.h"
+#include "MRMesh/MRMeshLoad.h"
+#include "MRMesh/MRMeshSave.h"
+
+#include <sstream>
+
+namespace MR::Bench
+{
+
+namespace
+{
+
+using SaveFunc = Expected<void>( * )( const Mesh &, std::ostream &, const SaveSettings & );
+using LoadFunc = Expected<Mesh>( * )( std::istream &, const MeshLoadSettings & );
+
+void benchSave( State & state, SaveFunc save )
+{
+    const auto & mesh = benchSphere( state.size() );
+    size_t bytes = 0;
+    while ( state.keepRunning() )
+    {
+        std::ostringstream out;
+        if ( auto res = save( mesh, out, {} ); !res )
+            state.setError( res.error() );
+        bytes = out.tellp();
+    }
+    state.setItemsProcessed( (double)mesh.topology.numValidFaces() );
+    state.setBytesProcessed( (double)bytes );
+}
+
+void benchLoad( State & state, SaveFunc save, LoadFunc load )
+{
+    std::string data;
+    {
+        std::ostringstream out;
+        if ( auto res = save( benchSphere( state.size() ), out, {} ); !res )
+            return state.setError( res.error() );
+        data = std::move( out ).str();
+    }
+    size_t numFaces = 0;
+    while ( state.keepRunning() )
+    {
+        state.pauseTiming();
+        std::istringstream in( data );
+        state.resumeTiming();
+        auto res = load( in, {} );
+        if ( !res )
+            state.setError( res.error() );
+        else
+            numFaces = res->topology.numValidFaces();
+    }
+    state.setItemsProcessed( (double)numFaces );
+    state.setBytesProcessed( (double)data.size() );
+}
+
+} // anonymous namespace
+
+MR_BENCHMARK( saveBinaryStl, 100'000, 1'000'000, 10'000'000 ) { benchSave( state, MeshSave::toBinaryStl ); }
+MR_BENCHMARK( loadBinaryStl, 100'000, 1'000'000, 10'000'000 ) { benchLoad( state, MeshSave::toBinaryStl, MR::loadBinaryStl ); }
+MR_BENCHMARK( savePly, 100'000, 1'000'000, 10'000'000 ) { benchSave( state, MeshSave::toPly ); }
+MR_BENCHMARK( loadPly, 100'000, 1'000'000 ) { benchLoad( state, MeshSave::toPly, MR::loadPly ); }
+MR_BENCHMARK( saveObj, 100'000, 1'000'000 ) { benchSave( state, MeshSave::toObj ); }
+MR_BENCHMARK( loadObj, 100'000, 1'000'000 ) { benchLoad( state, MeshSave::toObj, MR::loadObj ); }
+MR_BENCHMARK( saveMrmesh, 100'000, 1'000'000 ) { benchSave( state, MeshSave::toMrmesh ); }
+MR_BENCHMARK( loadMrmesh, 100'000, 1'000'000 ) { benchLoad( state, MeshSave::toMrmesh, MR::loadMrmesh ); }
+
+} // namespace MR::Bench
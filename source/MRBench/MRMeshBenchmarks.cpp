@@ -0,0 +1,355 @@
+#include "MRBench.h"
+#include "MRBenchMeshes.h"
+#include "MRMesh/MRAffineXf3.h"
+#include "MRMesh/MRBitSet.h"
+#include "MRMesh/MRExtractIsolines.h"
+#include "MRMesh/MRHeatGeodesics.h"
+#include "MRMesh/MRLine3.h"
+#include "MRMesh/MRMesh.h"
+#include "MRMesh/MRMeshBoolean.h"
+#include "MRMesh/MRMeshBuilder.h"
+#include "MRMesh/MRMeshCollide.h"
+#include "MRMesh/MRMeshDecimate.h"
+#include "MRMesh/MRMeshFillHole.h"
+#include "MRMesh/MRMeshIntersect.h"
+#include "MRMesh/MRMeshProject.h"
+#include "MRMesh/MRMeshRelax.h"
+#include "MRMesh/MRParallelFor.h"
+#include "MRMesh/MRQuantizedVertCoords.h"
+#include "MRMesh/MRSurfaceDistance.h"
+
+#include <cmath>
+#include <numeric>
+#include <random>
+
+namespace MR::Bench
+{
+
+namespace
+{
+
+constexpr int cNumQueries = 100'000;
+
+/// points evenly distributed on a sphere of given radius (Fibonacci lattice)
+std::vector<Vector3f> spherePoints( int n, float radius )
+{
+    std::vector<Vector3f> res( n );
+    const float golden = 2.39996323f;
+    for ( int i = 0; i < n; ++i )
+    {
+        const float z = 1 - ( 2 * i + 1 ) / float( n );
+        const float r = std::sqrt( std::max( 0.0f, 1 - z * z ) );
+        const float a = golden * i;
+        res[i] = radius * Vector3f( r * std::cos( a ), r * std::sin( a ), z );
+    }
+    return res;
+}
+
+/// z-levels evenly covering the torus made by benchTorus
+std::vector<float> torusSlices( int n )
+{
+    std::vector<float> res( n );
+    for ( int i = 0; i < n; ++i )
+        res[i] = -0.3f + 0.6f * ( i + 0.5f ) / n;
+    return res;
+}
+
+constexpr int cNumSlices = 1000;
+
+/// returns an error message if decoded coordinates deviate from original ones more than declared by quantization
+std::string checkQuantization( const VertCoords & points, const QuantizedVertCoords & q )
+{
+    const auto maxErr = q.maxError() + Vector3f::diagonal( 1e-6f * q.box().diagonal() );
+    for ( auto v = 0_v; v < points.size(); ++v )
+    {
+        const auto d = q[v] - points[v];
+        if ( std::abs( d.x ) > maxErr.x || std::abs( d.y ) > maxErr.y || std::abs( d.z ) > maxErr.z )
+            return "Quantization error exceeds the bound";
+    }
+    return {};
+}
+
+} // anonymous namespace
+
+MR_BENCHMARK( findProjection, 10'000, 100'000, 1'000'000 )
+{
+    const auto & mesh = benchSphere( state.size() );
+    (void)mesh.getAABBTree();
+    const auto pts = spherePoints( cNumQueries, 1.5f );
+    std::vector<float> distSq( pts.size() );
+    while ( state.keepRunning() )
+    {
+        ParallelFor( pts, [&] ( size_t i )
+        {
+            distSq[i] = findProjection( pts[i], mesh ).distSq;
+        } );
+    }
+    state.setItemsProcessed( cNumQueries );
+}
+
+MR_BENCHMARK( rayMeshIntersect, 10'000, 100'000, 1'000'000 )
+{
+    const auto & mesh = benchSphere( state.size() );
+    (void)mesh.getAABBTree();
+    const auto pts = spherePoints( cNumQueries, 2.0f );
+    std::vector<float> dist( pts.size() );
+    while ( state.keepRunning() )
+    {
+        ParallelFor( pts, [&] ( size_t i )
+        {
+            // rays from outside to the center with small offset to avoid hitting exactly mesh vertices
+            const Line3f line( pts[i], Vector3f( 0.01f, 0.02f, 0.03f ) - pts[i] );
+            dist[i] = rayMeshIntersect( mesh, line ).distanceAlongLine;
+        } );
+    }
+    state.setItemsProcessed( cNumQueries );
+}
+
+MR_BENCHMARK( findCollidingTriangles, 10'000, 100'000, 1'000'000 )
+{
+    const auto & mesh = benchTorus( state.size() );
+    (void)mesh.getAABBTree();
+    // the same torus rotated around X-axis crosses the original one along four closed curves
+    const auto xf = AffineXf3f::linear( Matrix3f::rotation( Vector3f::plusX(), 0.5f ) );
+    while ( state.keepRunning() )
+    {
+        auto res = findCollidingTriangles( mesh, mesh, &xf );
+        if ( res.empty() )
+            state.setError( "no collisions found" );
+    }
+    state.setItemsProcessed( (double)mesh.topology.numValidFaces() );
+}
+
+MR_BENCHMARK( findSelfCollidingTriangles, 10'000, 100'000, 1'000'000 )
+{
+    const auto & mesh = benchTorus( state.size() );
+    (void)mesh.getAABBTree();
+    while ( state.keepRunning() )
+    {
+        auto res = findSelfCollidingTriangles( mesh );
+        if ( !res )
+            state.setError( res.error() );
+    }
+    state.setItemsProcessed( (double)mesh.topology.numValidFaces() );
+}
+
+MR_BENCHMARK( decimateMesh, 10'000, 100'000, 1'000'000 )
+{
+    const auto & orig = benchSphere( state.size() );
+    DecimateSettings settings;
+    settings.maxDeletedFaces = orig.topology.numValidFaces() * 9 / 10;
+    settings.maxError = 0.01f;
+    while ( state.keepRunning() )
+    {
+        state.pauseTiming();
+        Mesh mesh = orig;
+        state.resumeTiming();
+        decimateMesh( mesh, settings );
+    }
+    state.setItemsProcessed( (double)orig.topology.numValidFaces() );
+}
+
+MR_BENCHMARK( boolean, 10'000, 100'000, 1'000'000 )
+{
+    const auto & mesh = benchSphere( state.size() );
+    (void)mesh.getAABBTree();
+    const auto xf = AffineXf3f::translation( Vector3f( 0.5f, 0.3f, 0.1f ) );
+    while ( state.keepRunning() )
+    {
+        auto res = MR::boolean( mesh, mesh, BooleanOperation::Union, &xf );
+        if ( !res )
+            state.setError( res.errorString );
+    }
+    state.setItemsProcessed( 2.0 * mesh.topology.numValidFaces() );
+}
+
+MR_BENCHMARK( relax, 10'000, 100'000, 1'000'000 )
+{
+    const auto & orig = benchSphere( state.size() );
+    MeshRelaxParams params;
+    params.iterations = 5;
+    while ( state.keepRunning() )
+    {
+        state.pauseTiming();
+        Mesh mesh = orig;
+        state.resumeTiming();
+        relax( mesh, params );
+    }
+    state.setItemsProcessed( 5.0 * orig.topology.numValidVerts() );
+}
+
+MR_BENCHMARK( fromTriangles, 10'000, 100'000, 1'000'000 )
+{
+    const auto t = benchGrid( state.size() ).topology.getTriangulation();
+    while ( state.keepRunning() )
+    {
+        auto topology = MeshBuilder::fromTriangles( t );
+        if ( topology.numValidFaces() != t.size() )
+            state.setError( "not all triangles were added" );
+    }
+    state.setItemsProcessed( (double)t.size() );
+}
+
+MR_BENCHMARK( fromShuffledTriangles, 100'000, 1'000'000, 10'000'000 )
+{
+    // triangles and vertices in random order as in triangle soups from scanners
+    Triangulation t;
+    {
+        const auto & grid = benchGrid( state.size() );
+        std::mt19937 rnd( 0 );
+        std::vector<VertId> newVert( grid.topology.vertSize() );
+        std::iota( newVert.begin(), newVert.end(), 0_v );
+        std::shuffle( newVert.begin(), newVert.end(), rnd );
+        auto tris = grid.topology.getAllTriVerts();
+        std::shuffle( tris.begin(), tris.end(), rnd );
+        t.reserve( tris.size() );
+        for ( const auto & tri : tris )
+            t.push_back( { newVert[tri[0]], newVert[tri[1]], newVert[tri[2]] } );
+    }
+    while ( state.keepRunning() )
+    {
+        auto topology = MeshBuilder::fromTriangles( t );
+        if ( topology.numValidFaces() != t.size() )
+            state.setError( "not all triangles were added" );
+    }
+    state.setItemsProcessed( (double)t.size() );
+}
+
+MR_BENCHMARK( fillHoles, 10'000, 100'000, 1'000'000 )
+{
+    // many small holes as in raw scans
+    Mesh orig = benchSphere( state.size() );
+    FaceBitSet toDelete( orig.topology.faceSize() );
+    for ( FaceId f( 0 ); f < toDelete.size(); f += 50 )
+        toDelete.set( f );
+    orig.topology.deleteFaces( toDelete );
+    const auto holes = orig.topology.findHoleRepresentiveEdges();
+    while ( state.keepRunning() )
+    {
+        state.pauseTiming();
+        Mesh mesh = orig;
+        state.resumeTiming();
+        fillHoles( mesh, holes );
+    }
+    state.setItemsProcessed( (double)holes.size() );
+}
+
+MR_BENCHMARK( xyPlaneSectionsLoop, 10'000, 100'000, 1'000'000 )
+{
+    const auto & mesh = benchTorus( state.size() );
+    (void)mesh.getAABBTree();
+    const auto zLevels = torusSlices( cNumSlices );
+    std::vector<PlaneSections> res( zLevels.size() );
+    while ( state.keepRunning() )
+    {
+        ParallelFor( zLevels, [&] ( size_t i )
+        {
+            res[i] = extractXYPlaneSections( mesh, zLevels[i] );
+        } );
+    }
+    state.setItemsProcessed( cNumSlices );
+}
+
+MR_BENCHMARK( xyPlaneSectionsBatch, 10'000, 100'000, 1'000'000 )
+{
+    const auto & mesh = benchTorus( state.size() );
+    const auto zLevels = torusSlices( cNumSlices );
+    while ( state.keepRunning() )
+    {
+        auto res = extractXYPlaneSections( mesh, zLevels );
+        if ( !res )
+            state.setError( res.error() );
+    }
+    state.setItemsProcessed( cNumSlices );
+}
+
+MR_BENCHMARK( quantizeVertCoords16, 10'000, 100'000, 1'000'000 )
+{
+    const auto & mesh = benchSphere( state.size() );
+    QuantizedVertCoords q;
+    while ( state.keepRunning() )
+    {
+        q = QuantizedVertCoords( mesh.points, QuantizedVertCoords::Precision::Bits16 );
+    }
+    if ( auto err = checkQuantization( mesh.points, q ); !err.empty() )
+        state.setError( std::move( err ) );
+    state.setItemsProcessed( (double)mesh.points.size() );
+    state.setBytesProcessed( (double)q.heapBytes() );
+}
+
+MR_BENCHMARK( quantizeVertCoords21, 10'000, 100'000, 1'000'000 )
+{
+    const auto & mesh = benchSphere( state.size() );
+    QuantizedVertCoords q;
+    while ( state.keepRunning() )
+    {
+        q = QuantizedVertCoords( mesh.points, QuantizedVertCoords::Precision::Bits21 );
+    }
+    if ( auto err = checkQuantization( mesh.points, q ); !err.empty() )
+        state.setError( std::move( err ) );
+    state.setItemsProcessed( (double)mesh.points.size() );
+    state.setBytesProcessed( (double)q.heapBytes() );
+}
+
+MR_BENCHMARK( decodeQuantizedVertCoords16, 10'000, 100'000, 1'000'000 )
+{
+    const auto & mesh = benchSphere( state.size() );
+    const QuantizedVertCoords q( mesh.points, QuantizedVertCoords::Precision::Bits16 );
+    VertCoords points;
+    while ( state.keepRunning() )
+    {
+        q.decode( points );
+    }
+    state.setItemsProcessed( (double)q.size() );
+}
+
+MR_BENCHMARK( decodeQuantizedVertCoords21, 10'000, 100'000, 1'000'000 )
+{
+    const auto & mesh = benchSphere( state.size() );
+    const QuantizedVertCoords q( mesh.points, QuantizedVertCoords::Precision::Bits21 );
+    VertCoords points;
+    while ( state.keepRunning() )
+    {
+        q.decode( points );
+    }
+    state.setItemsProcessed( (double)q.size() );
+}
+
+MR_BENCHMARK( surfaceDistances, 10'000, 100'000, 1'000'000 )
+{
+    const auto & mesh = benchSphere( state.size() );
+    VertBitSet start( mesh.topology.vertSize() );
+    start.set( 0_v );
+    while ( state.keepRunning() )
+    {
+        (void)computeSurfaceDistances( mesh, start );
+    }
+    state.setItemsProcessed( (double)mesh.topology.numValidVerts() );
+}
+
+MR_BENCHMARK( surfaceDistancesParallel, 10'000, 100'000, 1'000'000 )
+{
+    const auto & mesh = benchSphere( state.size() );
+    VertBitSet start( mesh.topology.vertSize() );
+    start.set( 0_v );
+    while ( state.keepRunning() )
+    {
+        (void)computeSurfaceDistancesParallel( mesh, start );
+    }
+    state.setItemsProcessed( (double)mesh.topology.numValidVerts() );
+}
+
+MR_BENCHMARK( heatGeodesics, 10'000, 100'000, 1'000'000 )
+{
+    const auto & mesh = benchSphere( state.size() );
+    VertBitSet start( mesh.topology.vertSize() );
+    start.set( 0_v );
+    (void)mesh.getHeatGeodesics(); // factorization is done once and is not measured
+    while ( state.keepRunning() )
+    {
+        (void)computeHeatGeodesics( mesh, start );
+    }
+    state.setItemsProcessed( (double)mesh.topology.numValidVerts() );
+}
+
+} // namespace MR::Bench
@@ -0,0 +1,317 @@
+#ifndef MESHLIB_NO_VOXELS
+#include "MRBench.h"
+#include "MRBenchMeshes.h"
+#include "MRMesh/MRMesh.h"
+#include "MRMesh/MRParallelFor.h"
+#include "MRMesh/MRParallelMinMax.h"
+#include "MRMesh/MRUniqueTemporaryFolder.h"
+#include "MRMesh/MRVolumeIndexer.h"
+#include "MRVoxels/MRDicom.h"
+#include "MRVoxels/MRMarchingCubes.h"
+#include "MRVoxels/MRMeshToDistanceVolume.h"
+#include "MRVoxels/MRVDBConversions.h"
+#include "MRVoxels/MRVoxelGraphCut.h"
+#include "MRVoxels/MRVoxelFilter.h"
+#include "MRVoxels/MRVoxelsVolume.h"
+
+#include <cmath>
+#include <sstream>
+
+namespace MR::Bench
+{
+
+namespace
+{
+
+/// dense volume of size^3 voxels with signed distances to a sphere inscribed in it
+SimpleVolume sphereDistanceVolume( int size )
+{
+    SimpleVolume vol;
+    vol.dims = Vector3i::diagonal( size );
+    vol.voxelSize = Vector3f::diagonal( 2.0f / size );
+    vol.data.resize( size_t( size ) * size * size );
+    const Vector3f center = Vector3f::diagonal( 0.5f * ( size - 1 ) );
+    ParallelFor( 0, size, [&] ( int z )
+    {
+        size_t n = size_t( z ) * size * size;
+        for ( int y = 0; y < size; ++y )
+            for ( int x = 0; x < size; ++x, ++n )
+                vol.data[VoxelId( n )] = ( Vector3f( float( x ), float( y ), float( z ) ) - center ).length() - 0.4f * size;
+    } );
+    return vol;
+}
+
+/// dense 16-bit volume of size^3 voxels with smooth field and noise as in CT scans
+SimpleVolumeU16 noisyVolumeU16( int size )
+{
+    SimpleVolumeU16 vol;
+    vol.dims = Vector3i::diagonal( size );
+    vol.data.resize( size_t( size ) * size * size );
+    ParallelFor( 0, size, [&] ( int z )
+    {
+        size_t n = size_t( z ) * size * size;
+        auto seed = unsigned( z ) * 2654435761u;
+        for ( int y = 0; y < size; ++y )
+            for ( int x = 0; x < size; ++x, ++n )
+            {
+                seed = seed * 1103515245u + 12345u;
+                const float smooth = 1000 + 800 * std::sin( x * 0.05f ) * std::cos( y * 0.03f + z * 0.02f );
+                vol.data[VoxelId( n )] = uint16_t( smooth + float( ( seed >> 16 ) & 63 ) );
+            }
+    } );
+    return vol;
+}
+
+SimpleVolumeMinMax toSimpleVolume( const SimpleVolumeU16& vol )
+{
+    SimpleVolumeMinMax res;
+    res.dims = vol.dims;
+    res.voxelSize = vol.voxelSize;
+    res.data.resize( vol.data.size() );
+    ParallelFor( vol.data, [&] ( VoxelId v )
+    {
+        res.data[v] = vol.data[v];
+    } );
+    std::tie( res.min, res.max ) = parallelMinMax( res.data );
+    return res;
+}
+
+#ifndef MRVOXELS_NO_DICOM
+/// writes the slices of given volume in separate DICOM files as in CT series, returns the total size of the files
+size_t saveDicomSeries( const SimpleVolumeU16& vol, const std::filesystem::path& folder )
+{
+    const size_t sliceSize = size_t( vol.dims.x ) * vol.dims.y;
+    size_t bytes = 0;
+    for ( int z = 0; z < vol.dims.z; ++z )
+    {
+        SimpleVolumeU16 slice{ .dims = { vol.dims.x, vol.dims.y, 1 }, .voxelSize = vol.voxelSize };
+        slice.data.resize( sliceSize );
+        std::copy_n( vol.data.data() + z * sliceSize, sliceSize, slice.data.data() );
+        const auto file = folder / ( "slice" + std::to_string( z ) + ".dcm" );
+        if ( !VoxelsSave::toDicom( slice, file, MinMaxf{ -1024.f, 65535.f - 1024.f } ) )
+            return 0;
+        bytes += std::filesystem::file_size( file );
+    }
+    return bytes;
+}
+
+/// loads the series of size^3 voxels saved in temporary folder with given function
+template <typename F>
+void benchLoadDicomFolder( State & state, F && load )
+{
+    UniqueTemporaryFolder folder;
+    const auto bytes = saveDicomSeries( noisyVolumeU16( state.size() ), folder );
+    if ( bytes == 0 )
+        return state.setError( "cannot save DICOM series" );
+    while ( state.keepRunning() )
+    {
+        auto res = load( folder, unsigned( state.threads() ) );
+        if ( !res )
+            return state.setError( res.error() );
+    }
+    state.setItemsProcessed( double( state.size() ) * state.size() * state.size() );
+    state.setBytesProcessed( (double)bytes );
+}
+#endif
+
+/// noisy density of a ball with seeds in its center and on the boundary of the volume
+struct GraphCutTask
+{
+    SimpleVolume density;
+    VoxelBitSet sourceSeeds;
+    VoxelBitSet sinkSeeds;
+};
+
+GraphCutTask ballGraphCutTask( int size )
+{
+    GraphCutTask res;
+    res.density = sphereDistanceVolume( size );
+    const VolumeIndexer indexer( res.density.dims );
+    res.sourceSeeds.resize( indexer.size() );
+    res.sinkSeeds.resize( indexer.size() );
+    for ( auto v = 0_vox; v < indexer.endId(); ++v )
+    {
+        const auto dist = res.density.data[v];
+        const auto pos = indexer.toPos( v );
+        if ( dist < 3 - 0.4f * size )
+            res.sourceSeeds.set( v );
+        else if ( indexer.isBdVoxel( pos ) )
+            res.sinkSeeds.set( v );
+        const auto noise = 0.3f * std::abs( std::sin( 12.9898f * pos.x + 78.233f * pos.y + 37.719f * pos.z ) );
+        res.density.data[v] = ( dist < 0 ? 1.0f : 0.0f ) + noise;
+    }
+    return res;
+}
+
+} // anonymous namespace
+
+MR_BENCHMARK( marchingCubes, 64, 256, 512 )
+{
+    const auto vol = sphereDistanceVolume( state.size() );
+    MarchingCubesParams params;
+    params.lessInside = true;
+    while ( state.keepRunning() )
+    {
+        auto res = marchingCubes( vol, params );
+        if ( !res )
+            state.setError( res.error() );
+    }
+    state.setItemsProcessed( (double)vol.data.size() );
+}
+
+MR_BENCHMARK( marchingCubesToBinaryStl, 64, 256, 512 )
+{
+    const auto vol = sphereDistanceVolume( state.size() );
+    MarchingCubesParams params;
+    params.lessInside = true;
+    size_t bytes = 0;
+    while ( state.keepRunning() )
+    {
+        std::ostringstream out;
+        if ( auto res = marchingCubesToBinaryStl( vol, out, params ); !res )
+            state.setError( res.error() );
+        bytes = out.tellp();
+    }
+    state.setItemsProcessed( (double)vol.data.size() );
+    state.setBytesProcessed( (double)bytes );
+}
+
+MR_BENCHMARK( meshToDistanceVolume, 64, 128, 256 )
+{
+    const auto & mesh = benchSphere( 100'000 );
+    (void)mesh.getAABBTree();
+    const int size = state.size();
+    MeshToDistanceVolumeParams params;
+    params.vol.dimensions = Vector3i::diagonal( size );
+    params.vol.voxelSize = Vector3f::diagonal( 3.0f / size );
+    params.vol.origin = Vector3f::diagonal( -1.5f );
+    params.dist.maxDistSq = sqr( 6.0f / size );
+    params.dist.nullOutsideMinMax = false;
+    while ( state.keepRunning() )
+    {
+        auto res = meshToDistanceVolume( mesh, params );
+        if ( !res )
+            state.setError( res.error() );
+    }
+    state.setItemsProcessed( double( size ) * size * size );
+}
+
+MR_BENCHMARK( meshToSparseDistanceVolume, 64, 128, 256 )
+{
+    const auto & mesh = benchSphere( 100'000 );
+    (void)mesh.getAABBTree();
+    const int size = state.size();
+    MeshToDistanceVolumeParams params;
+    params.vol.dimensions = Vector3i::diagonal( size );
+    params.vol.voxelSize = Vector3f::diagonal( 3.0f / size );
+    params.vol.origin = Vector3f::diagonal( -1.5f );
+    params.dist.maxDistSq = sqr( 6.0f / size );
+    while ( state.keepRunning() )
+    {
+        auto res = meshToSparseDistanceVolume( mesh, params );
+        if ( !res )
+            state.setError( res.error() );
+    }
+    state.setItemsProcessed( double( size ) * size * size );
+}
+
+MR_BENCHMARK( voxelFilterGaussianU16, 64, 128, 256 )
+{
+    const auto vol = noisyVolumeU16( state.size() );
+    while ( state.keepRunning() )
+    {
+        auto res = voxelFilter( vol, VoxelFilterType::Gaussian, 5 );
+        if ( !res )
+            state.setError( res.error() );
+    }
+    state.setItemsProcessed( (double)vol.data.size() );
+}
+
+MR_BENCHMARK( voxelFilterMedianU16, 64, 128, 256 )
+{
+    const auto vol = noisyVolumeU16( state.size() );
+    while ( state.keepRunning() )
+    {
+        auto res = voxelFilter( vol, VoxelFilterType::Median, 3 );
+        if ( !res )
+            state.setError( res.error() );
+    }
+    state.setItemsProcessed( (double)vol.data.size() );
+}
+
+MR_BENCHMARK( voxelFilterGaussianVdb, 64, 128, 256 )
+{
+    const auto vol = simpleVolumeToVdbVolume( toSimpleVolume( noisyVolumeU16( state.size() ) ) );
+    while ( state.keepRunning() )
+        (void)voxelFilter( vol, VoxelFilterType::Gaussian, 5 );
+    state.setItemsProcessed( double( vol.dims.x ) * vol.dims.y * vol.dims.z );
+}
+
+MR_BENCHMARK( voxelFilterMedianVdb, 64, 128, 256 )
+{
+    const auto vol = simpleVolumeToVdbVolume( toSimpleVolume( noisyVolumeU16( state.size() ) ) );
+    while ( state.keepRunning() )
+        (void)voxelFilter( vol, VoxelFilterType::Median, 3 );
+    state.setItemsProcessed( double( vol.dims.x ) * vol.dims.y * vol.dims.z );
+}
+
+MR_BENCHMARK( segmentVolumeByGraphCut, 64, 128, 192 )
+{
+    const auto task = ballGraphCutTask( state.size() );
+    while ( state.keepRunning() )
+    {
+        auto res = segmentVolumeByGraphCut( task.density, 10.0f, task.sourceSeeds, task.sinkSeeds );
+        if ( !res )
+            state.setError( res.error() );
+    }
+    state.setItemsProcessed( (double)task.density.data.size() );
+}
+
+MR_BENCHMARK( segmentVolumeByGraphCutMultiLevel, 64, 128, 192 )
+{
+    const auto task = ballGraphCutTask( state.size() );
+    while ( state.keepRunning() )
+    {
+        auto res = segmentVolumeByGraphCutMultiLevel( task.density, 10.0f, task.sourceSeeds, task.sinkSeeds, { .levels = 2 } );
+        if ( !res )
+            state.setError( res.error() );
+    }
+    state.setItemsProcessed( (double)task.density.data.size() );
+}
+
+#ifndef MRVOXELS_NO_DICOM
+MR_BENCHMARK( loadDicomFolder, 128, 256, 512 )
+{
+    benchLoadDicomFolder( state, [] ( const std::filesystem::path& folder, unsigned threads )
+    {
+        return VoxelsLoad::loadDicomFolder( folder, threads );
+    } );
+}
+
+MR_BENCHMARK( loadDicomFolderDense, 128, 256, 512 )
+{
+    benchLoadDicomFolder( state, [] ( const std::filesystem::path& folder, unsigned threads )
+    {
+        return VoxelsLoad::loadDicomFolderDense( folder, { .maxNumThreads = threads } );
+    } );
+}
+
+MR_BENCHMARK( loadDicomFolderDenseU16, 128, 256, 512 )
+{
+    benchLoadDicomFolder( state, [] ( const std::filesystem::path& folder, unsigned threads )
+    {
+        return VoxelsLoad::loadDicomFolderDenseU16( folder, { .maxNumThreads = threads } );
+    } );
+}
+
+MR_BENCHMARK( loadDicomFolderDenseU16Downsample2, 128, 256, 512 )
+{
+    benchLoadDicomFolder( state, [] ( const std::filesystem::path& folder, unsigned threads )
+    {
+        return VoxelsLoad::loadDicomFolderDenseU16( folder, { .maxNumThreads = threads, .downsample = 2 } );
+    } );
+}
+#endif
+
+} // namespace MR::Bench
+#endif
@@ -16,6 +16,8 @@
 #include "MRBox.h"
 #include "MR2to3.h"
 #include "MRBitSetParallelFor.h"
+#include "MRParallelFor.h"
+#include "MRMeshBuilder.h"
 #include "MRPrecisePredicates2.h"
 #include "MRPrecisePredicates3.h"
 #include "MRPch/MRTBB.h"
@@ -1702,6 +1704,175 @@ Mesh triangulateContours( const Contours2d& contours, const TriangulationParamet
     return triangulateContours( contsf, params );
 }
 
+// splits given contours (by indices) in the groups with not-overlapping bounding boxes
+// by recursive cuts orthogonal to coordinate axes between the boxes
+static void groupContoursByBoxes( const std::vector<Box2f>& boxes, std::vector<int> ids, int lastAxis, std::vector<std::vector<int>>& groups )
+{
+    for ( int d = 1; d <= 2; ++d )
+    {
+        const int axis = ( lastAxis + d ) % 2;
+        std::sort( ids.begin(), ids.end(), [&] ( int a, int b ) { return boxes[a].min[axis] < boxes[b].min[axis]; } );
+        std::vector<std::vector<int>> parts( 1 );
+        float maxCoord = boxes[ids.front()].max[axis];
+        parts.back().push_back( ids.front() );
+        for ( int i = 1; i < ids.size(); ++i )
+        {
+            const auto& box = boxes[ids[i]];
+            if ( box.min[axis] > maxCoord )
+                parts.emplace_back();
+            parts.back().push_back( ids[i] );
+            maxCoord = std::max( maxCoord, box.max[axis] );
+        }
+        if ( parts.size() == 1 )
+            continue; // try another axis
+        for ( auto& part : parts )
+            groupContoursByBoxes( boxes, std::move( part ), axis, groups );
+        return;
+    }
+    groups.push_back( std::move( ids ) );
+}
+
+Mesh triangulateContoursParallel( const Contours2f& contours, const TriangulationParameters& params )
+{
+    MR_TIMER;
+    std::vector<std::vector<int>> groups;
+    if ( !params.holeVertsIds )
+    {
+        std::vector<Box2f> boxes( contours.size() );
+        std::vector<int> ids;
+        ids.reserve( contours.size() );
+        for ( int i = 0; i < contours.size(); ++i )
+        {
+            if ( contours[i].size() <= 3 )
+                continue; // such contours are ignored by triangulation
+            for ( const auto& p : contours[i] )
+                boxes[i].include( p );
+            ids.push_back( i );
+        }
+        if ( !ids.empty() )
+            groupContoursByBoxes( boxes, std::move( ids ), 1, groups );
+    }
+    if ( groups.size() <= 1 )
+        return triangulateContours( contours, params );
+
+    // the first vertex of each contour in the whole triangulation
+    std::vector<int> firstVert( contours.size() + 1, 0 );
+    for ( int i = 0; i < contours.size(); ++i )
+        firstVert[i + 1] = firstVert[i] + ( contours[i].size() > 3 ? int( contours[i].size() ) - 1 : 0 );
+    const int numInputVerts = firstVert.back();
+
+    std::vector<Mesh> meshes( groups.size() );
+    std::vector<Vector<int, FaceId>> windings( params.outFaceWinding ? groups.size() : 0 );
+    std::vector<IntersectionsMap> interMaps( params.outInterMap ? groups.size() : 0 );
+    ParallelFor( groups, [&] ( size_t g )
+    {
+        Contours2f groupContours;
+        groupContours.reserve( groups[g].size() );
+        // keep original order of contours to have the same order of input vertices
+        std::sort( groups[g].begin(), groups[g].end() );
+        for ( int i : groups[g] )
+            groupContours.push_back( contours[i] );
+        meshes[g] = triangulateContours( groupContours, {
+            .outFaceWinding = windings.empty() ? nullptr : &windings[g],
+            .outInterMap = interMaps.empty() ? nullptr : &interMaps[g] } );
+    } );
+
+    // map vertices of all groups in the whole triangulation: input vertices by their global ids, intersection vertices after them
+    std::vector<VertMap> local2global( groups.size() );
+    int numVerts = numInputVerts;
+    size_t numFaces = 0;
+    for ( size_t g = 0; g < groups.size(); ++g )
+    {
+        auto& map = local2global[g];
+        map.resize( meshes[g].topology.vertSize() );
+        VertId v( 0 );
+        for ( int i : groups[g] )
+            for ( int j = firstVert[i]; j < firstVert[i + 1]; ++j )
+                map[v++] = VertId( j );
+        for ( ; v < map.size(); ++v )
+            map[v] = VertId( numVerts++ );
+        numFaces += meshes[g].topology.numValidFaces();
+    }
+
+    Triangulation t;
+    t.reserve( numFaces );
+    VertCoords points( numVerts );
+    if ( params.outFaceWinding )
+    {
+        params.outFaceWinding->clear();
+        params.outFaceWinding->reserve( numFaces );
+    }
+    if ( params.outInterMap )
+    {
+        params.outInterMap->shift = numInputVerts;
+        params.outInterMap->map.clear();
+        params.outInterMap->map.reserve( numVerts - numInputVerts );
+    }
+    for ( size_t g = 0; g < groups.size(); ++g )
+    {
+        const auto& mesh = meshes[g];
+        const auto& map = local2global[g];
+        for ( auto v : mesh.topology.getValidVerts() )
+            points[map[v]] = mesh.points[v];
+        for ( auto f : mesh.topology.getValidFaces() )
+        {
+            auto vs = mesh.topology.getTriVerts( f );
+            for ( auto& v : vs )
+                v = map[v];
+            t.push_back( vs );
+            if ( params.outFaceWinding )
+                params.outFaceWinding->push_back( windings[g][f] );
+        }
+        if ( params.outInterMap )
+        {
+            auto mapVert = [&] ( VertId v ) { return v ? map[v] : v; };
+            for ( auto info : interMaps[g].map )
+            {
+                info.lOrg = mapVert( info.lOrg );
+                info.lDest = mapVert( info.lDest );
+                info.uOrg = mapVert( info.uOrg );
+                info.uDest = mapVert( info.uDest );
+                params.outInterMap->map.push_back( info );
+            }
+        }
+    }
+
+    Mesh res;
+    res.topology = MeshBuilder::fromTriangles( t );
+    res.points = std::move( points );
+    return res;
+}
+
+Mesh triangulateContoursParallel( const Contours2d& contours, const TriangulationParameters& params )
+{
+    const auto contsf = convertContours<Contours2f>( contours );
+    return triangulateContoursParallel( contsf, params );
+}
+
+Expected<std::vector<Mesh>> triangulateContoursBatch( const std::vector<Contours2f>& layers, const ProgressCallback& cb )
+{
+    MR_TIMER;
+    std::vector<Mesh> res( layers.size() );
+    if ( !ParallelFor( layers, [&] ( size_t i )
+    {
+        res[i] = triangulateContoursParallel( layers[i] );
+    }, cb ) )
+        return unexpectedOperationCanceled();
+    return res;
+}
+
+Expected<std::vector<Mesh>> triangulateContoursBatch( const std::vector<Contours2d>& layers, const ProgressCallback& cb )
+{
+    MR_TIMER;
+    std::vector<Mesh> res( layers.size() );
+    if ( !ParallelFor( layers, [&] ( size_t i )
+    {
+        res[i] = triangulateContoursParallel( layers[i] );
+    }, cb ) )
+        return unexpectedOperationCanceled();
+    return res;
+}
+
 Mesh triangulateContours( const Contours2d& contours, const HolesVertIds* holeVertsIds )
 {
     return triangulateContours( contours, { .holeVertsIds = holeVertsIds } );
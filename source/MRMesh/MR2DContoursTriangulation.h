@@ -1,6 +1,8 @@
 #pragma once
 #include "MRMeshFwd.h"
 #include "MRId.h"
+#include "MRExpected.h"
+#include "MRProgressCallback.h"
 #include <optional>
 
 namespace MR
@@ -97,6 +99,22 @@ struct TriangulationParameters
 MRMESH_API Mesh triangulateContours( const Contours2d& contours, const TriangulationParameters& params = {} );
 MRMESH_API Mesh triangulateContours( const Contours2f& contours, const TriangulationParameters& params = {} );
 
+/**
+ * @brief triangulate 2d contours in parallel
+ * the contours are split in groups with not-overlapping bounding boxes (e.g. separate outer contours with their holes),
+ * which are triangulated independently in parallel and then merged in one mesh;
+ * the result is the same as of triangulateContours up to the order of faces and rounding of intersection points,
+ * vertex ids are the same: input contour vertices go first, then the vertices created at the intersections;
+ * params.holeVertsIds is not supported, and all contours are triangulated together if it is given
+ */
+MRMESH_API Mesh triangulateContoursParallel( const Contours2d& contours, const TriangulationParameters& params = {} );
+MRMESH_API Mesh triangulateContoursParallel( const Contours2f& contours, const TriangulationParameters& params = {} );
+
+/// triangulates many independent sets of 2d contours (e.g. the layers of a sliced object) in parallel,
+/// each set is triangulated by triangulateContoursParallel
+MRMESH_API Expected<std::vector<Mesh>> triangulateContoursBatch( const std::vector<Contours2d>& layers, const ProgressCallback& cb = {} );
+MRMESH_API Expected<std::vector<Mesh>> triangulateContoursBatch( const std::vector<Contours2f>& layers, const ProgressCallback& cb = {} );
+
 /// triangulate 2d contours, C++-only overload for backward compatibility;
 /// hidden from generated bindings to keep their triangulateContours signatures unique
 /// \param holeVertsIds if set merge only points with same vertex id, otherwise merge all points with same coordinates
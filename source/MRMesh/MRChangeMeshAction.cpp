@@ -0,0 +1,176 @@
+#include "MRChangeMeshAction.h"
+
+#include <istream>
+#include <ostream>
+
+namespace MR
+{
+
+namespace
+{
+
+void writePoints( std::ostream & out, const VertCoords & points )
+{
+    const std::uint64_t size = points.size();
+    out.write( (const char*)&size, sizeof( size ) );
+    out.write( (const char*)points.data(), size * sizeof( Vector3f ) );
+}
+
+Expected<void> readPoints( std::istream & in, VertCoords & points )
+{
+    std::uint64_t size = 0;
+    if ( !in.read( (char*)&size, sizeof( size ) ) )
+        return unexpected( "Cannot read points" );
+    points.resizeNoInit( size );
+    if ( !in.read( (char*)points.data(), size * sizeof( Vector3f ) ) )
+        return unexpected( "Cannot read points" );
+    return {};
+}
+
+/// what is stored in an offloaded action
+enum class Stored : std::uint8_t
+{
+    Full,
+    Diff
+};
+
+void writeStored( std::ostream & out, Stored s )
+{
+    out.write( (const char*)&s, sizeof( s ) );
+}
+
+Expected<Stored> readStored( std::istream & in )
+{
+    Stored s{};
+    if ( !in.read( (char*)&s, sizeof( s ) ) || ( s != Stored::Full && s != Stored::Diff ) )
+        return unexpected( "Cannot read history action data" );
+    return s;
+}
+
+} // anonymous namespace
+
+bool ChangeMeshAction::convertToDiff( const HistoryAction & nextAction )
+{
+    auto next = dynamic_cast<const ChangeMeshAction*>( &nextAction );
+    if ( !next || next->objMesh_ != objMesh_ || !cloneMesh_ || !next->cloneMesh_ || meshDiff_ )
+        return false;
+
+    // next action stores the mesh right after this action, so the difference transforms it in the mesh before this action
+    auto diff = std::make_unique<MeshDiff>( *next->cloneMesh_, *cloneMesh_ );
+    if ( diff->heapBytes() >= cloneMesh_->heapBytes() )
+        return false;
+
+    meshDiff_ = std::move( diff );
+    cloneMesh_.reset();
+    return true;
+}
+
+bool ChangeMeshAction::offloadData( std::ostream & out )
+{
+    if ( meshDiff_ )
+    {
+        writeStored( out, Stored::Diff );
+        meshDiff_->write( out );
+        meshDiff_.reset();
+        return true;
+    }
+    if ( cloneMesh_ )
+    {
+        writeStored( out, Stored::Full );
+        cloneMesh_->topology.write( out );
+        writePoints( out, cloneMesh_->points );
+        cloneMesh_.reset();
+        return true;
+    }
+    return false;
+}
+
+Expected<void> ChangeMeshAction::restoreData( std::istream & in )
+{
+    auto stored = readStored( in );
+    if ( !stored )
+        return unexpected( std::move( stored.error() ) );
+
+    if ( *stored == Stored::Diff )
+    {
+        auto diff = std::make_unique<MeshDiff>();
+        if ( auto res = diff->read( in ); !res )
+            return res;
+        meshDiff_ = std::move( diff );
+        return {};
+    }
+
+    auto mesh = std::make_shared<Mesh>();
+    if ( auto res = mesh->topology.read( in ); !res )
+        return res;
+    if ( auto res = readPoints( in, mesh->points ); !res )
+        return res;
+    cloneMesh_ = std::move( mesh );
+    return {};
+}
+
+bool ChangeMeshPointsAction::convertToDiff( const HistoryAction & nextAction )
+{
+    auto next = dynamic_cast<const ChangeMeshPointsAction*>( &nextAction );
+    if ( !next || next->objMesh_ != objMesh_ || next->pointsDiff_ || pointsDiff_ || clonePoints_.empty() )
+        return false;
+
+    // next action stores the points right after this action, so the difference transforms them in the points before this action
+    auto diff = std::make_unique<VertCoordsDiff>( next->clonePoints_, clonePoints_ );
+    if ( diff->heapBytes() >= clonePoints_.heapBytes() )
+        return false;
+
+    pointsDiff_ = std::move( diff );
+    clonePoints_ = {};
+    return true;
+}
+
+bool ChangeMeshPointsAction::offloadData( std::ostream & out )
+{
+    if ( pointsDiff_ )
+    {
+        writeStored( out, Stored::Diff );
+        pointsDiff_->write( out );
+        pointsDiff_.reset();
+        return true;
+    }
+    if ( clonePoints_.empty() )
+        return false;
+    writeStored( out, Stored::Full );
+    writePoints( out, clonePoints_ );
+    clonePoints_ = {};
+    return true;
+}
+
+Expected<void> ChangeMeshPointsAction::restoreData( std::istream & in )
+{
+    auto stored = readStored( in );
+    if ( !stored )
+        return unexpected( std::move( stored.error() ) );
+
+    if ( *stored == Stored::Diff )
+    {
+        auto diff = std::make_unique<VertCoordsDiff>();
+        if ( auto res = diff->read( in ); !res )
+            return res;
+        pointsDiff_ = std::move( diff );
+        return {};
+    }
+    return readPoints( in, clonePoints_ );
+}
+
+bool ChangeMeshTopologyAction::offloadData( std::ostream & out )
+{
+    if ( cloneTopology_.edgeSize() == 0 )
+        return false;
+    cloneTopology_.write( out );
+    cloneTopology_ = {};
+    return true;
+}
+
+Expected<void> ChangeMeshTopologyAction::restoreData( std::istream & in )
+{
+    return cloneTopology_.read( in );
+}
+
+} // namespace MR
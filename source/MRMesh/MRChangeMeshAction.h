@@ -3,6 +3,8 @@
 #include "MRObjectMesh.h"
 #include "MRMesh.h"
 #include "MRHeapBytes.h"
+#include "MRMeshDiff.h"
+#include "MRVertCoordsDiff.h"
 #include <memory>
 
 namespace MR
@@ -48,6 +50,27 @@ public:
         if ( !objMesh_ )
             return;
 
+        if ( meshDiff_ )
+        {
+            const auto & m = objMesh_->varMesh();
+            if ( !m )
+                return;
+            if ( m.use_count() == 1 )
+            {
+                // the mesh is owned only by the object, so it can be changed in place
+                meshDiff_->applyAndSwap( *m );
+                objMesh_->setDirtyFlags( DIRTY_ALL );
+            }
+            else
+            {
+                // the mesh is shared with other objects or history actions, which shall not see this change
+                auto changedMesh = std::make_shared<Mesh>( *m );
+                meshDiff_->applyAndSwap( *changedMesh );
+                objMesh_->updateMesh( std::move( changedMesh ) );
+            }
+            return;
+        }
+
         cloneMesh_ = objMesh_->updateMesh( cloneMesh_ );
     }
 
@@ -59,12 +82,23 @@ public:
 
     [[nodiscard]] virtual size_t heapBytes() const override
     {
-        return name_.capacity() + MR::heapBytes( cloneMesh_ );
+        return name_.capacity() + MR::heapBytes( cloneMesh_ ) + MR::heapBytes( meshDiff_ );
     }
 
+    /// if nextAction is ChangeMeshAction of the same object, then stores only the difference from its mesh copy;
+    /// unlike PartialChangeMeshAction (and VersatileChangeMeshPointsAction::compress), which find the difference with the current object's mesh
+    /// right after the change, this conversion can be made later, when the object's mesh is already modified by other actions
+    MRMESH_API virtual bool convertToDiff( const HistoryAction & nextAction ) override;
+
+    MRMESH_API virtual bool offloadData( std::ostream & out ) override;
+
+    MRMESH_API virtual Expected<void> restoreData( std::istream & in ) override;
+
 private:
     std::shared_ptr<ObjectMesh> objMesh_;
     std::shared_ptr<Mesh> cloneMesh_;
+    /// if present then it is used instead of cloneMesh_, applied to object's mesh (or to its copy if the mesh is shared)
+    std::unique_ptr<MeshDiff> meshDiff_;
 
     std::string name_;
 };
@@ -223,7 +257,10 @@ public:
 
         if ( auto m = objMesh_->varMesh() )
         {
-            std::swap( m->points, clonePoints_ );
+            if ( pointsDiff_ )
+                pointsDiff_->applyAndSwap( m->points );
+            else
+                std::swap( m->points, clonePoints_ );
             objMesh_->setDirtyFlags( DIRTY_POSITION );
         }
     }
@@ -236,15 +273,25 @@ public:
 
     [[nodiscard]] virtual size_t heapBytes() const override
     {
-        return name_.capacity() + clonePoints_.heapBytes();
+        return name_.capacity() + clonePoints_.heapBytes() + MR::heapBytes( pointsDiff_ );
     }
 
+    /// if nextAction is ChangeMeshPointsAction of the same object, then stores only the difference from its points copy
+    MRMESH_API virtual bool convertToDiff( const HistoryAction & nextAction ) override;
+
+    MRMESH_API virtual bool offloadData( std::ostream & out ) override;
+
+    MRMESH_API virtual Expected<void> restoreData( std::istream & in ) override;
+
     const std::shared_ptr<ObjectMesh> & obj() const { return objMesh_; }
+    /// returns stored copy of points, which is empty after successful convertToDiff()
     const VertCoords & clonePoints() const { return clonePoints_; }
 
 private:
     std::shared_ptr<ObjectMesh> objMesh_;
     VertCoords clonePoints_;
+    /// if present then it is used instead of clonePoints_
+    std::unique_ptr<VertCoordsDiff> pointsDiff_;
 
     std::string name_;
 };
@@ -303,6 +350,10 @@ public:
         return name_.capacity() + cloneTopology_.heapBytes();
     }
 
+    MRMESH_API virtual bool offloadData( std::ostream & out ) override;
+
+    MRMESH_API virtual Expected<void> restoreData( std::istream & in ) override;
+
 private:
     std::shared_ptr<ObjectMesh> objMesh_;
     MeshTopology cloneTopology_;
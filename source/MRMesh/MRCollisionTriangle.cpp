@@ -0,0 +1,65 @@
+#include "MRCollisionTriangle.h"
+#include "MRMesh.h"
+#include "MRParallelFor.h"
+#include "MRTimer.h"
+
+#include <cfloat>
+#include <cmath>
+
+namespace MR
+{
+
+CollisionTriangle makeCollisionTriangle( const Vector3f & p0, const Vector3f & p1, const Vector3f & p2 )
+{
+    CollisionTriangle res;
+    res.p[0] = p0;
+    res.p[1] = p1;
+    res.p[2] = p2;
+
+    const Vector3d a( p0 ), b( p1 ), c( p2 );
+    const auto nd = cross( b - a, c - a );
+    const auto len = nd.length();
+    if ( !( len > 0 ) )
+        return res; // zero normal and tolerance: any triangle may collide with this one
+
+    res.n = Vector3f( nd / len );
+    // use exactly the stored normal to find the plane offset and the deviation of vertices from the plane
+    const Vector3d n( res.n );
+    const double s[3] = { dot( n, a ), dot( n, b ), dot( n, c ) };
+    const double sMin = std::min( { s[0], s[1], s[2] } );
+    const double sMax = std::max( { s[0], s[1], s[2] } );
+    res.d = float( ( sMin + sMax ) / 2 );
+    const double d = res.d;
+    const double dev = std::max( sMax - d, d - sMin );
+
+    // relative margin covers rounding errors in planeCrossedBy
+    double scale = std::abs( d );
+    for ( int i = 0; i < 3; ++i )
+        scale = std::max( { scale, std::abs( a[i] ), std::abs( b[i] ), std::abs( c[i] ) } );
+    res.eps = std::nextafter( float( dev + 1e-6 * scale ), FLT_MAX );
+    return res;
+}
+
+void calcCollisionTriangles( CollisionTriangles & res, const Mesh & mesh )
+{
+    MR_TIMER;
+    res.clear();
+    res.resize( mesh.topology.faceSize() );
+    ParallelFor( res, [&] ( FaceId f )
+    {
+        if ( !mesh.topology.hasFace( f ) )
+            return;
+        Vector3f v0, v1, v2;
+        mesh.getTriPoints( f, v0, v1, v2 );
+        res[f] = makeCollisionTriangle( v0, v1, v2 );
+    } );
+}
+
+CollisionTriangles calcCollisionTriangles( const Mesh & mesh )
+{
+    CollisionTriangles res;
+    calcCollisionTriangles( res, mesh );
+    return res;
+}
+
+} // namespace MR
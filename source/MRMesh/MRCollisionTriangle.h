@@ -0,0 +1,66 @@
+#pragma once
+
+#include "MRAffineXf3.h"
+#include "MRVector3.h"
+
+namespace MR
+{
+
+/// \addtogroup AABBTreeGroup
+/// \{
+
+/// triangle vertices packed together with triangle's plane
+/// for fast rejection of non-colliding triangle pairs before precise predicates are called
+struct CollisionTriangle
+{
+    /// triangle vertices
+    Vector3f p[3];
+    /// unit normal of triangle's plane, zero for degenerate triangles
+    Vector3f n;
+    /// plane offset: dot( n, x ) = d for points x on the plane
+    float d = 0;
+    /// all points of the triangle are within this distance from the plane (including possible rounding errors)
+    float eps = 0;
+
+    /// returns false if all given points are strictly on one side of triangle's plane and far from it,
+    /// so no triangle with these vertices can touch this triangle
+    [[nodiscard]] bool planeCrossedBy( const Vector3f & q0, const Vector3f & q1, const Vector3f & q2 ) const
+    {
+        // products of floats are exact in double precision
+        const Vector3d nd( n );
+        const double s0 = dot( nd, Vector3d( q0 ) ) - d;
+        const double s1 = dot( nd, Vector3d( q1 ) ) - d;
+        const double s2 = dot( nd, Vector3d( q2 ) ) - d;
+        if ( s0 > eps && s1 > eps && s2 > eps )
+            return false;
+        if ( s0 < -eps && s1 < -eps && s2 < -eps )
+            return false;
+        return true;
+    }
+};
+
+static_assert( sizeof( CollisionTriangle ) == 14 * sizeof( float ) );
+
+/// returns false if the triangles are certainly separated by the plane of one of them;
+/// true result means that precise predicates shall be called to find out whether the triangles really collide
+[[nodiscard]] inline bool mayTrianglesCollide( const CollisionTriangle & a, const CollisionTriangle & b )
+{
+    return a.planeCrossedBy( b.p[0], b.p[1], b.p[2] ) && b.planeCrossedBy( a.p[0], a.p[1], a.p[2] );
+}
+
+/// computes collision data for a triangle with given vertices
+[[nodiscard]] MRMESH_API CollisionTriangle makeCollisionTriangle( const Vector3f & p0, const Vector3f & p1, const Vector3f & p2 );
+
+/// computes collision data for given triangle after rigid transformation of its vertices
+[[nodiscard]] inline CollisionTriangle transformed( const CollisionTriangle & t, const AffineXf3f & xf )
+{
+    return makeCollisionTriangle( xf( t.p[0] ), xf( t.p[1] ), xf( t.p[2] ) );
+}
+
+/// computes collision data for all mesh triangles in parallel, invalid faces get all zeros
+MRMESH_API void calcCollisionTriangles( CollisionTriangles & res, const Mesh & mesh );
+[[nodiscard]] MRMESH_API CollisionTriangles calcCollisionTriangles( const Mesh & mesh );
+
+/// \}
+
+} // namespace MR
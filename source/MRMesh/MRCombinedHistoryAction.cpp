@@ -49,6 +49,53 @@ size_t CombinedHistoryAction::heapBytes() const
     return res;
 }
 
+bool CombinedHistoryAction::convertToDiff( const HistoryAction & nextAction )
+{
+    // the action right after the last inner action
+    const HistoryAction * following = &nextAction;
+    if ( auto nextCombined = dynamic_cast<const CombinedHistoryAction*>( &nextAction ) )
+    {
+        following = nullptr;
+        for ( const auto & a : nextCombined->actions_ )
+        {
+            if ( a )
+            {
+                following = a.get();
+                break;
+            }
+        }
+    }
+
+    bool res = false;
+    for ( int i = int( actions_.size() ) - 1; i >= 0; --i )
+    {
+        if ( !actions_[i] )
+            continue;
+        if ( following && actions_[i]->convertToDiff( *following ) )
+            res = true;
+        following = actions_[i].get();
+    }
+    return res;
+}
+
+bool CombinedHistoryAction::offloadData( std::ostream & out )
+{
+    assert( offloaded_.empty() );
+    for ( const auto & a : actions_ )
+        if ( a && a->offloadData( out ) )
+            offloaded_.push_back( a );
+    return !offloaded_.empty();
+}
+
+Expected<void> CombinedHistoryAction::restoreData( std::istream & in )
+{
+    for ( const auto & a : offloaded_ )
+        if ( auto res = a->restoreData( in ); !res )
+            return res;
+    offloaded_.clear();
+    return {};
+}
+
 std::optional<std::string> getDynamicName( const std::shared_ptr<HistoryAction>& action )
 {
     if ( auto combHist = std::dynamic_pointer_cast<CombinedHistoryAction>( action ) )
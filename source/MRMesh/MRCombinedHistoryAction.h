@@ -40,8 +40,19 @@ public:
 
     [[nodiscard]] MRMESH_API virtual size_t heapBytes() const override;
 
+    /// converts every inner action to difference with the action right after it:
+    /// the next inner action, or nextAction (its first inner action if it is also combined) for the last one
+    MRMESH_API virtual bool convertToDiff( const HistoryAction & nextAction ) override;
+
+    /// offloads the data of all inner actions supporting it
+    MRMESH_API virtual bool offloadData( std::ostream & out ) override;
+
+    MRMESH_API virtual Expected<void> restoreData( std::istream & in ) override;
+
 private:
     HistoryActionsVector actions_;
+    /// inner actions with offloaded data in the order of writing, kept here even if filtered out from actions_
+    HistoryActionsVector offloaded_;
     std::string name_;
     DynamicNameGetter dynNameGetter_;
 };
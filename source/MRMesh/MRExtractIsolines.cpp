@@ -14,6 +14,9 @@
 #include "MRMeshTriPoint.h"
 #include "MRLineSegm3.h"
 #include "MRTimer.h"
+#include "MRQuantizedVertCoords.h"
+#include "MRPch/MRTBB.h"
+#include <algorithm>
 #include <atomic>
 
 namespace MR
@@ -195,6 +198,13 @@ public:
     /// potentiallyCrossedEdges shall include all edges crossed by the iso-lines (some other edges there is permitted as well)
     IsoLines extract( UndirectedEdgeBitSet potentiallyCrossedEdges );
 
+    /// extracts iso-lines crossing only given edges, each of which must be crossed;
+    /// \param negativeVerts and \param activeEdges are reusable buffers of full size used instead of own memory:
+    /// on input negativeVerts has all negative ends of given edges set, and activeEdges has no set bits,
+    /// on output both have no set bits
+    IsoLines extract( const UndirectedEdgeId * crossedBegin, const UndirectedEdgeId * crossedEnd,
+        VertBitSet & negativeVerts, UndirectedEdgeBitSet & activeEdges );
+
 private:
     void findNegativeVerts_();
     void findNegativeVerts_( const VertBitSet& vertRegion );
@@ -280,6 +290,36 @@ IsoLines Isoliner::extract( UndirectedEdgeBitSet potentiallyCrossedEdges )
     return extract_();
 }
 
+IsoLines Isoliner::extract( const UndirectedEdgeId * crossedBegin, const UndirectedEdgeId * crossedEnd,
+    VertBitSet & negativeVerts, UndirectedEdgeBitSet & activeEdges )
+{
+    std::swap( negativeVerts_, negativeVerts );
+    std::swap( activeEdges_, activeEdges );
+    for ( auto it = crossedBegin; it != crossedEnd; ++it )
+        activeEdges_.set( *it );
+
+    // the same order of lines as in extract_(), since given edges are sorted
+    IsoLines res;
+    for ( auto it = crossedBegin; it != crossedEnd; ++it )
+    {
+        if ( !activeEdges_.test( *it ) )
+            continue;
+        EdgeId e = *it;
+        res.push_back( extractOneLine_( negativeVerts_.test( topology_.org( e ) ) ? e : e.sym() ) );
+    }
+
+    // clear only the bits of given edges and their vertices instead of whole buffers
+    for ( auto it = crossedBegin; it != crossedEnd; ++it )
+    {
+        activeEdges_.reset( *it );
+        negativeVerts_.reset( topology_.org( *it ) );
+        negativeVerts_.reset( topology_.dest( *it ) );
+    }
+    std::swap( negativeVerts_, negativeVerts );
+    std::swap( activeEdges_, activeEdges );
+    return res;
+}
+
 bool Isoliner::hasAnyLine( const UndirectedEdgeBitSet * potentiallyCrossedEdges ) const
 {
     std::atomic<bool> res{ false };
@@ -411,6 +451,12 @@ PlaneSections extractPlaneSections( const MeshPart& mp, const Plane3f& plane, Us
     return s.extract( std::move( potentiallyCrossedEdges ) );
 }
 
+PlaneSections extractPlaneSections( const MeshTopology & topology, const QuantizedVertCoords & points, const Plane3f & plane, const FaceBitSet * region )
+{
+    MR_TIMER;
+    return extractIsolines( topology, [&points, &plane] ( VertId v ) { return plane.distance( points[v] ); }, region );
+}
+
 bool hasAnyPlaneSection( const MeshPart& mp, const Plane3f& plane, UseAABBTree u )
 {
     MR_TIMER;
@@ -457,6 +503,110 @@ PlaneSections extractXYPlaneSections( const MeshPart & mp, float zLevel, UseAABB
     return s.extract( std::move( potentiallyCrossedEdges ) );
 }
 
+Expected<std::vector<PlaneSections>> extractXYPlaneSections( const MeshPart & mp, const std::vector<float> & zLevels, const ProgressCallback & cb )
+{
+    MR_TIMER;
+    const auto & topology = mp.mesh.topology;
+    const auto & points = mp.mesh.points;
+
+    std::vector<int> levelOrder( zLevels.size() );
+    for ( int i = 0; i < levelOrder.size(); ++i )
+        levelOrder[i] = i;
+    std::sort( levelOrder.begin(), levelOrder.end(), [&] ( int a, int b ) { return zLevels[a] < zLevels[b]; } );
+    std::vector<float> sortedLevels( zLevels.size() );
+    for ( int i = 0; i < levelOrder.size(); ++i )
+        sortedLevels[i] = zLevels[levelOrder[i]];
+
+    // the edge is crossed by the plane z=level if exactly one of its vertices is below the level: zmin < level <= zmax;
+    // find the range of such levels in sortedLevels for each edge
+    Vector<std::pair<int, int>, UndirectedEdgeId> edgeLevels( topology.undirectedEdgeSize(), { 0, 0 } );
+    ParallelFor( edgeLevels, [&] ( UndirectedEdgeId ue )
+    {
+        VertId o = topology.org( ue );
+        if ( !o )
+            return;
+        VertId d = topology.dest( ue );
+        if ( !d )
+            return;
+        if ( mp.region && !contains( *mp.region, topology.left( ue ) ) && !contains( *mp.region, topology.right( ue ) ) )
+            return;
+        const auto [zmin, zmax] = std::minmax( points[o].z, points[d].z );
+        edgeLevels[ue] = {
+            int( std::upper_bound( sortedLevels.begin(), sortedLevels.end(), zmin ) - sortedLevels.begin() ),
+            int( std::upper_bound( sortedLevels.begin(), sortedLevels.end(), zmax ) - sortedLevels.begin() ) };
+    } );
+
+    if ( !reportProgress( cb, 0.1f ) )
+        return unexpectedOperationCanceled();
+
+    // crossed edges of each level are stored together in one array;
+    // the number of edges crossed by each level is found from the differences between consecutive levels
+    std::vector<std::int64_t> countDiff( sortedLevels.size() + 1, 0 );
+    for ( const auto & [l0, l1] : edgeLevels )
+    {
+        ++countDiff[l0];
+        --countDiff[l1];
+    }
+    std::vector<size_t> levelStart( sortedLevels.size() + 1, 0 );
+    std::int64_t count = 0;
+    for ( size_t l = 0; l < sortedLevels.size(); ++l )
+    {
+        count += countDiff[l];
+        levelStart[l + 1] = levelStart[l] + size_t( count );
+    }
+
+    std::vector<UndirectedEdgeId> crossedEdges( levelStart.back() );
+    auto levelPos = levelStart;
+    for ( auto ue = 0_ue; ue < edgeLevels.size(); ++ue )
+    {
+        const auto [l0, l1] = edgeLevels[ue];
+        for ( int l = l0; l < l1; ++l )
+            crossedEdges[levelPos[l]++] = ue;
+    }
+    edgeLevels = {};
+
+    if ( !reportProgress( cb, 0.2f ) )
+        return unexpectedOperationCanceled();
+
+    // full-size bit sets are allocated once per thread, and only the bits of crossed edges and their vertices are set and cleared for each level
+    struct LevelBuffers
+    {
+        VertBitSet negativeVerts;
+        UndirectedEdgeBitSet activeEdges;
+    };
+    tbb::enumerable_thread_specific<LevelBuffers> threadBuffers;
+
+    std::vector<PlaneSections> res( zLevels.size() );
+    const bool ok = ParallelFor( size_t( 0 ), sortedLevels.size(), [&] ( size_t l )
+    {
+        if ( levelStart[l] == levelStart[l + 1] )
+            return;
+        auto & buf = threadBuffers.local();
+        buf.negativeVerts.resize( topology.vertSize() );
+        buf.activeEdges.resize( topology.undirectedEdgeSize() );
+
+        const float zLevel = sortedLevels[l];
+        const auto * crossedBegin = crossedEdges.data() + levelStart[l];
+        const auto * crossedEnd = crossedEdges.data() + levelStart[l + 1];
+        for ( auto it = crossedBegin; it != crossedEnd; ++it )
+        {
+            // exactly one end of each crossed edge is below the level
+            const VertId o = topology.org( *it );
+            buf.negativeVerts.set( points[o].z < zLevel ? o : topology.dest( *it ) );
+        }
+        auto valueInPoint = [&points, zLevel] ( VertId v )
+        {
+            return points[v].z - zLevel;
+        };
+        Isoliner s( topology, valueInPoint, VertBitSet{} );
+        res[levelOrder[l]] = s.extract( crossedBegin, crossedEnd, buf.negativeVerts, buf.activeEdges );
+    }, subprogress( cb, 0.2f, 1.0f ) );
+
+    if ( !ok )
+        return unexpectedOperationCanceled();
+    return res;
+}
+
 bool hasAnyXYPlaneSection( const MeshPart & mp, float zLevel, UseAABBTree u )
 {
     MR_TIMER;
@@ -29,9 +29,22 @@ namespace MR
 /// quickly returns true if extractPlaneSections produce not-empty set for the same arguments
 [[nodiscard]] MRMESH_API bool hasAnyPlaneSection( const MeshPart & mp, const Plane3f & plane, UseAABBTree u = UseAABBTree::Yes );
 
+/// extracts all plane sections of the mesh with given topology and quantized coordinates of vertices without decoding them in VertCoords;
+/// all edges of the region are checked, since there is no AABB tree for quantized points
+[[nodiscard]] MRMESH_API PlaneSections extractPlaneSections( const MeshTopology & topology, const QuantizedVertCoords & points,
+    const Plane3f & plane, const FaceBitSet * region = nullptr );
+
 /// extracts all sections of given mesh with the plane z=zLevel
 [[nodiscard]] MRMESH_API PlaneSections extractXYPlaneSections( const MeshPart & mp, float zLevel, UseAABBTree u = UseAABBTree::Yes );
 
+/// extracts all sections of given mesh with the planes z=zLevels[i] in one pass:
+/// the z-range of each edge is computed once and mapped in the range of crossing levels (interval sweep over sorted levels),
+/// then the sections of all levels are extracted in parallel, each only from its crossed edges;
+/// it is much faster than calling extractXYPlaneSections for each level when the levels are many
+/// \return the sections for each level in the same order as in zLevels
+[[nodiscard]] MRMESH_API Expected<std::vector<PlaneSections>> extractXYPlaneSections( const MeshPart & mp, const std::vector<float> & zLevels,
+    const ProgressCallback & cb = {} );
+
 /// quickly returns true if extractXYPlaneSections produce not-empty set for the same arguments
 [[nodiscard]] MRMESH_API bool hasAnyXYPlaneSection( const MeshPart & mp, float zLevel, UseAABBTree u = UseAABBTree::Yes );
 
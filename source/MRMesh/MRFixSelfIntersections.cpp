@@ -11,8 +11,12 @@
 #include "MRTimer.h"
 #include "MRBox.h"
 #include "MRMapOrHashMap.h"
+#include "MRMapEdge.h"
+#include "MRParallelFor.h"
+#include "MRUnionFind.h"
 #include "MRPch/MRSpdlog.h"
 #include <algorithm>
+#include <chrono>
 
 namespace MR
 {
@@ -105,6 +109,12 @@ Expected<void> fixOld( Mesh& mesh, const Settings& settings )
     return {};
 }
 
+// Helper function to fix self-intersections found in the mesh after fixing its degeneracies (progress is reported from 0.3 to 1)
+static Expected<void> fixFound( Mesh& mesh, const Settings& settings );
+
+// Helper function to fix self-intersections in spatially separated regions in parallel (progress is reported from 0.3 to 1)
+static Expected<void> fixByRegions( Mesh& mesh, const Settings& settings );
+
 Expected<void> fix( Mesh& mesh, const Settings& settings )
 {
     MR_TIMER;
@@ -139,6 +149,15 @@ Expected<void> fix( Mesh& mesh, const Settings& settings )
             return fdRes;
     }
 
+    if ( settings.parallelRegions )
+        return fixByRegions( mesh, settings );
+    return fixFound( mesh, settings );
+}
+
+static Expected<void> fixFound( Mesh& mesh, const Settings& settings )
+{
+    MR_TIMER;
+
     auto faceToRegionMap = MeshComponents::getAllComponentsMap( { mesh } ).first;
 
     if ( !reportProgress( settings.callback, 0.3f ) )
@@ -261,6 +280,173 @@ Expected<void> fix( Mesh& mesh, const Settings& settings )
     return {};
 }
 
+// the result of fixing one region on its own sub-mesh
+struct RegionFix
+{
+    Mesh subMesh;
+    std::vector<EdgePath> thisContours; // boundary of the region in the original mesh
+    std::vector<EdgePath> fromContours; // corresponding boundary of the sub-mesh
+    RegionReport report;
+    bool ok = false;
+};
+
+// checks that the fix of the sub-mesh did not change its boundary, so it can be stitched back in the original mesh
+static bool isSubMeshBoundaryIntact( const Mesh& mesh, const RegionFix& fix )
+{
+    const auto & subTopology = fix.subMesh.topology;
+    for ( int i = 0; i < fix.fromContours.size(); ++i )
+    {
+        for ( int j = 0; j < fix.fromContours[i].size(); ++j )
+        {
+            const auto e = fix.fromContours[i][j];
+            if ( !e || e.undirected() >= subTopology.undirectedEdgeSize() || subTopology.isLoneEdge( e ) )
+                return false;
+            if ( !subTopology.left( e ) || subTopology.right( e ) )
+                return false;
+            if ( fix.subMesh.orgPnt( e ) != mesh.orgPnt( fix.thisContours[i][j] ) )
+                return false;
+        }
+    }
+    return true;
+}
+
+static Expected<void> fixByRegions( Mesh& mesh, const Settings& settings )
+{
+    MR_TIMER;
+
+    auto faceToRegionMap = MeshComponents::getAllComponentsMap( { mesh } ).first;
+
+    if ( !reportProgress( settings.callback, 0.3f ) )
+        return unexpectedOperationCanceled();
+
+    auto res = findSelfCollidingTrianglesBS( mesh,
+                                             subprogress( settings.callback, 0.3f, 0.5f ),
+                                             &faceToRegionMap, settings.touchIsIntersection );
+    if ( !res.has_value() )
+        return unexpected( std::move( res.error() ) );
+    if ( res->none() )
+        return {};
+    const FaceBitSet badFaces = std::move( *res );
+
+    // fixFound changes the faces at most 2*maxExpand+1 steps away from bad faces (expansion, subdivision and expansion again),
+    // so the margin is taken larger to keep the boundary of sub-meshes intact
+    FaceBitSet expanded = badFaces;
+    expand( mesh.topology, expanded, 2 * std::max( settings.maxExpand, 1 ) + 3 );
+    auto components = MeshComponents::getAllComponents( { mesh, &expanded }, MeshComponents::FaceIncidence::PerVertex );
+
+    // unite the components with overlapping boxes, since the faces of one of them can intersect the faces of another one
+    std::vector<Box3f> boxes( components.size() );
+    ParallelFor( boxes, [&] ( size_t i )
+    {
+        boxes[i] = mesh.computeBoundingBox( &components[i] );
+    } );
+    std::vector<int> byMinX( components.size() );
+    for ( int i = 0; i < byMinX.size(); ++i )
+        byMinX[i] = i;
+    std::sort( byMinX.begin(), byMinX.end(), [&] ( int a, int b ) { return boxes[a].min.x < boxes[b].min.x; } );
+    UnionFind<RegionId> unionFind( components.size() );
+    for ( int i = 0; i < byMinX.size(); ++i )
+    {
+        const auto & iBox = boxes[byMinX[i]];
+        for ( int j = i + 1; j < byMinX.size() && boxes[byMinX[j]].min.x <= iBox.max.x; ++j )
+            if ( iBox.intersects( boxes[byMinX[j]] ) )
+                unionFind.unite( RegionId( byMinX[i] ), RegionId( byMinX[j] ) );
+    }
+
+    std::vector<FaceBitSet> regions;
+    Vector<int, RegionId> root2region( components.size(), -1 );
+    for ( int i = 0; i < components.size(); ++i )
+    {
+        auto & r = root2region[unionFind.find( RegionId( i ) )];
+        if ( r < 0 )
+        {
+            r = int( regions.size() );
+            regions.push_back( std::move( components[i] ) );
+        }
+        else
+            regions[r] |= components[i];
+    }
+    spdlog::info( "SelfIntersections::fix: working on {} separated regions in parallel", regions.size() );
+
+    // every region is fixed on its own sub-mesh with the boundary far from self-intersections,
+    // degeneracies were already fixed in the whole mesh
+    Settings regionSettings = settings;
+    regionSettings.callback = {};
+    regionSettings.parallelRegions = false;
+    regionSettings.outRegionReports = nullptr;
+
+    std::vector<RegionFix> fixes( regions.size() );
+    const bool ok = ParallelFor( size_t( 0 ), regions.size(), [&] ( size_t i )
+    {
+        const auto start = std::chrono::steady_clock::now();
+        const auto & region = regions[i];
+        auto & fix = fixes[i];
+        fix.report.box = mesh.computeBoundingBox( &region );
+        fix.report.numBadFaces = int( ( badFaces & region ).count() );
+        fix.report.numFaces = int( region.count() );
+
+        auto src2tgtEdges = WholeEdgeMapOrHashMap::createHashMap();
+        PartMapping mapping;
+        mapping.src2tgtEdges = &src2tgtEdges;
+        fix.subMesh = mesh.cloneRegion( region, false, mapping );
+        fix.thisContours = findLeftBoundary( mesh.topology, region );
+        fix.fromContours = fix.thisContours;
+        for ( auto & contour : fix.fromContours )
+            for ( auto & e : contour )
+                e = mapEdge( src2tgtEdges, e );
+
+        fix.ok = fixFound( fix.subMesh, regionSettings ).has_value() && isSubMeshBoundaryIntact( mesh, fix );
+        fix.report.seconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+    }, subprogress( settings.callback, 0.5f, 0.9f ), 1 );
+
+    if ( !ok )
+        return unexpectedOperationCanceled();
+
+    // stitch fixed sub-meshes back in place of the regions
+    bool allMerged = true;
+    for ( size_t i = 0; i < fixes.size(); ++i )
+    {
+        auto & fix = fixes[i];
+        if ( !fix.ok )
+        {
+            allMerged = false;
+            continue;
+        }
+        // keep the boundary edges of the region even if they become lone (e.g. on the boundary of open mesh) to stitch the sub-mesh along them
+        UndirectedEdgeBitSet keepEdges( mesh.topology.undirectedEdgeSize() );
+        for ( const auto & contour : fix.thisContours )
+            for ( auto e : contour )
+                keepEdges.set( e.undirected() );
+        mesh.topology.deleteFaces( regions[i], &keepEdges );
+        mesh.addMeshPart( fix.subMesh, false, fix.thisContours, fix.fromContours );
+        fix.report.merged = true;
+        fix.subMesh = {};
+    }
+    mesh.invalidateCaches();
+
+    if ( settings.outRegionReports )
+    {
+        settings.outRegionReports->clear();
+        settings.outRegionReports->reserve( fixes.size() );
+        for ( const auto & fix : fixes )
+            settings.outRegionReports->push_back( fix.report );
+    }
+
+    if ( !reportProgress( settings.callback, 0.9f ) )
+        return unexpectedOperationCanceled();
+
+    // the whole mesh is checked again, since merged sub-meshes can intersect the rest of the mesh,
+    // and the remaining self-intersections (including the ones in not merged regions) are fixed sequentially
+    if ( !allMerged )
+        spdlog::info( "SelfIntersections::fix: some regions are fixed sequentially" );
+    if ( auto seqRes = fixFound( mesh, regionSettings ); !seqRes )
+        return seqRes;
+
+    if ( !reportProgress( settings.callback, 1.0f ) )
+        return unexpectedOperationCanceled();
+    return {};
+}
+
 // Helper function to find own self-intersections on a mesh part
 static Expected<FaceBitSet> findSelfCollidingTrianglesBSForPart( Mesh& mesh, const FaceBitSet& part, ProgressCallback cb, bool touchIsIntersection )
 {
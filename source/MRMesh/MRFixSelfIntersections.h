@@ -2,6 +2,8 @@
 
 #include "MRMesh/MRMeshFwd.h"
 #include "MRMesh/MRExpected.h"
+#include "MRMesh/MRBox.h"
+#include <vector>
 
 namespace MR
 {
@@ -9,6 +11,21 @@ namespace MR
 namespace SelfIntersections
 {
 
+/// Information about one region of mesh fixed independently from others in `Settings::parallelRegions` mode
+struct RegionReport
+{
+    /// bounding box of the region before the fix
+    Box3f box;
+    /// the number of self-intersecting faces in the region before the fix
+    int numBadFaces = 0;
+    /// the number of faces in the cloned sub-mesh (self-intersecting faces with the margin around them)
+    int numFaces = 0;
+    /// time spent on the fix of the region's sub-mesh, in seconds
+    double seconds = 0;
+    /// false if the fix changed the boundary of the sub-mesh, so it was discarded and the region was fixed sequentially after all
+    bool merged = false;
+};
+
 /// Setting set for mesh self-intersections fix
 struct Settings
 {
@@ -32,6 +49,13 @@ struct Settings
     float subdivideEdgeLen = 0.0f;
     /// trying to stay close to initial surface when patching
     bool mimicPatch = false;
+    /// If true then the self-intersecting faces are clustered in spatially separated regions (with non-overlapping bounding boxes),
+    /// and each region is fixed on its own cloned sub-mesh in parallel with others, then the sub-meshes are stitched back
+    /// and the whole mesh is checked again to fix sequentially the self-intersections remaining after stitching;
+    /// it is much faster for meshes with many scattered defects
+    bool parallelRegions = false;
+    /// optional output: information about every region fixed in `parallelRegions` mode
+    std::vector<RegionReport>* outRegionReports = nullptr;
     /// Callback function
     ProgressCallback callback = {};
 };
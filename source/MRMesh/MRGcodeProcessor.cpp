@@ -3,8 +3,11 @@
 #include "MRMatrix2.h"
 #include "MRQuaternion.h"
 #include "MRTimer.h"
+#include "MRParallelFor.h"
+#include "MRPch/MRTBB.h"
 #include <cassert>
 #include <chrono>
+#include <istream>
 
 namespace MR
 {
@@ -43,9 +46,11 @@ std::vector<MR::GcodeProcessor::MoveAction> GcodeProcessor::processSource()
         return {};
 
     std::vector<MoveAction> res( gcodeSource_.size() );
-    std::vector<Command> tmp;
-    for ( int i = 0; i < gcodeSource_.size(); ++i )
-        res[i] = processLine( gcodeSource_[i], tmp );
+    processSource( [&res]( size_t firstLine, std::vector<MoveAction> & actions )
+    {
+        std::move( actions.begin(), actions.end(), res.begin() + firstLine );
+        return true;
+    } );
 
     for ( auto& action : res )
     {
@@ -56,6 +61,79 @@ std::vector<MR::GcodeProcessor::MoveAction> GcodeProcessor::processSource()
     return res;
 }
 
+bool GcodeProcessor::processSource( const MoveActionsSink & sink, size_t chunkLines )
+{
+    MR_TIMER;
+    assert( chunkLines > 0 );
+    ChunkBuffers buffers;
+    for ( size_t firstLine = 0; firstLine < gcodeSource_.size(); firstLine += chunkLines )
+    {
+        const auto numLines = std::min( chunkLines, gcodeSource_.size() - firstLine );
+        if ( !processChunk_( gcodeSource_.data() + firstLine, numLines, firstLine, buffers, sink ) )
+            return false;
+    }
+    return true;
+}
+
+bool GcodeProcessor::processStream( std::istream & in, const MoveActionsSink & sink, size_t chunkLines )
+{
+    MR_TIMER;
+    assert( chunkLines > 0 );
+    reset();
+
+    auto readChunk = [&in, chunkLines]( std::vector<std::string> & lines )
+    {
+        lines.clear();
+        std::string s;
+        while ( lines.size() < chunkLines && std::getline( in, s ) )
+        {
+            if ( !s.empty() )
+                lines.push_back( std::move( s ) );
+        }
+    };
+
+    ChunkBuffers buffers;
+    std::vector<std::string> lines, nextLines;
+    std::vector<std::string_view> views;
+    readChunk( lines );
+    size_t firstLine = 0;
+    while ( !lines.empty() )
+    {
+        // read next chunk while processing this one
+        tbb::task_group reading;
+        reading.run( [&] { readChunk( nextLines ); } );
+
+        views.assign( lines.begin(), lines.end() );
+        const bool proceed = processChunk_( views.data(), views.size(), firstLine, buffers, sink );
+        reading.wait();
+        if ( !proceed )
+            return false;
+
+        firstLine += lines.size();
+        std::swap( lines, nextLines );
+    }
+    return true;
+}
+
+bool GcodeProcessor::processChunk_( const std::string_view * lines, size_t numLines, size_t firstLine, ChunkBuffers & buffers, const MoveActionsSink & sink )
+{
+    // parsing of lines does not depend on modal state
+    buffers.commands.resize( numLines );
+    ParallelFor( size_t( 0 ), numLines, [&]( size_t i )
+    {
+        auto & commands = buffers.commands[i];
+        commands.clear();
+        if ( !lines[i].empty() )
+            parseFrame_( lines[i], commands );
+    } );
+
+    buffers.actions.resize( numLines );
+    for ( size_t i = 0; i < numLines; ++i )
+        buffers.actions[i] = processCommands_( buffers.commands[i] );
+
+    return sink( firstLine, buffers.actions );
+}
+
 GcodeProcessor::MoveAction GcodeProcessor::processLine( const std::string_view& line, std::vector<Command> & commands )
 {
     if ( line.empty() )
@@ -63,6 +141,11 @@ GcodeProcessor::MoveAction GcodeProcessor::processLine( const std::string_view&
 
     commands.clear();
     parseFrame_( line, commands );
+    return processCommands_( commands );
+}
+
+GcodeProcessor::MoveAction GcodeProcessor::processCommands_( const std::vector<Command> & commands )
+{
     if ( commands.empty() )
         return {};
 
@@ -7,6 +7,7 @@
 #include <string>
 #include <optional>
 #include <functional>
+#include <iosfwd>
 
 
 namespace MR
@@ -48,6 +49,27 @@ public:
     // process all lines g-code source and generate corresponding move actions
     MRMESH_API std::vector<MoveAction> processSource();
 
+    // receives the batch of move actions generated for the lines [firstLine, firstLine + actions.size()),
+    // the actions can be moved out; returns false to stop processing
+    using MoveActionsSink = std::function<bool( size_t firstLine, std::vector<MoveAction> & actions )>;
+
+    // process all lines g-code source in chunks of given number of lines:
+    // the commands of all lines in a chunk are parsed in parallel, then modal state is applied sequentially,
+    // and the move actions of the chunk are passed to the sink;
+    // unlike the function above, idle movements with zero feedrate are not replaced with maximal feedrate (see getMaxFeedrate)
+    // \return false if the sink stopped processing
+    MRMESH_API bool processSource( const MoveActionsSink & sink, size_t chunkLines = cDefaultChunkLines );
+
+    // resets internal states and processes g-code lines read from the stream (empty lines are skipped as in GcodeLoad::fromGcode),
+    // the whole program is never kept in memory: next chunk of lines is read while previous one is processed
+    // \return false if the sink stopped processing
+    MRMESH_API bool processStream( std::istream & in, const MoveActionsSink & sink, size_t chunkLines = cDefaultChunkLines );
+
+    // maximal feedrate of working movements processed so far
+    float getMaxFeedrate() const { return feedrateMax_; }
+
+    static constexpr size_t cDefaultChunkLines = 65536;
+
     struct Command
     {
         char key; // in lowercase
@@ -72,6 +94,14 @@ private:
 
     // parse program methods
     static void parseFrame_( const std::string_view& frame, std::vector<Command> & outCommands );
+    MoveAction processCommands_( const std::vector<Command> & commands );
+    // reusable buffers for chunked processing
+    struct ChunkBuffers
+    {
+        std::vector<std::vector<Command>> commands; // parsed commands of each line
+        std::vector<MoveAction> actions;
+    };
+    bool processChunk_( const std::string_view * lines, size_t numLines, size_t firstLine, ChunkBuffers & buffers, const MoveActionsSink & sink );
     void applyCommand_( const Command& command );
     void applyCommandG_( const Command& command );
     MoveAction generateMoveAction_();
@@ -0,0 +1,253 @@
+#include "MRHeatGeodesics.h"
+#include "MRMesh.h"
+#include "MRMeshComponents.h"
+#include "MRRingIterator.h"
+#include "MRBitSetParallelFor.h"
+#include "MRParallelFor.h"
+#include "MRTriMath.h"
+#include "MRHeapBytes.h"
+#include "MRTimer.h"
+#include <Eigen/SparseCholesky>
+
+namespace MR
+{
+
+namespace
+{
+
+using SparseMatrix = Eigen::SparseMatrix<double, Eigen::ColMajor>;
+using Solver = Eigen::SimplicialLDLT<SparseMatrix>;
+
+/// cotangents are limited to avoid huge weights of degenerate triangles
+constexpr double cMaxCotan = 1e5;
+
+/// returns the cotangent of the angle at t[2]
+double limitedCotan( const Vector3d & p0, const Vector3d & p1, const Vector3d & p2 )
+{
+    return cotan( Triangle3d{ p0, p1, p2 }, cMaxCotan );
+}
+
+size_t solverHeapBytes( const Solver & s )
+{
+    return s.matrixL().nestedExpression().nonZeros() * ( sizeof( double ) + sizeof( int ) )
+        + s.rows() * ( 2 * sizeof( double ) + 2 * sizeof( int ) );
+}
+
+} // anonymous namespace
+
+class HeatGeodesics::Operators
+{
+public:
+    /// index of each valid vertex in the heat system, -1 for invalid vertices
+    Vector<int, VertId> heatId;
+    /// index of each valid vertex in Poisson system, -1 for invalid vertices and one pinned vertex in each connected component
+    Vector<int, VertId> poissonId;
+    /// connected component of each valid vertex
+    Vector<int, VertId> component;
+    int numComponents = 0;
+
+    /// factorized ( M + t*L )
+    Solver heatSolver;
+    /// factorized L without the rows and columns of pinned vertices
+    Solver poissonSolver;
+};
+
+HeatGeodesics::HeatGeodesics( const Mesh & mesh, float timeFactor )
+{
+    MR_TIMER;
+    auto ops = std::make_shared<Operators>();
+    const auto & topology = mesh.topology;
+    const auto & validVerts = topology.getValidVerts();
+
+    ops->heatId.resize( topology.vertSize(), -1 );
+    ops->poissonId.resize( topology.vertSize(), -1 );
+    ops->component.resize( topology.vertSize(), -1 );
+
+    // the distances are defined up to a constant in each connected component, so one vertex in each is pinned
+    const auto comps = MeshComponents::getAllComponentsVerts( mesh );
+    ops->numComponents = (int)comps.size();
+    for ( int c = 0; c < ops->numComponents; ++c )
+        for ( auto v : comps[c] )
+            ops->component[v] = c;
+
+    int numHeat = 0, numPoisson = 0;
+    for ( auto v : validVerts )
+    {
+        ops->heatId[v] = numHeat++;
+        const auto c = ops->component[v];
+        if ( c >= 0 && comps[c].find_first() != v )
+            ops->poissonId[v] = numPoisson++;
+    }
+
+    // cotangent Laplacian and lumped mass matrix are assembled from triangles
+    const double t = timeFactor * sqr( double( mesh.averageEdgeLength() ) );
+    std::vector<Eigen::Triplet<double>> heatTriplets, poissonTriplets;
+    heatTriplets.reserve( 10 * size_t( numHeat ) );
+    poissonTriplets.reserve( 10 * size_t( numPoisson ) );
+    auto addEdge = [&]( VertId i, VertId j, double w )
+    {
+        const auto hi = ops->heatId[i], hj = ops->heatId[j];
+        heatTriplets.emplace_back( hi, hi, t * w );
+        heatTriplets.emplace_back( hj, hj, t * w );
+        heatTriplets.emplace_back( hi, hj, -t * w );
+        heatTriplets.emplace_back( hj, hi, -t * w );
+
+        const auto pi = ops->poissonId[i], pj = ops->poissonId[j];
+        if ( pi >= 0 )
+            poissonTriplets.emplace_back( pi, pi, w );
+        if ( pj >= 0 )
+            poissonTriplets.emplace_back( pj, pj, w );
+        if ( pi >= 0 && pj >= 0 )
+        {
+            poissonTriplets.emplace_back( pi, pj, -w );
+            poissonTriplets.emplace_back( pj, pi, -w );
+        }
+    };
+    for ( auto f : topology.getValidFaces() )
+    {
+        VertId a, b, c;
+        topology.getTriVerts( f, a, b, c );
+        const Vector3d pa( mesh.points[a] ), pb( mesh.points[b] ), pc( mesh.points[c] );
+        addEdge( a, b, 0.5 * limitedCotan( pa, pb, pc ) );
+        addEdge( b, c, 0.5 * limitedCotan( pb, pc, pa ) );
+        addEdge( c, a, 0.5 * limitedCotan( pc, pa, pb ) );
+        const double massPerVert = cross( pb - pa, pc - pa ).length() / 6;
+        heatTriplets.emplace_back( ops->heatId[a], ops->heatId[a], massPerVert );
+        heatTriplets.emplace_back( ops->heatId[b], ops->heatId[b], massPerVert );
+        heatTriplets.emplace_back( ops->heatId[c], ops->heatId[c], massPerVert );
+    }
+
+    {
+        SparseMatrix heat( numHeat, numHeat );
+        heat.setFromTriplets( heatTriplets.begin(), heatTriplets.end() );
+        heatTriplets = {};
+        ops->heatSolver.compute( heat );
+        assert( ops->heatSolver.info() == Eigen::Success );
+    }
+    {
+        SparseMatrix poisson( numPoisson, numPoisson );
+        poisson.setFromTriplets( poissonTriplets.begin(), poissonTriplets.end() );
+        poissonTriplets = {};
+        ops->poissonSolver.compute( poisson );
+        assert( ops->poissonSolver.info() == Eigen::Success );
+    }
+    ops_ = std::move( ops );
+}
+
+VertScalars HeatGeodesics::compute( const Mesh & mesh, const VertBitSet & sources ) const
+{
+    MR_TIMER;
+    const auto & ops = *ops_;
+    const auto & topology = mesh.topology;
+    assert( topology.vertSize() == ops.heatId.size() );
+    VertScalars res( ops.heatId.size(), FLT_MAX );
+
+    // 1) diffuse heat from the sources
+    Eigen::VectorXd u = Eigen::VectorXd::Zero( ops.heatSolver.rows() );
+    std::vector<double> minSourceDist( ops.numComponents, DBL_MAX );
+    bool anySource = false;
+    for ( auto v : sources )
+    {
+        if ( v >= ops.heatId.size() || ops.heatId[v] < 0 )
+            continue;
+        u[ops.heatId[v]] = 1;
+        anySource = true;
+    }
+    if ( !anySource )
+        return res;
+    u = ops.heatSolver.solve( u );
+
+    // 2) normalized negated gradient of heat in triangles
+    Vector<Vector3d, FaceId> dir( topology.faceSize() );
+    BitSetParallelFor( topology.getValidFaces(), [&]( FaceId f )
+    {
+        VertId a, b, c;
+        topology.getTriVerts( f, a, b, c );
+        const Vector3d pa( mesh.points[a] );
+        const double ua = u[ops.heatId[a]];
+        const auto grad = gradientInTri( Vector3d( mesh.points[b] ) - pa, Vector3d( mesh.points[c] ) - pa,
+            u[ops.heatId[b]] - ua, u[ops.heatId[c]] - ua );
+        if ( !grad )
+            return;
+        const auto len = grad->length();
+        if ( len > 0 )
+            dir[f] = -*grad / len;
+    } );
+
+    // 3) integrated divergence of the directions in the vertices
+    Eigen::VectorXd div( ops.poissonSolver.rows() );
+    BitSetParallelFor( topology.getValidVerts(), [&]( VertId v )
+    {
+        const auto pv = ops.poissonId[v];
+        if ( pv < 0 )
+            return;
+        const Vector3d p( mesh.points[v] );
+        double sum = 0;
+        for ( auto e : orgRing( topology, v ) )
+        {
+            const auto f = topology.left( e );
+            if ( !f )
+                continue;
+            VertId a, b, c;
+            topology.getLeftTriVerts( e, a, b, c );
+            assert( a == v );
+            const Vector3d pb( mesh.points[b] ), pc( mesh.points[c] );
+            sum += limitedCotan( p, pb, pc ) * dot( pb - p, dir[f] ) + limitedCotan( pc, p, pb ) * dot( pc - p, dir[f] );
+        }
+        div[pv] = -0.5 * sum;
+    } );
+
+    // 4) recover the distances from their gradients
+    const Eigen::VectorXd phi = ops.poissonSolver.solve( div );
+    auto getPhi = [&]( VertId v )
+    {
+        const auto pv = ops.poissonId[v];
+        return pv >= 0 ? phi[pv] : 0.0;
+    };
+    for ( auto v : sources )
+    {
+        if ( v >= ops.component.size() || ops.component[v] < 0 )
+            continue;
+        auto & m = minSourceDist[ops.component[v]];
+        m = std::min( m, getPhi( v ) );
+    }
+    BitSetParallelFor( topology.getValidVerts(), [&]( VertId v )
+    {
+        const auto m = minSourceDist[ops.component[v]];
+        if ( m < DBL_MAX )
+            res[v] = float( std::max( 0.0, getPhi( v ) - m ) );
+    } );
+    return res;
+}
+
+size_t HeatGeodesics::heapBytes() const
+{
+    if ( !ops_ )
+        return 0;
+    return sizeof( Operators )
+        + MR::heapBytes( ops_->heatId )
+        + MR::heapBytes( ops_->poissonId )
+        + MR::heapBytes( ops_->component )
+        + solverHeapBytes( ops_->heatSolver )
+        + solverHeapBytes( ops_->poissonSolver );
+}
+
+VertScalars computeHeatGeodesics( const Mesh & mesh, const VertBitSet & sources )
+{
+    return mesh.getHeatGeodesics().compute( mesh, sources );
+}
+
+Expected<std::vector<VertScalars>> computeHeatGeodesics( const Mesh & mesh, const std::vector<VertBitSet> & sources, ProgressCallback cb )
+{
+    MR_TIMER;
+    const auto & heat = mesh.getHeatGeodesics();
+    std::vector<VertScalars> res( sources.size() );
+    if ( !ParallelFor( res, [&]( size_t i )
+    {
+        res[i] = heat.compute( mesh, sources[i] );
+    }, cb, 1 ) )
+        return unexpectedOperationCanceled();
+    return res;
+}
+
+} //namespace MR
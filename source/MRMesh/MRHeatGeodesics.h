@@ -0,0 +1,52 @@
+#pragma once
+
+#include "MRMeshFwd.h"
+#include "MRExpected.h"
+#include <memory>
+#include <vector>
+
+namespace MR
+{
+
+/// \addtogroup SurfaceDistanceGroup
+/// \{
+
+/// computes approximate geodesic distances on mesh by the heat method (Crane, Weischedel, Wardetzky "Geodesics in Heat"):
+/// 1) heat u is diffused from the sources during short time t by solving ( M + t*L ) u = sources,
+/// 2) normalized negated gradient X = -grad u / |grad u| is found in every triangle,
+/// 3) the distances are found from Poisson equation L d = -div X;
+/// here L is cotangent Laplacian and M is lumped mass matrix;
+/// both matrices are factorized once in the constructor, so each query costs only two back-substitutions;
+/// the object does not reference the mesh, and the copies of the object share the factorization
+class HeatGeodesics
+{
+public:
+    /// factorizes the operators of given mesh
+    /// \param timeFactor multiplies the time of heat diffusion equal by default to squared average edge length;
+    /// larger values give smoother distances
+    MRMESH_API explicit HeatGeodesics( const Mesh & mesh, float timeFactor = 1 );
+
+    /// computes distances from given source vertices in the same mesh, which was given in the constructor;
+    /// the vertices of the components without sources get FLT_MAX
+    [[nodiscard]] MRMESH_API VertScalars compute( const Mesh & mesh, const VertBitSet & sources ) const;
+
+    /// returns the amount of memory this object occupies on heap
+    [[nodiscard]] MRMESH_API size_t heapBytes() const;
+
+private:
+    class Operators;
+    std::shared_ptr<const Operators> ops_;
+};
+
+/// computes approximate geodesic distances from given source vertices by the heat method,
+/// the factorized operators are cached in the mesh (see Mesh::getHeatGeodesics), so next calls with other sources are fast
+[[nodiscard]] MRMESH_API VertScalars computeHeatGeodesics( const Mesh & mesh, const VertBitSet & sources );
+
+/// computes approximate geodesic distances from each given set of source vertices by the heat method in parallel,
+/// the factorized operators are cached in the mesh
+[[nodiscard]] MRMESH_API Expected<std::vector<VertScalars>> computeHeatGeodesics( const Mesh & mesh, const std::vector<VertBitSet> & sources,
+    ProgressCallback cb = {} );
+
+/// \}
+
+} // namespace MR
@@ -1,6 +1,9 @@
 #pragma once
 #include "MRMeshFwd.h"
+#include "MRExpected.h"
 #include <functional>
+#include <iosfwd>
+#include <memory>
 #include <string>
 
 namespace MR
@@ -30,6 +33,18 @@ public:
 
     /// returns the amount of memory this object occupies on heap
     [[nodiscard]] virtual size_t heapBytes() const = 0;
+
+    /// optional support of memory-budgeted history: given the action appended right after this one
+    /// (so its stored state is exactly the state after this action), replaces full copy of object's data stored here
+    /// with the difference from the state in nextAction; returns true if the conversion took place
+    virtual bool convertToDiff( const HistoryAction & nextAction ) { (void)nextAction; return false; }
+
+    /// optional support of memory-budgeted history: writes all data necessary for undo/redo in given stream and releases them from memory;
+    /// returns false if the action does not support offloading, and nothing was written then
+    virtual bool offloadData( std::ostream & out ) { (void)out; return false; }
+
+    /// restores the data previously written by successful offloadData() call
+    virtual Expected<void> restoreData( std::istream & in ) { (void)in; return {}; }
 };
 
 using HistoryStackFilter = std::function<bool( const std::shared_ptr<HistoryAction>& )>;
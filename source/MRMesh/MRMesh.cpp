@@ -27,6 +27,8 @@
 #include "MRMeshFillHole.h"
 #include "MRTriMesh.h"
 #include "MRDipole.h"
+#include "MRCollisionTriangle.h"
+#include "MRHeatGeodesics.h"
 #include "MRPartMappingAdapters.h"
 
 namespace MR
@@ -463,6 +465,8 @@ Expected<PackMapping> Mesh::packOptimally( bool preserveAABBTree, ProgressCallba
 
     PackMapping map;
     AABBTreePointsOwner_.reset(); // points-tree will be invalidated anyway
+    collisionTrianglesOwner_.reset(); // per-face data will be invalidated by faces renumbering
+    heatGeodesicsOwner_.reset(); // per-vertex operators will be invalidated by vertices renumbering
     if ( preserveAABBTree )
     {
         getAABBTree(); // ensure that tree is constructed
@@ -557,12 +561,24 @@ const Dipoles & Mesh::getDipoles() const
     return res;
 }
 
+const CollisionTriangles & Mesh::getCollisionTriangles() const
+{
+    return collisionTrianglesOwner_.getOrCreate( [this] { return calcCollisionTriangles( *this ); } );
+}
+
+const HeatGeodesics & Mesh::getHeatGeodesics() const
+{
+    return heatGeodesicsOwner_.getOrCreate( [this] { return HeatGeodesics( *this ); } );
+}
+
 void Mesh::invalidateCaches( bool pointsChanged )
 {
     AABBTreeOwner_.reset();
     if ( pointsChanged )
         AABBTreePointsOwner_.reset();
     dipolesOwner_.reset();
+    collisionTrianglesOwner_.reset();
+    heatGeodesicsOwner_.reset();
 }
 
 void Mesh::updateCaches( const VertBitSet & changedVerts )
@@ -578,6 +594,8 @@ void Mesh::updateCaches( const VertBitSet & changedVerts )
         tree.refit( points, changedVerts );
     } );
     dipolesOwner_.reset();
+    collisionTrianglesOwner_.reset();
+    heatGeodesicsOwner_.reset();
 }
 
 size_t Mesh::heapBytes() const
@@ -586,7 +604,9 @@ size_t Mesh::heapBytes() const
         + points.heapBytes()
         + AABBTreeOwner_.heapBytes()
         + AABBTreePointsOwner_.heapBytes()
-        + dipolesOwner_.heapBytes();
+        + dipolesOwner_.heapBytes()
+        + collisionTrianglesOwner_.heapBytes()
+        + heatGeodesicsOwner_.heapBytes();
 }
 
 void Mesh::shrinkToFit()
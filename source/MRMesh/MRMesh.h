@@ -475,6 +475,21 @@ struct [[nodiscard]] Mesh
     /// returns cached dipoles of aabb-tree nodes for this mesh, but does not create it if it did not exist
     [[nodiscard]] const Dipoles * getDipolesNotCreate() const { return dipolesOwner_.get(); }
 
+    /// returns cached per-face collision data for this mesh, creating it if it did not exist in a thread-safe manner;
+    /// once created, it is used by findCollidingTriangles and findSelfCollidingTriangles to reject most non-colliding
+    /// triangle pairs without accessing mesh topology; requires 56 bytes per face
+    MRMESH_API const CollisionTriangles & getCollisionTriangles() const;
+
+    /// returns cached per-face collision data for this mesh, but does not create it if it did not exist
+    [[nodiscard]] const CollisionTriangles * getCollisionTrianglesNotCreate() const { return collisionTrianglesOwner_.get(); }
+
+    /// returns cached factorized operators of heat method for geodesic distances (see computeHeatGeodesics),
+    /// creating them if they did not exist in a thread-safe manner
+    MRMESH_API const HeatGeodesics & getHeatGeodesics() const;
+
+    /// returns cached factorized operators of heat method, but does not create them if they did not exist
+    [[nodiscard]] const HeatGeodesics * getHeatGeodesicsNotCreate() const { return heatGeodesicsOwner_.get(); }
+
     /// invalidates caches (aabb-trees) after any change in mesh geometry or topology
     /// \param pointsChanged specifies whether points have changed (otherwise only topology has changed)
     MRMESH_API void invalidateCaches( bool pointsChanged = true );
@@ -497,6 +512,8 @@ private:
     mutable SharedThreadSafeOwner<AABBTree> AABBTreeOwner_;
     mutable SharedThreadSafeOwner<AABBTreePoints> AABBTreePointsOwner_;
     mutable SharedThreadSafeOwner<Dipoles> dipolesOwner_;
+    mutable SharedThreadSafeOwner<CollisionTriangles> collisionTrianglesOwner_;
+    mutable SharedThreadSafeOwner<HeatGeodesics> heatGeodesicsOwner_;
 };
 
 } //namespace MR
@@ -429,89 +429,309 @@ MeshTopology fromDisjointMeshPieces( const Triangulation & t, VertId maxVertId,
 
 constexpr size_t minTrisInPart = 32768;
 
-static MeshTopology fromTrianglesPar( const Triangulation & t, const BuildSettings & settings, ProgressCallback progressCb )
+namespace
 {
-    MR_TIMER;
 
-    // reserve enough elements for faces and vertices
-    //auto [maxFaceId, maxVertId] = computeMaxIds( t );
-    const auto maxVertId = findMaxVertId( t, settings.region );
+/// a triangle incident to some vertex v given by two other vertices in counter-clockwise order
+struct FanCorner
+{
+    VertId out; ///< triangle's edge (v, out) has the triangle on the left
+    VertId in;  ///< triangle's edge (in, v) has the triangle on the left
+    FaceId f;
+};
 
-    // numParts shall not depend on hardware (e.g. on std::thread::hardware_concurrency()) to be repeatable on all hardware
-    const size_t numParts = std::min( ( t.size() + minTrisInPart - 1 ) / minTrisInPart, (size_t)64 );
-    assert( numParts > 1 );
-    MeshTopology res;
+/// a neighbor vertex in the ring of some vertex v and the face to the left of edge (v, neighbor)
+struct RingNeighbor
+{
+    VertId v;
+    FaceId left;
+};
 
-    const size_t vertsInPart = ( (int)maxVertId + numParts ) / numParts;
-    std::vector<MeshPiece> parts( numParts );
+/// reusable memory of one thread for building vertex rings
+struct FanBuffers
+{
+    std::vector<FanCorner> corners;
+    std::vector<VertId> ins;
+    std::vector<char> visited;
+};
 
-    Timer timer("partition triangles");
-    if ( progressCb && !progressCb( 0.33f ) )
-        return {};
-    FaceBitSet borderTris( t.size() ); // triangles having vertices in distinct parts
-    BitSetParallelForAll( borderTris, [&]( FaceId f )
+/// computes the ring of vertex v from the triangles incident to it: neighbor vertices in counter-clockwise order;
+/// the triangles can form one closed fan or any number of open fans (then each is followed by a hole);
+/// \return false if the vertex cannot be built independently from others: it has non-manifold edges or a closed fan together with other fans
+bool buildVertexRing( VertId v, const FaceId * firstFace, const FaceId * lastFace, const Triangulation & t, const FaceBitSet * skip,
+    FanBuffers & buf, std::vector<RingNeighbor> & ring )
+{
+    ring.clear();
+    auto & cs = buf.corners;
+    cs.clear();
+    for ( auto it = firstFace; it != lastFace; ++it )
+    {
+        const auto f = *it;
+        if ( skip && skip->test( f ) )
+            continue;
+        const auto & tri = t[f];
+        const int i = tri[0] == v ? 0 : ( tri[1] == v ? 1 : 2 );
+        cs.push_back( { tri[( i + 1 ) % 3], tri[( i + 2 ) % 3], f } );
+    }
+    if ( cs.empty() )
+        return true;
+
+    std::sort( cs.begin(), cs.end(), [] ( const FanCorner & a, const FanCorner & b ) { return a.out < b.out; } );
+    for ( size_t i = 1; i < cs.size(); ++i )
+        if ( cs[i - 1].out == cs[i].out )
+            return false; // two triangles with the same directed edge
+    auto & ins = buf.ins;
+    ins.clear();
+    for ( const auto & c : cs )
+        ins.push_back( c.in );
+    std::sort( ins.begin(), ins.end() );
+    if ( std::adjacent_find( ins.begin(), ins.end() ) != ins.end() )
+        return false; // two triangles with the same directed edge
+
+    // returns the index of the corner with given out-vertex or -1
+    auto findOut = [&] ( VertId x )
+    {
+        auto it = std::lower_bound( cs.begin(), cs.end(), x, [] ( const FanCorner & c, VertId y ) { return c.out < y; } );
+        return it != cs.end() && it->out == x ? int( it - cs.begin() ) : -1;
+    };
+
+    auto & visited = buf.visited;
+    visited.assign( cs.size(), 0 );
+    size_t numVisited = 0;
+    // open fans start from the triangles without clockwise neighbor
+    for ( int s = 0; s < (int)cs.size(); ++s )
+    {
+        if ( std::binary_search( ins.begin(), ins.end(), cs[s].out ) )
+            continue;
+        for ( int j = s;; )
+        {
+            visited[j] = 1;
+            ++numVisited;
+            ring.push_back( { cs[j].out, cs[j].f } );
+            const int k = findOut( cs[j].in );
+            if ( k < 0 )
+            {
+                ring.push_back( { cs[j].in, FaceId{} } ); // the hole follows
+                break;
+            }
+            assert( !visited[k] );
+            j = k;
+        }
+    }
+    if ( numVisited == cs.size() )
+        return true;
+    if ( numVisited > 0 )
+        return false; // closed fan together with open fans
+
+    for ( int j = 0;; )
+    {
+        visited[j] = 1;
+        ++numVisited;
+        ring.push_back( { cs[j].out, cs[j].f } );
+        j = findOut( cs[j].in );
+        assert( j >= 0 );
+        if ( j == 0 )
+            break;
+    }
+    return numVisited == cs.size(); // false if there are several closed fans
+}
+
+} // anonymous namespace
+
+/// builds all vertices having simple triangle fans around them in parallel, and then adds remaining triangles sequentially
+static MeshTopology fromTrianglesByFans( const Triangulation & t, const BuildSettings & settings, ProgressCallback progressCb )
+{
+    MR_TIMER;
+
+    // permanently bad triangles with repeating vertices
+    FaceBitSet bad( t.size() );
+    // triangles to build, which are not bad
+    FaceBitSet active( t.size() );
+    BitSetParallelForAll( active, [&] ( FaceId f )
     {
         if ( settings.region && !settings.region->test( f ) )
             return;
         const auto & vs = t[f];
-        auto v0p = int( vs[0] / vertsInPart );
-        auto v1p = int( vs[1] / vertsInPart );
-        auto v2p = int( vs[2] / vertsInPart );
-        if ( v0p == v1p && v0p == v2p )
-            return;
-        borderTris.set( f );
+        if ( vs[0] == vs[1] || vs[1] == vs[2] || vs[2] == vs[0] )
+            bad.set( f );
+        else
+            active.set( f );
     } );
+    const auto maxVertId = findMaxVertId( t, settings.region );
+    const size_t numVerts = maxVertId + 1;
+    if ( !reportProgress( progressCb, 0.1f ) )
+        return {};
 
-    timer.restart("parallel parts");
-    if ( progressCb && !progressCb( 0.4f ) )
+    Timer timer( "vertex faces" );
+    // incident triangles of each vertex in vertFaces[vertFacesStart[v], vertFacesStart[v+1])
+    std::vector<size_t> vertFacesStart( numVerts + 1, 0 );
+    std::vector<FaceId> vertFaces;
+    {
+        std::vector<std::atomic<std::uint32_t>> counts( numVerts );
+        BitSetParallelFor( active, [&] ( FaceId f )
+        {
+            for ( auto v : t[f] )
+                counts[v].fetch_add( 1, std::memory_order_relaxed );
+        } );
+        for ( size_t v = 0; v < numVerts; ++v )
+        {
+            vertFacesStart[v + 1] = vertFacesStart[v] + counts[v].load( std::memory_order_relaxed );
+            counts[v].store( 0, std::memory_order_relaxed );
+        }
+        vertFaces.resize( vertFacesStart.back() );
+        BitSetParallelFor( active, [&] ( FaceId f )
+        {
+            for ( auto v : t[f] )
+                vertFaces[vertFacesStart[v] + counts[v].fetch_add( 1, std::memory_order_relaxed )] = f;
+        } );
+    }
+    // the order of faces after concurrent filling is random, sort them to get repeatable results
+    ParallelFor( size_t( 0 ), numVerts, [&] ( size_t v )
+    {
+        std::sort( vertFaces.begin() + vertFacesStart[v], vertFaces.begin() + vertFacesStart[v + 1] );
+    } );
+    if ( !reportProgress( progressCb, 0.25f ) )
         return {};
-    tbb::parallel_for( tbb::blocked_range<size_t>( 0, numParts, 1 ), [&]( const tbb::blocked_range<size_t> & range )
+
+    tbb::enumerable_thread_specific<std::pair<FanBuffers, std::vector<RingNeighbor>>> threadData;
+    auto buildRing = [&] ( VertId v, const FaceBitSet * skip ) -> bool
     {
-        assert( range.begin() + 1 == range.end() );
-        for ( size_t myPartId = range.begin(); myPartId < range.end(); ++myPartId )
+        auto & [buf, ring] = threadData.local();
+        const auto * faces = vertFaces.data();
+        return buildVertexRing( v, faces + vertFacesStart[v], faces + vertFacesStart[v + 1], t, skip, buf, ring );
+    };
+
+    timer.restart( "problematic vertices" );
+    // the vertices with non-manifold edges or non-manifold fans
+    VertBitSet problemVerts( numVerts );
+    BitSetParallelForAll( problemVerts, [&] ( VertId v )
+    {
+        if ( !buildRing( v, nullptr ) )
+            problemVerts.set( v );
+    } );
+    // the triangles incident to problematic vertices will be added sequentially after all others
+    FaceBitSet deferred( t.size() );
+    if ( problemVerts.any() )
+    {
+        BitSetParallelForAll( deferred, [&] ( FaceId f )
         {
-            MeshPiece part;
-            Triangulation partTriangulation;
-            BuildSettings partSettings{ .region = &part.rem, .allowNonManifoldEdge = settings.allowNonManifoldEdge };
-            part.vmap.resize( vertsInPart );
-            const VertId myBeginVert( myPartId * vertsInPart );
-            const VertId myEndVert( ( myPartId + 1 ) * vertsInPart );
-            for ( FaceId f{0}; f < t.size(); ++f )
-            {
-                if ( settings.region && !settings.region->test( f ) )
-                    continue;
-                if ( borderTris.test( f ) )
-                    continue;
-                const auto & vs = t[f];
-                if ( vs[0] < myBeginVert || vs[0] >= myEndVert )
-                    continue;
-                VertId v[3] = {
-                    VertId( vs[0] % vertsInPart ),
-                    VertId( vs[1] % vertsInPart ),
-                    VertId( vs[2] % vertsInPart )
-                };
-                FaceId fp{ partTriangulation.size() };
-                partTriangulation.push_back( ThreeVertIds{ v[0], v[1], v[2] } );
-                part.fmap.push_back( f );
-                part.vmap[ v[0] ] = vs[0];
-                part.vmap[ v[1] ] = vs[1];
-                part.vmap[ v[2] ] = vs[2];
-                part.rem.autoResizeSet( fp );
-            }
-            part.topology = fromTrianglesSeq( partTriangulation, partSettings );
-            parts[myPartId] = std::move( part );
+            if ( !active.test( f ) )
+                return;
+            const auto & vs = t[f];
+            if ( problemVerts.test( vs[0] ) || problemVerts.test( vs[1] ) || problemVerts.test( vs[2] ) )
+                deferred.set( f );
+        } );
+    }
+    if ( !reportProgress( progressCb, 0.4f ) )
+        return {};
+
+    timer.restart( "ring sizes" );
+    // each undirected edge is counted in its vertex with smaller id
+    std::vector<size_t> ringStarts( numVerts + 1, 0 );
+    std::vector<size_t> uedgeStarts( numVerts + 1, 0 );
+    ParallelFor( size_t( 0 ), numVerts, [&] ( size_t i )
+    {
+        const VertId v( i );
+        if ( problemVerts.test( v ) )
+            return;
+        [[maybe_unused]] const bool ok = buildRing( v, &deferred );
+        assert( ok ); // removal of triangles cannot make the vertex problematic
+        const auto & ring = threadData.local().second;
+        ringStarts[i + 1] = ring.size();
+        uedgeStarts[i + 1] = std::count_if( ring.begin(), ring.end(), [v] ( const RingNeighbor & n ) { return n.v > v; } );
+    } );
+    for ( size_t i = 0; i < numVerts; ++i )
+    {
+        ringStarts[i + 1] += ringStarts[i];
+        uedgeStarts[i + 1] += uedgeStarts[i];
+    }
+    const size_t numUndirectedEdges = uedgeStarts.back();
+    assert( ringStarts.back() == 2 * numUndirectedEdges );
+    if ( !reportProgress( progressCb, 0.55f ) )
+        return {};
+
+    timer.restart( "rings" );
+    // the neighbors with larger ids of each vertex in increasing order, the position of the neighbor is the id of undirected edge
+    std::vector<VertId> uedgeDests( numUndirectedEdges );
+    std::vector<VertId> ringVerts( ringStarts.back() );
+    std::vector<MeshTopology::RingEdge> ringEdges( ringStarts.back() );
+    ParallelFor( size_t( 0 ), numVerts, [&] ( size_t i )
+    {
+        const VertId v( i );
+        if ( problemVerts.test( v ) )
+            return;
+        buildRing( v, &deferred );
+        const auto & ring = threadData.local().second;
+        auto d = uedgeStarts[i];
+        for ( size_t j = 0; j < ring.size(); ++j )
+        {
+            ringVerts[ringStarts[i] + j] = ring[j].v;
+            ringEdges[ringStarts[i] + j].left = ring[j].left ? ring[j].left + settings.shiftFaceId : FaceId{};
+            if ( ring[j].v > v )
+                uedgeDests[d++] = ring[j].v;
         }
+        assert( d == uedgeStarts[i + 1] );
+        std::sort( uedgeDests.begin() + uedgeStarts[i], uedgeDests.begin() + d );
     } );
+    if ( !reportProgress( progressCb, 0.7f ) )
+        return {};
+
+    // returns the edge from a to b
+    auto findEdge = [&] ( VertId a, VertId b )
+    {
+        const bool flip = a > b;
+        if ( flip )
+            std::swap( a, b );
+        const auto first = uedgeDests.begin() + uedgeStarts[a];
+        const auto last = uedgeDests.begin() + uedgeStarts[a + 1];
+        const auto it = std::lower_bound( first, last, b );
+        assert( it != last && *it == b );
+        const EdgeId e( UndirectedEdgeId( int( it - uedgeDests.begin() ) ) );
+        return flip ? e.sym() : e;
+    };
+
+    timer.restart( "edge ids" );
+    ParallelFor( size_t( 0 ), numVerts, [&] ( size_t i )
+    {
+        const VertId v( i );
+        for ( auto j = ringStarts[i]; j < ringStarts[i + 1]; ++j )
+            ringEdges[j].e = findEdge( v, ringVerts[j] );
+    } );
+    ringVerts = {};
+
+    Vector<EdgeId, FaceId> edgePerFace( t.size() + settings.shiftFaceId );
+    BitSetParallelFor( active, [&] ( FaceId f )
+    {
+        if ( !deferred.test( f ) )
+            edgePerFace[f + settings.shiftFaceId] = findEdge( t[f][0], t[f][1] );
+    } );
+    if ( !reportProgress( progressCb, 0.8f ) )
+        return {};
 
-    auto joinSettings = settings;
-    joinSettings.region = &borderTris;
-    if ( progressCb && !progressCb( 0.66f ) )
+    MeshTopology res;
+    if ( !res.buildFromRings( ringStarts, ringEdges, numUndirectedEdges, std::move( edgePerFace ), subprogress( progressCb, 0.8f, 0.9f ) ) )
+        return {};
+    ringEdges = {};
+
+    // add triangles around problematic vertices
+    if ( deferred.any() )
+    {
+        BuildSettings seqSettings = settings;
+        seqSettings.region = &deferred;
+        seqSettings.skippedFaceCount = nullptr;
+        addTrianglesSeqCore( res, t, seqSettings );
+    }
+    if ( !reportProgress( progressCb, 1.0f ) )
         return {};
-    res = fromDisjointMeshPieces( t, maxVertId, parts, joinSettings );
-    if ( settings.skippedFaceCount )
-        *settings.skippedFaceCount = int( borderTris.count() );
-    if ( settings.region )
-        *settings.region = std::move( borderTris );
+
+    if ( settings.region || settings.skippedFaceCount )
+    {
+        deferred |= bad;
+        if ( settings.skippedFaceCount )
+            *settings.skippedFaceCount = (int)deferred.count();
+        if ( settings.region )
+            *settings.region = std::move( deferred );
+    }
     return res;
 }
 
@@ -529,7 +749,7 @@ MeshTopology fromTriangles( const Triangulation & t, const BuildSettings & setti
     {
         try
         {
-            return fromTrianglesPar( t, settings, progressCb );
+            return fromTrianglesByFans( t, settings, progressCb );
         }
         catch ( const std::bad_alloc & )
         {
@@ -1,5 +1,6 @@
 #include "MRMeshCollide.h"
 #include "MRAABBTree.h"
+#include "MRCollisionTriangle.h"
 #include "MRMesh.h"
 #include "MRParallelFor.h"
 #include "MRTriangleIntersection.h"
@@ -81,6 +82,12 @@ std::vector<FaceFace> findCollidingTriangles( const MeshPart & a, const MeshPart
         }
     }
 
+    // if both meshes have precomputed collision data, then use it to skip topology access and reject most pairs early
+    const auto * aTris = a.mesh.getCollisionTrianglesNotCreate();
+    const auto * bTris = b.mesh.getCollisionTrianglesNotCreate();
+    if ( !aTris || !bTris )
+        aTris = bTris = nullptr;
+
     std::atomic<int> firstIntersection{ (int)res.size() };
     ParallelFor( res, [&] ( size_t i )
     {
@@ -88,13 +95,31 @@ std::vector<FaceFace> findCollidingTriangles( const MeshPart & a, const MeshPart
         if ( firstIntersectionOnly && knownIntersection < i )
             return;
         Vector3f av[3], bv[3];
-        a.mesh.getTriPoints( res[i].aFace, av[0], av[1], av[2] );
-        b.mesh.getTriPoints( res[i].bFace, bv[0], bv[1], bv[2] );
-        if ( rigidB2A )
+        if ( aTris )
         {
-            bv[0] = (*rigidB2A)( bv[0] );
-            bv[1] = (*rigidB2A)( bv[1] );
-            bv[2] = (*rigidB2A)( bv[2] );
+            const auto & at = (*aTris)[res[i].aFace];
+            const auto bt = rigidB2A ? transformed( (*bTris)[res[i].bFace], *rigidB2A ) : (*bTris)[res[i].bFace];
+            if ( !mayTrianglesCollide( at, bt ) )
+            {
+                res[i].aFace = FaceId{}; //invalidate
+                return;
+            }
+            for ( int j = 0; j < 3; ++j )
+            {
+                av[j] = at.p[j];
+                bv[j] = bt.p[j];
+            }
+        }
+        else
+        {
+            a.mesh.getTriPoints( res[i].aFace, av[0], av[1], av[2] );
+            b.mesh.getTriPoints( res[i].bFace, bv[0], bv[1], bv[2] );
+            if ( rigidB2A )
+            {
+                bv[0] = (*rigidB2A)( bv[0] );
+                bv[1] = (*rigidB2A)( bv[1] );
+                bv[2] = (*rigidB2A)( bv[2] );
+            }
         }
         if ( doTrianglesIntersect( Vector3d{ av[0] }, Vector3d{ av[1] }, Vector3d{ av[2] }, Vector3d{ bv[0] }, Vector3d{ bv[1] }, Vector3d{ bv[2] } ) )
         {
@@ -198,6 +223,9 @@ Expected<bool> findSelfCollidingTriangles(
 
     std::vector<std::vector<FaceFace>> subtaskRes( subtasks.size() );
 
+    // triangles separated by the plane of one of them can share neither a vertex nor a point, so they are rejected before topology access
+    const auto * collTris = mp.mesh.getCollisionTrianglesNotCreate();
+
     auto mainThreadId = std::this_thread::get_id();
     std::atomic<bool> keepGoing{ true };
     std::atomic<size_t> numDone;
@@ -214,7 +242,7 @@ Expected<bool> findSelfCollidingTriangles(
             mySubtasks.push_back( subtasks[is] );
             std::vector<FaceFace> myRes;
             processSelfSubtasks( tree, mySubtasks, mySubtasks,
-                [&tree, &mp, &myRes, regionMap, outCollidingPairs, &keepGoing, touchIsIntersection]( const NodeNode & s )
+                [&tree, &mp, &myRes, regionMap, collTris, outCollidingPairs, &keepGoing, touchIsIntersection]( const NodeNode & s )
                 {
                     const auto & aNode = tree[s.aNode];
                     const auto & bNode = tree[s.bNode];
@@ -226,6 +254,8 @@ Expected<bool> findSelfCollidingTriangles(
                         return Processing::Continue;
                     if ( regionMap && ( *regionMap )[aFace] != ( *regionMap )[bFace] )
                         return Processing::Continue;
+                    if ( collTris && !mayTrianglesCollide( ( *collTris )[aFace], ( *collTris )[bFace] ) )
+                        return Processing::Continue;
 
                     VertId av[3], bv[3];
                     Triangle3d ap, bp;
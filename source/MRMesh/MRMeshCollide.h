@@ -15,6 +15,7 @@ namespace MR
  * \brief finds all pairs of colliding triangles from two meshes or two mesh regions
  * \param rigidB2A rigid transformation from B-mesh space to A mesh space, nullptr considered as identity transformation
  * \param firstIntersectionOnly if true then the function returns at most one pair of intersecting triangles and returns faster
+ * \details if both meshes have already created Mesh::getCollisionTriangles(), then they are used to reject most candidate pairs faster
  */
 [[nodiscard]] MRMESH_API std::vector<FaceFace> findCollidingTriangles( const MeshPart & a, const MeshPart & b, 
     const AffineXf3f * rigidB2A = nullptr, bool firstIntersectionOnly = false );
@@ -23,7 +24,8 @@ namespace MR
 [[nodiscard]] MRMESH_API std::pair<FaceBitSet, FaceBitSet> findCollidingTriangleBitsets( const MeshPart& a, const MeshPart& b,
     const AffineXf3f* rigidB2A = nullptr );
 
-/// finds all pairs (or the fact of any self-collision) of colliding triangles from one mesh or a region
+/// finds all pairs (or the fact of any self-collision) of colliding triangles from one mesh or a region;
+/// if the mesh has already created Mesh::getCollisionTriangles(), then they are used to reject most candidate pairs faster
 [[nodiscard]] MRMESH_API Expected<bool> findSelfCollidingTriangles( const MeshPart& mp,
     std::vector<FaceFace>* outCollidingPairs, ///< if nullptr then the algorithm returns with true as soon as first collision is found
     ProgressCallback cb = {},
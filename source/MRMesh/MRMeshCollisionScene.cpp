@@ -0,0 +1,198 @@
+#include "MRMeshCollisionScene.h"
+#include "MRMesh.h"
+#include "MRMeshCollide.h"
+#include "MRMeshContinuousCollide.h"
+#include "MRMeshMeshDistance.h"
+#include "MRHeapBytes.h"
+#include "MRParallelFor.h"
+#include "MRTimer.h"
+
+namespace MR
+{
+
+ObjId MeshCollisionScene::add( const MeshPart & mp, const AffineXf3f & xf )
+{
+    const ObjId id( objects_.size() );
+    auto & obj = objects_.emplace_back();
+    obj.mesh = &mp.mesh;
+    obj.region = mp.region;
+    obj.xf = xf;
+    obj.localBox = mp.mesh.computeBoundingBox( mp.region );
+    obj.dirty = true;
+    anyDirty_ = true;
+    ++numObjects_;
+    if ( !rebuildSorted_ && obj.localBox.valid() )
+        sorted_.push_back( id ); // will be moved in its place by the next sorting
+    return id;
+}
+
+void MeshCollisionScene::remove( ObjId id )
+{
+    assert( contains( id ) );
+    objects_[id] = {};
+    --numObjects_;
+    if ( !rebuildSorted_ )
+        std::erase( sorted_, id );
+}
+
+void MeshCollisionScene::setXf( ObjId id, const AffineXf3f & xf )
+{
+    assert( contains( id ) );
+    auto & obj = objects_[id];
+    obj.xf = xf;
+    obj.dirty = true;
+    anyDirty_ = true;
+}
+
+void MeshCollisionScene::invalidateMesh( ObjId id )
+{
+    assert( contains( id ) );
+    auto & obj = objects_[id];
+    const bool wasValid = obj.localBox.valid();
+    obj.localBox = obj.mesh->computeBoundingBox( obj.region );
+    obj.dirty = true;
+    anyDirty_ = true;
+    if ( wasValid != obj.localBox.valid() )
+        rebuildSorted_ = true;
+}
+
+void MeshCollisionScene::updateBoxes_()
+{
+    if ( !anyDirty_ )
+        return;
+    MR_TIMER;
+    ParallelFor( objects_, [&] ( ObjId id )
+    {
+        auto & obj = objects_[id];
+        if ( !obj.dirty )
+            return;
+        obj.worldBox = obj.mesh ? transformed( obj.localBox, obj.xf ) : Box3f{};
+        obj.dirty = false;
+    } );
+    anyDirty_ = false;
+}
+
+void MeshCollisionScene::sortObjects_()
+{
+    MR_TIMER;
+    // sort along the axis with the largest spread of box centers to have fewer overlaps of the projections
+    Vector3d sum, sumSq;
+    size_t num = 0;
+    for ( const auto & obj : objects_ )
+    {
+        if ( !obj.worldBox.valid() )
+            continue;
+        const Vector3d c( obj.worldBox.center() );
+        sum += c;
+        sumSq += mult( c, c );
+        ++num;
+    }
+    int axis = sortAxis_;
+    if ( num > 0 )
+    {
+        const auto var = sumSq / double( num ) - mult( sum, sum ) / sqr( double( num ) );
+        const int maxAxis = var.x >= var.y ? ( var.x >= var.z ? 0 : 2 ) : ( var.y >= var.z ? 1 : 2 );
+        // switch the axis only if it is significantly better to avoid full resorting on small movements
+        if ( var[maxAxis] > 2 * var[sortAxis_] )
+            axis = maxAxis;
+    }
+
+    auto less = [&] ( ObjId a, ObjId b )
+    {
+        return objects_[a].worldBox.min[axis] < objects_[b].worldBox.min[axis];
+    };
+
+    if ( rebuildSorted_ || axis != sortAxis_ )
+    {
+        sortAxis_ = axis;
+        sorted_.clear();
+        for ( ObjId id( 0 ); id < objects_.size(); ++id )
+            if ( objects_[id].worldBox.valid() )
+                sorted_.push_back( id );
+        std::sort( sorted_.begin(), sorted_.end(), less );
+        rebuildSorted_ = false;
+        return;
+    }
+
+    // insertion sort is linear for almost sorted sequence, which is typical after small movements of some objects
+    for ( size_t i = 1; i < sorted_.size(); ++i )
+    {
+        const auto id = sorted_[i];
+        size_t j = i;
+        for ( ; j > 0 && less( id, sorted_[j - 1] ); --j )
+            sorted_[j] = sorted_[j - 1];
+        sorted_[j] = id;
+    }
+}
+
+std::vector<std::pair<ObjId, ObjId>> MeshCollisionScene::findPotentiallyCollidingPairs( float minDistance )
+{
+    MR_TIMER;
+    updateBoxes_();
+    sortObjects_();
+
+    std::vector<std::pair<ObjId, ObjId>> res;
+    const float minDistSq = sqr( minDistance );
+    for ( size_t i = 0; i < sorted_.size(); ++i )
+    {
+        const auto & iBox = objects_[sorted_[i]].worldBox;
+        const float maxCoord = iBox.max[sortAxis_] + minDistance;
+        for ( size_t j = i + 1; j < sorted_.size(); ++j )
+        {
+            const auto & jBox = objects_[sorted_[j]].worldBox;
+            if ( jBox.min[sortAxis_] > maxCoord )
+                break; // all next objects are even farther along the axis
+            if ( minDistance > 0 ? iBox.getDistanceSq( jBox ) < minDistSq : iBox.intersects( jBox ) )
+                res.emplace_back( std::minmax( sorted_[i], sorted_[j] ) );
+        }
+    }
+    std::sort( res.begin(), res.end() );
+    return res;
+}
+
+Expected<std::vector<ObjectCollision>> MeshCollisionScene::findCollisions( const MeshCollisionSceneParams & params )
+{
+    MR_TIMER;
+    const auto pairs = findPotentiallyCollidingPairs( params.minDistance );
+
+    std::vector<ObjectCollision> res( pairs.size() );
+    const float minDistSq = sqr( params.minDistance );
+    const bool ok = ParallelFor( size_t( 0 ), pairs.size(), [&] ( size_t i )
+    {
+        const auto & a = objects_[pairs[i].first];
+        const auto & b = objects_[pairs[i].second];
+        const MeshPart aPart( *a.mesh, a.region );
+        const MeshPart bPart( *b.mesh, b.region );
+        const auto b2a = a.xf.inverse() * b.xf;
+
+        auto & r = res[i];
+        r.a = pairs[i].first;
+        r.b = pairs[i].second;
+        if ( params.minDistance > 0 )
+        {
+            if ( params.firstFacePairOnly )
+            {
+                const auto d = findDistance( aPart, bPart, &b2a, minDistSq );
+                if ( d.a.face )
+                    r.facePairs.emplace_back( d.a.face, d.b.face );
+            }
+            else
+                r.facePairs = findCloseTriangles( aPart, bPart, &b2a, minDistSq );
+        }
+        else
+            r.facePairs = findCollidingTriangles( aPart, bPart, &b2a, params.firstFacePairOnly );
+    }, params.cb, 1 );
+
+    if ( !ok )
+        return unexpectedOperationCanceled();
+
+    std::erase_if( res, [] ( const ObjectCollision & c ) { return c.facePairs.empty(); } );
+    return res;
+}
+
+size_t MeshCollisionScene::heapBytes() const
+{
+    return objects_.heapBytes() + MR::heapBytes( sorted_ );
+}
+
+} // namespace MR
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "MRFaceFace.h"
+#include "MRMeshPart.h"
+#include "MRAffineXf3.h"
+#include "MRBox.h"
+#include "MRVector.h"
+#include "MRProgressCallback.h"
+#include "MRExpected.h"
+
+namespace MR
+{
+
+/// \addtogroup AABBTreeGroup
+/// \{
+
+/// two objects of MeshCollisionScene that collide or are too close to one another
+struct ObjectCollision
+{
+    ObjId a, b; ///< a < b
+    /// pairs of triangles from object a and b respectively, which collide or are too close to one another
+    std::vector<FaceFace> facePairs;
+};
+
+struct MeshCollisionSceneParams
+{
+    /// if positive then the objects with the distance smaller than this are reported as well,
+    /// together with the pairs of triangles closer than this distance
+    float minDistance = 0;
+
+    /// if true then at most one pair of triangles is returned for each pair of colliding objects, which is faster
+    bool firstFacePairOnly = false;
+
+    /// to report progress and cancel narrow phase
+    ProgressCallback cb;
+};
+
+/// finds collisions among many meshes, each with its own rigid transformation:
+/// broad phase sorts the world bounding boxes of objects along one axis (sweep-and-prune),
+/// and the sorting is updated incrementally after only some objects have been moved;
+/// narrow phase checks the pairs with overlapping boxes in parallel using the AABB trees of meshes
+class MeshCollisionScene
+{
+public:
+    /// adds new object in the scene and returns its identifier;
+    /// the mesh (and the region) must remain alive and unchanged while the object is in the scene
+    MRMESH_API ObjId add( const MeshPart & mp, const AffineXf3f & xf = {} );
+
+    /// removes given object from the scene, its identifier is not reused
+    MRMESH_API void remove( ObjId id );
+
+    /// changes the transformation from local to world space of given object
+    MRMESH_API void setXf( ObjId id, const AffineXf3f & xf );
+
+    /// returns the transformation from local to world space of given object
+    [[nodiscard]] const AffineXf3f & xf( ObjId id ) const { return objects_[id].xf; }
+
+    /// the mesh of given object was modified in place, so its bounding box shall be recomputed
+    MRMESH_API void invalidateMesh( ObjId id );
+
+    /// returns true if given object is present in the scene
+    [[nodiscard]] bool contains( ObjId id ) const { return id && id < objects_.size() && objects_[id].mesh; }
+
+    /// returns the number of objects in the scene
+    [[nodiscard]] size_t size() const { return numObjects_; }
+
+    /// broad phase: returns all pairs of objects with world bounding boxes closer than minDistance, a < b in each pair
+    [[nodiscard]] MRMESH_API std::vector<std::pair<ObjId, ObjId>> findPotentiallyCollidingPairs( float minDistance = 0 );
+
+    /// broad and narrow phases: returns all pairs of objects that collide (or closer than params.minDistance),
+    /// each object pair is checked in parallel
+    [[nodiscard]] MRMESH_API Expected<std::vector<ObjectCollision>> findCollisions( const MeshCollisionSceneParams & params = {} );
+
+    /// returns the amount of memory this object occupies on heap
+    [[nodiscard]] MRMESH_API size_t heapBytes() const;
+
+private:
+    void updateBoxes_();
+    void sortObjects_();
+
+    struct Object
+    {
+        const Mesh * mesh = nullptr;
+        const FaceBitSet * region = nullptr;
+        AffineXf3f xf;
+        Box3f localBox;
+        Box3f worldBox;
+        bool dirty = true;
+    };
+    Vector<Object, ObjId> objects_;
+    size_t numObjects_ = 0;
+
+    /// valid objects sorted by worldBox.min[sortAxis_]
+    std::vector<ObjId> sorted_;
+    int sortAxis_ = 0;
+    /// sorted_ shall be rebuilt from scratch (e.g. after objects removal)
+    bool rebuildSorted_ = true;
+    /// some objects are dirty
+    bool anyDirty_ = false;
+};
+
+/// \}
+
+} // namespace MR
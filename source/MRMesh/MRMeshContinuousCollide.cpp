@@ -0,0 +1,192 @@
+#include "MRMeshContinuousCollide.h"
+#include "MRAABBTree.h"
+#include "MRBox.h"
+#include "MRMesh.h"
+#include "MRMeshMeshDistance.h"
+#include "MRParallelFor.h"
+#include "MRQuaternion.h"
+#include "MRTimer.h"
+#include "MRTriDist.h"
+
+namespace MR
+{
+
+namespace
+{
+
+/// returns an upper bound on the distance traveled by any point within given radius from center
+/// during interpolation between two poses (in units of segment time)
+float motionBound( const AffineXf3f & xf0, const AffineXf3f & xf1, const Vector3f & center, float radius )
+{
+    const auto q0 = Quaternionf( xf0.A ).normalized();
+    const auto q1 = Quaternionf( xf1.A ).normalized();
+    // slerp takes the shortest path, so the rotation angle is computed from the absolute value of the dot product
+    const float angle = 2 * std::acos( std::clamp( std::abs( dot( q0, q1 ) ), 0.0f, 1.0f ) );
+    const float linear = ( xf1( center ) - xf0( center ) ).length();
+    // small relative margin covers rounding errors in slerp
+    return 1.001f * ( linear + angle * radius );
+}
+
+} // anonymous namespace
+
+AffineXf3f interpolateRigidMotion( const std::vector<AffineXf3f> & b2aPoses, double t, const Vector3f & center )
+{
+    if ( b2aPoses.empty() )
+    {
+        assert( false );
+        return {};
+    }
+    if ( b2aPoses.size() == 1 || t <= 0 )
+        return b2aPoses.front();
+    const auto numSegments = b2aPoses.size() - 1;
+    if ( t >= double( numSegments ) )
+        return b2aPoses.back();
+    const auto i = size_t( t );
+    const auto s = float( t - double( i ) );
+    if ( s <= 0 )
+        return b2aPoses[i];
+    return Quaternionf::slerp( b2aPoses[i], b2aPoses[i + 1], s, center );
+}
+
+std::vector<FaceFace> findCloseTriangles( const MeshPart & a, const MeshPart & b, const AffineXf3f * rigidB2A, float maxDistSq )
+{
+    MR_TIMER;
+
+    std::vector<FaceFace> res;
+    const AABBTree & aTree = a.mesh.getAABBTree();
+    const AABBTree & bTree = b.mesh.getAABBTree();
+    if ( aTree.nodes().empty() || bTree.nodes().empty() )
+        return res;
+
+    NodeBitSet aNodes, bNodes;
+    if ( a.region )
+        aNodes = aTree.getNodesFromLeaves( *a.region );
+    if ( b.region )
+        bNodes = bTree.getNodesFromLeaves( *b.region );
+
+    std::vector<NodeNode> subtasks{ { aTree.rootNodeId(), bTree.rootNodeId() } };
+    while ( !subtasks.empty() )
+    {
+        const auto s = subtasks.back();
+        subtasks.pop_back();
+
+        if ( a.region && !aNodes.test( s.aNode ) )
+            continue;
+        if ( b.region && !bNodes.test( s.bNode ) )
+            continue;
+
+        const auto & aNode = aTree[s.aNode];
+        const auto & bNode = bTree[s.bNode];
+        if ( aNode.box.getDistanceSq( transformed( bNode.box, rigidB2A ) ) > maxDistSq )
+            continue;
+
+        if ( aNode.leaf() && bNode.leaf() )
+        {
+            res.emplace_back( aNode.leafId(), bNode.leafId() );
+            continue;
+        }
+
+        if ( !aNode.leaf() && ( bNode.leaf() || aNode.box.volume() >= bNode.box.volume() ) )
+        {
+            // split aNode
+            subtasks.push_back( { aNode.l, s.bNode } );
+            subtasks.push_back( { aNode.r, s.bNode } );
+        }
+        else
+        {
+            assert( !bNode.leaf() );
+            // split bNode
+            subtasks.push_back( { s.aNode, bNode.l } );
+            subtasks.push_back( { s.aNode, bNode.r } );
+        }
+    }
+
+    ParallelFor( res, [&] ( size_t i )
+    {
+        Triangle3f av = a.mesh.getTriPoints( res[i].aFace );
+        Triangle3f bv = b.mesh.getTriPoints( res[i].bFace );
+        if ( rigidB2A )
+        {
+            for ( auto & p : bv )
+                p = ( *rigidB2A )( p );
+        }
+        if ( findTriTriDistance( av, bv, { .upDistLimitSq = maxDistSq } ).distSq > maxDistSq )
+            res[i].aFace = FaceId{}; //invalidate
+    } );
+
+    res.erase( std::remove_if( res.begin(), res.end(), []( const FaceFace & ff ) { return !ff.aFace.valid(); } ), res.end() );
+    return res;
+}
+
+Expected<ContinuousCollisionResult> findContinuousCollision( const MeshPart & a, const MeshPart & b,
+    const std::vector<AffineXf3f> & b2aPoses, const ContinuousCollisionParams & params )
+{
+    MR_TIMER;
+
+    ContinuousCollisionResult res;
+    if ( b2aPoses.empty() )
+        return res;
+
+    const auto aBox = a.mesh.computeBoundingBox( a.region );
+    const auto bBox = b.mesh.computeBoundingBox( b.region );
+    if ( !aBox.valid() || !bBox.valid() )
+        return res;
+
+    const float tol = params.tolerance > 0 ? params.tolerance : 1e-5f * ( aBox.diagonal() + bBox.diagonal() );
+    const float tolSq = sqr( tol );
+    const auto center = bBox.center();
+    const float radius = 0.5f * bBox.diagonal();
+
+    auto setContact = [&] ( double time, const AffineXf3f & xf, float distSq )
+    {
+        res.timeOfImpact = time;
+        res.b2aAtImpact = xf;
+        res.contactPairs = findCloseTriangles( a, b, &xf, std::max( tolSq, distSq ) );
+    };
+
+    if ( b2aPoses.size() == 1 )
+    {
+        const auto d = findDistance( a, b, &b2aPoses.front(), tolSq );
+        if ( d.a.face )
+            setContact( 0, b2aPoses.front(), d.distSq );
+        return res;
+    }
+
+    const auto numSegments = b2aPoses.size() - 1;
+    for ( size_t i = 0; i < numSegments; ++i )
+    {
+        const auto & xf0 = b2aPoses[i];
+        const auto & xf1 = b2aPoses[i + 1];
+        const float speed = motionBound( xf0, xf1, center, radius );
+
+        float t = 0;
+        for ( int it = 0; ; ++it )
+        {
+            const auto xf = t <= 0 ? xf0 : t >= 1 ? xf1 : Quaternionf::slerp( xf0, xf1, t, center );
+            // the meshes cannot come closer than tolerance till the segment's end if they are farther than this now
+            const float travel = speed * ( 1 - t );
+            const auto d = findDistance( a, b, &xf, sqr( travel + tol ) );
+            if ( !d.a.face )
+                break; // no contact on this segment
+
+            if ( d.distSq <= tolSq || it >= params.maxIterationsPerSegment )
+            {
+                setContact( double( i ) + t, xf, d.distSq );
+                return res;
+            }
+
+            if ( t >= 1 )
+                break; // contact is possible only on the next segment
+
+            // no point of B can travel farther than the current distance during this time step
+            t = std::min( 1.0f, t + std::sqrt( d.distSq ) / speed );
+        }
+
+        if ( !reportProgress( params.cb, float( i + 1 ) / numSegments ) )
+            return unexpectedOperationCanceled();
+    }
+
+    return res;
+}
+
+} // namespace MR
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "MRFaceFace.h"
+#include "MRMeshPart.h"
+#include "MRAffineXf3.h"
+#include "MRProgressCallback.h"
+#include "MRExpected.h"
+
+namespace MR
+{
+
+/// \addtogroup AABBTreeGroup
+/// \{
+
+struct ContinuousCollisionParams
+{
+    /// the meshes are considered in contact as soon as the distance between them becomes not larger than this value;
+    /// if not positive then it is selected automatically as 1e-5 of the sum of mesh bounding box diagonals
+    float tolerance = 0;
+
+    /// the maximal number of advancement steps on one motion segment,
+    /// after which the contact is reported conservatively at the current time even if the distance is still larger than tolerance
+    int maxIterationsPerSegment = 1000;
+
+    /// to report progress (after each motion segment) and cancel the computation
+    ProgressCallback cb;
+};
+
+struct ContinuousCollisionResult
+{
+    /// time of the first contact in [0, numPoses-1]: the integer part is the index of motion segment,
+    /// and the fractional part is the position on it; negative if the meshes do not come in contact during the whole motion
+    double timeOfImpact = -1;
+
+    /// rigid transformation from B-mesh space to A-mesh space at the time of impact
+    AffineXf3f b2aAtImpact;
+
+    /// all pairs of triangles (from A and B respectively) with the distance not larger than the tolerance at the time of impact
+    std::vector<FaceFace> contactPairs;
+
+    [[nodiscard]] bool collided() const { return timeOfImpact >= 0; }
+};
+
+/// returns rigid transformation from B-mesh space to A-mesh space at given time t in [0, b2aPoses.size()-1]:
+/// each pair of consecutive poses is interpolated by Quaternion::slerp, so that the point center moves along straight line
+[[nodiscard]] MRMESH_API AffineXf3f interpolateRigidMotion( const std::vector<AffineXf3f> & b2aPoses, double t, const Vector3f & center );
+
+/**
+ * \brief finds the first moment when moving mesh part B comes in contact with mesh part A,
+ *        and all pairs of triangles in contact at that moment
+ * \details the motion is given by a sequence of rigid transformations from B-mesh space to A-mesh space,
+ *          which are interpolated by \ref interpolateRigidMotion with the center of B bounding box;
+ *          conservative advancement is performed on each segment: the current distance between the meshes is found
+ *          by \ref findDistance with the upper limit equal to the maximal travel till the segment's end,
+ *          and the time is advanced by the distance divided by the bound on the speed of B's points;
+ *          so no contact can be skipped however thin the meshes are;
+ *          if both meshes move, then pass here the poses of B relative to A: inverse(aXf[i]) * bXf[i]
+ */
+[[nodiscard]] MRMESH_API Expected<ContinuousCollisionResult> findContinuousCollision( const MeshPart & a, const MeshPart & b,
+    const std::vector<AffineXf3f> & b2aPoses, const ContinuousCollisionParams & params = {} );
+
+/**
+ * \brief finds all pairs of triangles from two meshes or two mesh regions with the distance between them not larger than sqrt(maxDistSq)
+ * \param rigidB2A rigid transformation from B-mesh space to A mesh space, nullptr considered as identity transformation
+ */
+[[nodiscard]] MRMESH_API std::vector<FaceFace> findCloseTriangles( const MeshPart & a, const MeshPart & b,
+    const AffineXf3f * rigidB2A, float maxDistSq );
+
+/// \}
+
+} // namespace MR
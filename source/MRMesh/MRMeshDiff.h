@@ -30,6 +30,12 @@ public:
     /// returns the amount of memory this object occupies on heap
     [[nodiscard]] size_t heapBytes() const { return pointsDiff_.heapBytes() + topologyDiff_.heapBytes(); }
 
+    /// saves in binary stream
+    void write( std::ostream & s ) const { pointsDiff_.write( s ); topologyDiff_.write( s ); }
+
+    /// loads from binary stream
+    Expected<void> read( std::istream & s ) { return pointsDiff_.read( s ).and_then( [&] { return topologyDiff_.read( s ); } ); }
+
 private:
     VertCoordsDiff pointsDiff_;
     MeshTopologyDiff topologyDiff_;
@@ -933,6 +933,115 @@ bool isHoleBd( const MeshTopology & topology, const EdgeLoop & loop )
     return n == loop.size();
 }
 
+namespace
+{
+
+unsigned holeEdgeCount( const MeshTopology & topology, EdgeId a0 )
+{
+    unsigned res = 0;
+    EdgeId a = a0;
+    do
+    {
+        a = topology.prev( a.sym() );
+        ++res;
+    } while ( a != a0 );
+    return res;
+}
+
+/// closes the hole of two edges by merging them
+void foldTwoEdgeHole( MeshTopology & topology, EdgeId a0 )
+{
+    EdgeId a1 = topology.next( a0 );
+    EdgeId a2 = topology.prev( a1.sym() );
+    topology.splice( a0, a1 );
+    topology.splice( a2, a1.sym() );
+    assert( topology.isLoneEdge( a1 ) );
+}
+
+/// splits the hole to the left of a0 by chords until every part has at most maxSize edges,
+/// each chord connects the closest pair of sampled vertices from approximately opposite halves of the boundary,
+/// which is not connected by an edge yet;
+/// representative edges of all parts are appended in outParts
+void splitLongHole( Mesh & mesh, EdgeId a0, unsigned maxSize, std::vector<EdgeId> & outParts )
+{
+    MR_TIMER;
+    maxSize = std::max( maxSize, 8u );
+    std::vector<EdgeId> toSplit{ a0 };
+    std::vector<EdgeId> loop;
+    struct Chord
+    {
+        float distSq = 0;
+        int i = 0, j = 0;
+    };
+    std::vector<Chord> candidates;
+    while ( !toSplit.empty() )
+    {
+        const auto e0 = toSplit.back();
+        toSplit.pop_back();
+
+        loop.clear();
+        EdgeId e = e0;
+        do
+        {
+            loop.push_back( e );
+            e = mesh.topology.prev( e.sym() );
+        } while ( e != e0 );
+
+        const int n = int( loop.size() );
+        if ( n <= int( maxSize ) )
+        {
+            outParts.push_back( e0 );
+            continue;
+        }
+
+        // both parts will have at least n/4 > 2 edges
+        const int step = std::max( 1, n / 64 );
+        const int window = n / 4;
+        candidates.clear();
+        for ( int i = 0; i < n; i += step )
+        {
+            const auto pi = mesh.orgPnt( loop[i] );
+            for ( int d = -window; d <= window; d += step )
+            {
+                const int j = ( i + n / 2 + d ) % n;
+                candidates.push_back( { ( mesh.orgPnt( loop[j] ) - pi ).lengthSq(), i, j } );
+            }
+        }
+        std::stable_sort( candidates.begin(), candidates.end(), [] ( const Chord & a, const Chord & b ) { return a.distSq < b.distSq; } );
+
+        // the closest chords can already be present as edges outside of the hole, so try the next ones
+        EdgeId bridge;
+        for ( const auto & c : candidates )
+            if ( ( bridge = makeBridgeEdge( mesh.topology, loop[c.i], loop[c.j] ) ) )
+                break;
+        if ( !bridge )
+        {
+            // cannot split without multiple edges, so fill the part exactly
+            outParts.push_back( e0 );
+            continue;
+        }
+        toSplit.push_back( bridge );
+        toSplit.push_back( bridge.sym() );
+    }
+}
+
+/// prepares fill plans for all given holes in parallel and executes them sequentially
+void fillHolesByPlans( Mesh & mesh, const std::vector<EdgeId> & holes, const FillHoleParams & params )
+{
+    auto plans = getHoleFillPlans( mesh, holes, params );
+    for ( size_t i = 0; i < holes.size(); ++i )
+    {
+        if ( mesh.topology.left( holes[i] ) )
+            continue; // the same hole was given twice
+        if ( params.multipleEdgesResolveMode != FillHoleParams::MultipleEdgesResolveMode::None &&
+            !isFillingMultipleEdgeFree( mesh.topology, plans[i] ) )
+            plans[i] = getHoleFillPlan( mesh, holes[i], params ); // the plan was made before filling of neighbor holes
+        executeHoleFillPlan( mesh, holes[i], plans[i], params.outNewFaces );
+    }
+}
+
+} // anonymous namespace
+
 void fillHole( Mesh& mesh, EdgeId a0, const FillHoleParams& params )
 {
     MR_TIMER;
@@ -941,13 +1050,8 @@ void fillHole( Mesh& mesh, EdgeId a0, const FillHoleParams& params )
     if ( mesh.topology.left( a0 ) )
         return;
 
-    unsigned loopEdgesCounter = 0;
+    unsigned loopEdgesCounter = holeEdgeCount( mesh.topology, a0 );
     EdgeId a = a0;
-    do
-    {
-        a = mesh.topology.prev( a.sym() );
-        ++loopEdgesCounter;
-    } while ( a != a0 );
 
     if ( loopEdgesCounter < 2 )
     {
@@ -965,11 +1069,15 @@ void fillHole( Mesh& mesh, EdgeId a0, const FillHoleParams& params )
 
     if ( loopEdgesCounter == 2 )
     {
-        EdgeId a1 = mesh.topology.next( a0 );
-        EdgeId a2 = mesh.topology.prev( a1.sym() );
-        mesh.topology.splice( a0, a1 );
-        mesh.topology.splice( a2, a1.sym() );
-        assert( mesh.topology.isLoneEdge( a1 ) );
+        foldTwoEdgeHole( mesh.topology, a0 );
+        return;
+    }
+
+    if ( params.maxExactHoleSize > 0 && loopEdgesCounter > unsigned( params.maxExactHoleSize ) && !params.stopBeforeBadTriangulation )
+    {
+        std::vector<EdgeId> parts;
+        splitLongHole( mesh, a0, params.maxExactHoleSize, parts );
+        fillHolesByPlans( mesh, parts, params );
         return;
     }
 
@@ -983,11 +1091,38 @@ void fillHole( Mesh& mesh, EdgeId a0, const FillHoleParams& params )
 void fillHoles( Mesh& mesh, const std::vector<EdgeId> & as, const FillHoleParams& params )
 {
     MR_TIMER;
+    if ( params.makeDegenerateBand || params.stopBeforeBadTriangulation )
+    {
+        // these modes change the mesh before planning or report the result per hole
+        for ( auto a : as )
+            fillHole( mesh, a, params );
+        return;
+    }
+    MR_WRITER( mesh );
 
-    // TODO: parallel getHoleFillPlan
-
+    // trivial and long holes are processed sequentially here, and all other holes are filled by plans prepared in parallel
+    std::vector<EdgeId> holes;
+    holes.reserve( as.size() );
     for ( auto a : as )
-        fillHole( mesh, a, params );
+    {
+        assert( !mesh.topology.left( a ) );
+        if ( mesh.topology.left( a ) )
+            continue;
+        const auto loopEdgesCounter = holeEdgeCount( mesh.topology, a );
+        if ( loopEdgesCounter < 2 )
+        {
+            // loop hole
+            assert( false );
+            continue;
+        }
+        if ( loopEdgesCounter == 2 )
+            foldTwoEdgeHole( mesh.topology, a );
+        else if ( params.maxExactHoleSize > 0 && loopEdgesCounter > unsigned( params.maxExactHoleSize ) )
+            splitLongHole( mesh, a, params.maxExactHoleSize, holes );
+        else
+            holes.push_back( a );
+    }
+    fillHolesByPlans( mesh, holes, params );
 }
 
 VertId fillHoleTrivially( Mesh& mesh, EdgeId a, FaceBitSet * outNewFaces /*= nullptr */ )
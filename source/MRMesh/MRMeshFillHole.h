@@ -66,6 +66,14 @@ struct FillHoleParams
       */
     int maxPolygonSubdivisions{ 20 };
 
+    /** If positive, then the holes having more edges are first split by chords connecting close vertices
+      * from opposite halves of the boundary, until each part has at most this number of edges (but not less than 8),
+      * and the parts are triangulated independently (in parallel);
+      * this is much faster than exact planning for very long holes, but the triangulation is only approximately optimal;
+      * ignored if stopBeforeBadTriangulation is present
+      */
+    int maxExactHoleSize{ 0 };
+
     /** Input/output value, if it is present: 
       * returns true if triangulation was bad and do not actually fill hole, 
       * if triangulation is ok returns false; 
@@ -149,7 +157,10 @@ MRMESH_API bool buildCylinderBetweenTwoHoles( Mesh & mesh, const StitchHolesPara
   */
 MRMESH_API void fillHole( Mesh& mesh, EdgeId a, const FillHoleParams& params = {} );
 
-/// fill all holes given by their representative edges in \param as
+/// fill all holes given by their representative edges in \param as;
+/// the plans of all holes are prepared in parallel and then executed sequentially,
+/// a plan is recomputed only if it introduces multiple edges after filling of previous holes;
+/// if params.makeDegenerateBand or params.stopBeforeBadTriangulation are set then the holes are filled one by one
 MRMESH_API void fillHoles( Mesh& mesh, const std::vector<EdgeId> & as, const FillHoleParams& params = {} );
 
 /// returns true if given loop is a boundary of one hole in given mesh topology:
@@ -516,6 +516,7 @@ using ThreeVertIds = std::array<VertId, 3>;
 using ThreeUVCoords = std::array<UVCoord, 3>;
 
 struct MRMESH_CLASS Dipole;
+struct MRMESH_CLASS CollisionTriangle;
 
 MR_CANONICAL_TYPEDEFS( (template <typename T, typename I> class MRMESH_CLASS), Vector,
     /// mapping from UndirectedEdgeId to its end vertices
@@ -529,6 +530,9 @@ MR_CANONICAL_TYPEDEFS( (template <typename T, typename I> class MRMESH_CLASS), V
 
     ( Dipoles,  Vector<Dipole, NodeId> )
 
+    /// mapping from FaceId to its vertices and plane packed for fast collision tests
+    ( CollisionTriangles,  Vector<CollisionTriangle, FaceId> )
+
     ( FaceMap,  Vector<FaceId, FaceId> )
     ( VertMap,  Vector<VertId, VertId> )
     ( EdgeMap,  Vector<EdgeId, EdgeId> )
@@ -630,6 +634,8 @@ struct MRMESH_CLASS PointCloudPart;
 class MRMESH_CLASS AABBTree;
 class MRMESH_CLASS AABBTreePoints;
 class MRMESH_CLASS AABBTreeObjects;
+class MRMESH_CLASS HeatGeodesics;
+class MRMESH_CLASS QuantizedVertCoords;
 struct MRMESH_CLASS CloudPartMapping;
 struct MRMESH_CLASS PartMapping;
 struct MeshOrPointsXf;
@@ -14,6 +14,7 @@
 #include "MRProgressReadWrite.h"
 #include "MRIOParsing.h"
 #include "MRMeshDelone.h"
+#include "MROrder.h"
 #include "MRPly.h"
 #include "MRTriMesh.h"
 #include "MRParallelFor.h"
@@ -824,6 +825,42 @@ void telemetryLogSize( const Mesh& mesh )
         TelemetrySignal( "Open Mesh Log Pnts " + std::to_string( logPoints ) );
 }
 
+/// the settings for the loader itself: if locality optimization is requested, then the loader reports only the first part of the progress
+static MeshLoadSettings settingsBeforeOptimization( const MeshLoadSettings& settings )
+{
+    if ( !settings.optimizeLocality )
+        return settings;
+    auto res = settings;
+    res.callback = subprogress( settings.callback, 0.0f, 0.8f );
+    return res;
+}
+
+/// reorders the elements of just loaded mesh and its per-element artifacts if it is requested in the settings
+static Expected<void> optimizeLocalityAfterLoading( Mesh& mesh, const MeshLoadSettings& settings )
+{
+    if ( !settings.optimizeLocality )
+        return {};
+    auto map = optimizeLocality( mesh, {}, subprogress( settings.callback, 0.8f, 1.0f ) );
+    if ( !map )
+        return unexpected( std::move( map.error() ) );
+    if ( settings.colors && !settings.colors->empty() )
+        *settings.colors = rearrangeVectorByMap( *settings.colors, map->v );
+    if ( settings.uvCoords && !settings.uvCoords->empty() )
+        *settings.uvCoords = rearrangeVectorByMap( *settings.uvCoords, map->v );
+    if ( settings.normals && !settings.normals->empty() )
+        *settings.normals = rearrangeVectorByMap( *settings.normals, map->v );
+    if ( settings.faceColors && !settings.faceColors->empty() )
+        *settings.faceColors = rearrangeVectorByMap( *settings.faceColors, map->f );
+    if ( settings.edges && *settings.edges )
+    {
+        // the vertices not referenced by any triangle are removed by packing, so the edges to them get invalid ends
+        for ( auto & e : **settings.edges )
+            for ( auto & v : e )
+                v = v < map->v.b.size() ? map->v.b[v] : VertId{};
+    }
+    return {};
+}
+
 static void telemetryOpenMesh( const std::string& ext, const Mesh& mesh, const MeshLoadSettings& settings )
 {
     if ( !settings.telemetrySignal )
@@ -880,7 +917,13 @@ Expected<Mesh> fromAnySupportedFormat( const std::filesystem::path& file, const
             std::ifstream in( file, std::ifstream::binary );
             if ( !in )
                 return unexpected( std::string( "Cannot open file for reading " ) + utf8string( file ) );
-            return addFileNameInError( loader.streamLoad( in, settings ), file );
+            auto res = loader.streamLoad( in, settingsBeforeOptimization( settings ) );
+            if ( res )
+            {
+                if ( auto r = optimizeLocalityAfterLoading( *res, settings ); !r )
+                    return unexpected( std::move( r.error() ) );
+            }
+            return addFileNameInError( std::move( res ), file );
         }
         // the error string must start with stringUnsupportedFileExtension()
         std::string err = fmt::format( "{} {} for mesh loading.", stringUnsupportedFileExtension(), ext );
@@ -889,9 +932,13 @@ Expected<Mesh> fromAnySupportedFormat( const std::filesystem::path& file, const
         return unexpected( err );
     }
 
-    auto res = loader.fileLoad( file, settings );
+    auto res = loader.fileLoad( file, settingsBeforeOptimization( settings ) );
     if ( res )
+    {
         telemetryOpenMesh( ext, *res, settings );
+        if ( auto r = optimizeLocalityAfterLoading( *res, settings ); !r )
+            return unexpected( std::move( r.error() ) );
+    }
     return res;
 }
 
@@ -913,9 +960,13 @@ Expected<Mesh> fromAnySupportedFormat( std::istream& in, const std::string& exte
         return unexpected( err );
     }
 
-    auto res = loader.streamLoad( in, settings );
+    auto res = loader.streamLoad( in, settingsBeforeOptimization( settings ) );
     if ( res )
+    {
         telemetryOpenMesh( ext, *res, settings );
+        if ( auto r = optimizeLocalityAfterLoading( *res, settings ); !r )
+            return unexpected( std::move( r.error() ) );
+    }
     return res;
 }
 
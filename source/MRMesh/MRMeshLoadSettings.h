@@ -20,6 +20,7 @@ struct MeshLoadSettings
     AffineXf3f* xf = nullptr;        ///< optional output: transform for the loaded mesh to improve precision of vertex coordinates
     ProgressCallback callback;       ///< callback for set progress and stop process
     bool telemetrySignal = true;     ///< permit telemetry signal about loading
+    bool optimizeLocality = false;   ///< reorder faces, vertices and edges (and all per-element load artifacts) for better memory locality after loading
 };
 
 } //namespace MR
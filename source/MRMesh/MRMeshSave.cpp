@@ -11,6 +11,7 @@
 #include "MRMeshTexture.h"
 #include "MRImageSave.h"
 #include "MRSerializer.h"
+#include <cstring>
 #include <fstream>
 
 namespace MR
@@ -267,27 +268,83 @@ Expected<void> toBinaryStl( const Mesh & mesh, const std::filesystem::path & fil
     return toBinaryStl( mesh, out, settings );
 }
 
+/// the number of triangles, faces or vertices formatted by one task of parallel writers
+constexpr size_t cWriteChunkSize = 16384;
+
+static size_t numWriteChunks( size_t numElements )
+{
+    return ( numElements + cWriteChunkSize - 1 ) / cWriteChunkSize;
+}
+
+template<typename T>
+static void appendBytes( std::vector<char> & buf, const T & t )
+{
+    const auto * p = ( const char* )&t;
+    buf.insert( buf.end(), p, p + sizeof( T ) );
+}
+
+/// the size of one triangle record in binary STL format
+constexpr size_t cStlTriSize = 50;
+
+/// writes 80-byte header of binary STL file preceding the number of triangles
+static void writeStlHeader( std::ostream & out )
+{
+    char header[80] = "MeshInspector.com";
+    out.write( header, 80 );
+}
+
+/// writes cStlTriSize bytes of given triangle record in binary STL format in (dst)
+static void formatStlTri( char * dst, const AffineXf3d * xf, const Triangle3f & tri )
+{
+    // perform normal computation in double-precision to get exactly the same single-precision result on all platforms
+    const Vector3d ad = applyDouble( xf, tri[0] );
+    const Vector3d bd = applyDouble( xf, tri[1] );
+    const Vector3d cd = applyDouble( xf, tri[2] );
+    const Vector3f normal( cross( bd - ad, cd - ad ).normalized() );
+    const Vector3f ap( ad );
+    const Vector3f bp( bd );
+    const Vector3f cp( cd );
+
+    std::memcpy( dst, &normal, 12 );
+    std::memcpy( dst + 12, &ap, 12 );
+    std::memcpy( dst + 24, &bp, 12 );
+    std::memcpy( dst + 36, &cp, 12 );
+    const std::uint16_t attr{ 0 };
+    std::memcpy( dst + 48, &attr, 2 );
+}
+
+static void appendStlTri( std::vector<char> & buf, const AffineXf3d * xf, const Triangle3f & tri )
+{
+    const auto pos = buf.size();
+    buf.resize( pos + cStlTriSize );
+    formatStlTri( buf.data() + pos, xf, tri );
+}
+
 Expected<void> toBinaryStl( const Mesh & mesh, std::ostream & out, const SaveSettings & settings )
 {
     MR_TIMER;
 
     auto notDegenTris = getNotDegenTris( mesh );
-    auto numTris = (std::uint32_t)notDegenTris.count();
-    BinaryStlSaver saver( out, settings, numTris );
+    const auto numTris = (std::uint32_t)notDegenTris.count();
+    writeStlHeader( out );
+    out.write( ( const char* )&numTris, 4 );
 
-    const float trisNum = float( numTris );
-    int trisIndex = 0;
-    for ( auto f : notDegenTris )
+    // triangles are formatted in parallel by chunks of face ids, and written in the order of ids
+    const size_t numFaces = notDegenTris.size();
+    if ( !writeChunksInParallel( out, numWriteChunks( numFaces ), [&]( size_t chunk, std::vector<char> & buf )
     {
-        saver.writeTri( mesh.getTriPoints( f ) );
-        if ( settings.progress && !( trisIndex & 0x3FF ) && !settings.progress( trisIndex / trisNum ) )
-            return unexpectedOperationCanceled();
-        ++trisIndex;
+        const FaceId fBeg( chunk * cWriteChunkSize );
+        const FaceId fEnd( std::min( numFaces, ( chunk + 1 ) * cWriteChunkSize ) );
+        for ( auto f = fBeg; f < fEnd; ++f )
+            if ( notDegenTris.test( f ) )
+                appendStlTri( buf, settings.xf, mesh.getTriPoints( f ) );
+    }, settings.progress ) )
+    {
+        if ( !out )
+            return unexpected( std::string( "Error saving in binary STL-format" ) );
+        return unexpectedOperationCanceled();
     }
 
-    if ( !saver.updateHeadCounter() )
-        return unexpected( std::string( "Error saving in binary STL-format" ) );
-
     reportProgress( settings.progress, 1.f );
     return {};
 }
@@ -296,8 +353,7 @@ BinaryStlSaver::BinaryStlSaver( std::ostream & out, const SaveSettings & setting
     : out_( out )
     , settings_( settings )
 {
-    char header[80] = "MeshInspector.com";
-    out.write( header, 80 );
+    writeStlHeader( out );
 
     numTrisPos_ = out.tellp();
     out.write( ( const char* )&expectedNumTris, 4 );
@@ -306,25 +362,26 @@ BinaryStlSaver::BinaryStlSaver( std::ostream & out, const SaveSettings & setting
 
 bool BinaryStlSaver::writeTri( const Triangle3f& tri )
 {
-    // perform normal computation in double-precision to get exactly the same single-precision result on all platforms
-    const Vector3d ad = applyDouble( settings_.xf, tri[0] );
-    const Vector3d bd = applyDouble( settings_.xf, tri[1] );
-    const Vector3d cd = applyDouble( settings_.xf, tri[2] );
-    const Vector3f normal( cross( bd - ad, cd - ad ).normalized() );
-    const Vector3f ap( ad );
-    const Vector3f bp( bd );
-    const Vector3f cp( cd );
-
-    out_.write( (const char*)&normal, 12 );
-    out_.write( (const char*)&ap, 12 );
-    out_.write( (const char*)&bp, 12 );
-    out_.write( (const char*)&cp, 12 );
-    std::uint16_t attr{ 0 };
-    out_.write( ( const char* )&attr, 2 );
+    char rec[cStlTriSize];
+    formatStlTri( rec, settings_.xf, tri );
+    out_.write( rec, cStlTriSize );
     ++savedNumTris_;
     return (bool)out_;
 }
 
+bool BinaryStlSaver::writeTris( const std::vector<Triangle3f>& tris )
+{
+    if ( !writeChunksInParallel( out_, numWriteChunks( tris.size() ), [&]( size_t chunk, std::vector<char> & buf )
+    {
+        const auto iEnd = std::min( tris.size(), ( chunk + 1 ) * cWriteChunkSize );
+        for ( auto i = chunk * cWriteChunkSize; i < iEnd; ++i )
+            appendStlTri( buf, settings_.xf, tris[i] );
+    } ) )
+        return false;
+    savedNumTris_ += (std::uint32_t)tris.size();
+    return true;
+}
+
 bool BinaryStlSaver::updateHeadCounter()
 {
     if ( savedNumTris_ != headNumTris_ )
@@ -496,67 +553,75 @@ static Expected<void> toPlyImpl( const MeshType & mesh, std::ostream & out, cons
     };
     static_assert( sizeof( PlyColor ) == 3, "check your padding" );
 
-    // write vertices
-    int numSaved = 0;
-    for ( VertId i{ 0 }; i <= lastVertId; ++i )
+    // write vertices, formatting them in parallel by chunks of vertex ids
+    const size_t numVertIds = size_t( lastVertId + 1 );
+    if ( !writeChunksInParallel( out, numWriteChunks( numVertIds ), [&]( size_t chunk, std::vector<char> & buf )
     {
-        if ( settings.onlyValidPoints && !hasVert( mesh, i ) )
-            continue;
-        const Vector3f p = applyFloat( settings.xf, mesh.points[i] );
-        out.write( ( const char* )&p, 12 );
-        if ( saveColors )
+        const VertId vBeg( chunk * cWriteChunkSize );
+        const VertId vEnd( std::min( numVertIds, ( chunk + 1 ) * cWriteChunkSize ) );
+        for ( auto i = vBeg; i < vEnd; ++i )
         {
-            const auto c = getAt( *settings.colors, i );
-            PlyColor pc{ .r = c.r, .g = c.g, .b = c.b };
-            out.write( ( const char* )&pc, 3 );
-        }
-        if ( saveUV && !settings.saveTriCornerUVCoords )
-        {
-            const auto uv = getAt( *settings.uvMap, i );
-            out.write( ( const char* )&uv, sizeof( UVCoord ) );
+            if ( settings.onlyValidPoints && !hasVert( mesh, i ) )
+                continue;
+            appendBytes( buf, applyFloat( settings.xf, mesh.points[i] ) );
+            if ( saveColors )
+            {
+                const auto c = getAt( *settings.colors, i );
+                appendBytes( buf, PlyColor{ .r = c.r, .g = c.g, .b = c.b } );
+            }
+            if ( saveUV && !settings.saveTriCornerUVCoords )
+                appendBytes( buf, getAt( *settings.uvMap, i ) );
         }
-        ++numSaved;
-        if ( settings.progress && !( numSaved & 0x3FF ) && !settings.progress( float( numSaved ) / numPoints * 0.5f ) )
-            return unexpectedOperationCanceled();
+    }, subprogress( settings.progress, 0.0f, 0.5f ) ) )
+    {
+        if ( !out )
+            return unexpected( std::string( "Error saving in PLY-format" ) );
+        return unexpectedOperationCanceled();
     }
 
-    // write triangles
-    Vector3i tri;
-    int savedFaces = 0;
-    for ( FaceId f{0}; f <= fLast; ++f )
+    // write triangles, formatting them in parallel by chunks of face ids
+    const size_t numFaceIds = size_t( fLast + 1 );
+    if ( !writeChunksInParallel( out, numWriteChunks( numFaceIds ), [&]( size_t chunk, std::vector<char> & buf )
     {
-        ThreeVertIds vs;
-        if ( hasFace( mesh, f ) )
-        {
-            vs = getTriVerts( mesh, f );
-            for ( int i = 0; i < 3; ++i )
-                tri[i] = vertRenumber( vs[i] );
-        }
-        else if ( !settings.packPrimitives )
-            tri[0] = tri[1] = tri[2] = 0;
-        else
-            continue;
-        out.put( char( 3 ) );
-        static_assert( sizeof( Vector3i ) == 12 );
-        out.write( (const char *)&tri, sizeof( Vector3i ) );
-        if ( saveFaceColors )
-        {
-            const auto c = getAt( *settings.primitiveColors, f );
-            PlyColor pc{ .r = c.r, .g = c.g, .b = c.b };
-            out.write( ( const char* )&pc, 3 );
-        }
-        if ( saveUV && settings.saveTriCornerUVCoords )
+        const FaceId fBeg( chunk * cWriteChunkSize );
+        const FaceId fEnd( std::min( numFaceIds, ( chunk + 1 ) * cWriteChunkSize ) );
+        for ( auto f = fBeg; f < fEnd; ++f )
         {
-            UVCoord uvs[3];
-            for ( int i = 0; i < 3; ++i )
-                uvs[i] = getAt( *settings.uvMap, vs[i] );
-            out.put( char( 6 ) );
-            static_assert( sizeof( uvs ) == 3 * 2 * 4 );
-            out.write( (const char *)uvs, sizeof( uvs ) );
+            Vector3i tri;
+            ThreeVertIds vs;
+            if ( hasFace( mesh, f ) )
+            {
+                vs = getTriVerts( mesh, f );
+                for ( int i = 0; i < 3; ++i )
+                    tri[i] = vertRenumber( vs[i] );
+            }
+            else if ( !settings.packPrimitives )
+                tri[0] = tri[1] = tri[2] = 0;
+            else
+                continue;
+            buf.push_back( char( 3 ) );
+            static_assert( sizeof( Vector3i ) == 12 );
+            appendBytes( buf, tri );
+            if ( saveFaceColors )
+            {
+                const auto c = getAt( *settings.primitiveColors, f );
+                appendBytes( buf, PlyColor{ .r = c.r, .g = c.g, .b = c.b } );
+            }
+            if ( saveUV && settings.saveTriCornerUVCoords )
+            {
+                UVCoord uvs[3];
+                for ( int i = 0; i < 3; ++i )
+                    uvs[i] = getAt( *settings.uvMap, vs[i] );
+                buf.push_back( char( 6 ) );
+                static_assert( sizeof( uvs ) == 3 * 2 * 4 );
+                appendBytes( buf, uvs );
+            }
         }
-        ++savedFaces;
-        if ( settings.progress && !( savedFaces & 0x3FF ) && !settings.progress( float( savedFaces ) / numSaveFaces * 0.5f + 0.5f ) )
-            return unexpectedOperationCanceled();
+    }, subprogress( settings.progress, 0.5f, 1.0f ) ) )
+    {
+        if ( !out )
+            return unexpected( std::string( "Error saving in PLY-format" ) );
+        return unexpectedOperationCanceled();
     }
 
     if ( !out )
@@ -57,6 +57,9 @@ public:
     /// writes one more triangle in the stream
     MRMESH_API bool writeTri( const Triangle3f& tri );
 
+    /// writes given triangles in the stream, formatting them in parallel
+    MRMESH_API bool writeTris( const std::vector<Triangle3f>& tris );
+
     /// if initially written the number of triangles do not match to the actual number of written triangles,
     /// updates the number in the header
     MRMESH_API bool updateHeadCounter();
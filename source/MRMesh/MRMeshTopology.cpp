@@ -1751,6 +1751,46 @@ bool MeshTopology::buildGridMesh( const GridSettings & settings, ProgressCallbac
     return computeValidsFromEdges( subprogress( cb, 0.5f, 1.0f ) );
 }
 
+bool MeshTopology::buildFromRings( const std::vector<size_t> & ringStarts, const std::vector<RingEdge> & ringEdges,
+    size_t numUndirectedEdges, Vector<EdgeId, FaceId> edgePerFace, ProgressCallback cb )
+{
+    MR_TIMER;
+    assert( !ringStarts.empty() );
+    assert( ringStarts.back() == ringEdges.size() );
+    assert( ringEdges.size() == 2 * numUndirectedEdges );
+
+    stopUpdatingValids();
+    edgePerVertex_.resizeNoInit( ringStarts.size() - 1 );
+    edgePerFace_ = std::move( edgePerFace );
+    edges_.resizeNoInit( 2 * numUndirectedEdges );
+
+    auto result = ParallelFor( 0_v, edgePerVertex_.endId(), [&]( VertId v )
+    {
+        const auto first = ringStarts[v];
+        const auto last = ringStarts[v + 1];
+        if ( first == last )
+        {
+            edgePerVertex_[v] = {};
+            return;
+        }
+        edgePerVertex_[v] = ringEdges[first].e;
+        for ( auto i = first; i < last; ++i )
+        {
+            HalfEdgeRecord he( noInit );
+            he.next = ringEdges[i + 1 < last ? i + 1 : first].e;
+            he.prev = ringEdges[i > first ? i - 1 : last - 1].e;
+            he.org = v;
+            he.left = ringEdges[i].left;
+            edges_[ringEdges[i].e] = he;
+        }
+    }, subprogress( cb, 0.0f, 0.5f ) );
+
+    if ( !result )
+        return result;
+
+    return computeValidsFromEdges( subprogress( cb, 0.5f, 1.0f ) );
+}
+
 bool MeshTopology::computeValidsFromEdges( ProgressCallback cb )
 {
     MR_TIMER;
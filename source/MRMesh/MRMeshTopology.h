@@ -553,6 +553,20 @@ public:
     // constructs triangular grid mesh topology in parallel
     MRMESH_API bool buildGridMesh( const GridSettings& settings, ProgressCallback cb = {} );
 
+    /// an edge in the ring of its origin vertex together with the face to the left of it
+    struct RingEdge
+    {
+        EdgeId e;
+        FaceId left;
+    };
+
+    /// constructs mesh topology in parallel from the rings of outgoing edges around every vertex
+    /// \param ringStarts ring of vertex v occupies ringEdges[ringStarts[v], ringStarts[v+1]), vertices with empty rings are invalid
+    /// \param ringEdges the edges of each ring are in counter-clockwise order, each half-edge in [0, 2*numUndirectedEdges) must be present exactly once
+    /// \param edgePerFace one edge with each face on the left, invalid for missing faces
+    MRMESH_API bool buildFromRings( const std::vector<size_t> & ringStarts, const std::vector<RingEdge> & ringEdges,
+        size_t numUndirectedEdges, Vector<EdgeId, FaceId> edgePerFace, ProgressCallback cb = {} );
+
     /// verifies that all internal data structures are valid;
     /// if allVerts=true then checks in addition that all not-lone edges have valid vertices on both ends
     MRMESH_API bool checkValidity( ProgressCallback cb = {}, bool allVerts = true ) const;
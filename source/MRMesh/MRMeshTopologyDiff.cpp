@@ -1,6 +1,8 @@
 #include "MRMeshTopologyDiff.h"
 #include "MRTimer.h"
 #include "MRHeapBytes.h"
+#include <istream>
+#include <ostream>
 
 namespace MR
 {
@@ -53,4 +55,36 @@ size_t MeshTopologyDiff::heapBytes() const
 {
     return MR::heapBytes( changedEdges_ );
 }
+
+void MeshTopologyDiff::write( std::ostream & s ) const
+{
+    const std::uint64_t header[2] = { toEdgesSize_, changedEdges_.size() };
+    s.write( (const char*)header, sizeof( header ) );
+    for ( const auto & [e, rec] : changedEdges_ )
+    {
+        s.write( (const char*)&e, sizeof( e ) );
+        s.write( (const char*)&rec, sizeof( rec ) );
+    }
+}
+
+Expected<void> MeshTopologyDiff::read( std::istream & s )
+{
+    std::uint64_t header[2] = {};
+    if ( !s.read( (char*)header, sizeof( header ) ) )
+        return unexpected( "Cannot read topology difference" );
+    toEdgesSize_ = header[0];
+    changedEdges_.clear();
+    changedEdges_.reserve( header[1] );
+    for ( std::uint64_t i = 0; i < header[1]; ++i )
+    {
+        EdgeId e;
+        MeshTopology::HalfEdgeRecord rec;
+        s.read( (char*)&e, sizeof( e ) );
+        s.read( (char*)&rec, sizeof( rec ) );
+        if ( !s )
+            return unexpected( "Cannot read topology difference" );
+        changedEdges_[e] = rec;
+    }
+    return {};
+}
 } // namespace MR
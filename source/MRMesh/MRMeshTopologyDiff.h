@@ -30,6 +30,12 @@ public:
     /// returns the amount of memory this object occupies on heap
     [[nodiscard]] MRMESH_API size_t heapBytes() const;
 
+    /// saves in binary stream
+    MRMESH_API void write( std::ostream & s ) const;
+
+    /// loads from binary stream
+    MRMESH_API Expected<void> read( std::istream & s );
+
 private:
     size_t toEdgesSize_ = 0;
     HashMap<EdgeId, MeshTopology::HalfEdgeRecord> changedEdges_;
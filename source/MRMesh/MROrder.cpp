@@ -1,12 +1,15 @@
 #include "MROrder.h"
 #include "MRBox.h"
 #include "MRBuffer.h"
+#include "MRBitSet.h"
+#include "MRComputeBoundingBox.h"
 #include "MRMesh.h"
 #include "MRParallelFor.h"
 #include "MRRingIterator.h"
 #include "MRTimer.h"
 
 #include <algorithm>
+#include <cmath>
 #include <span>
 
 namespace MR
@@ -88,6 +91,111 @@ void orderFacePoints( const FacePointSpan & span, int numThreads )
     }
 }
 
+constexpr int cCurveBits = 21;
+
+/// spreads lower 21 bits of x so that there are two zero bits between each pair of original bits
+std::uint64_t spreadBits3( std::uint64_t x )
+{
+    x &= 0x1fffff;
+    x = ( x | x << 32 ) & 0x1f00000000ffffull;
+    x = ( x | x << 16 ) & 0x1f0000ff0000ffull;
+    x = ( x | x << 8 ) & 0x100f00f00f00f00full;
+    x = ( x | x << 4 ) & 0x10c30c30c30c30c3ull;
+    x = ( x | x << 2 ) & 0x1249249249249249ull;
+    return x;
+}
+
+std::uint64_t mortonKey( std::uint32_t x, std::uint32_t y, std::uint32_t z )
+{
+    return spreadBits3( x ) | ( spreadBits3( y ) << 1 ) | ( spreadBits3( z ) << 2 );
+}
+
+/// computes the index along Hilbert curve by J. Skilling's algorithm ("Programming the Hilbert curve", 2004)
+std::uint64_t hilbertKey( std::uint32_t x0, std::uint32_t x1, std::uint32_t x2 )
+{
+    std::uint32_t x[3] = { x0, x1, x2 };
+    constexpr std::uint32_t m = 1u << ( cCurveBits - 1 );
+    // inverse undo
+    for ( std::uint32_t q = m; q > 1; q >>= 1 )
+    {
+        const std::uint32_t p = q - 1;
+        for ( int i = 0; i < 3; ++i )
+        {
+            if ( x[i] & q )
+                x[0] ^= p; // invert
+            else
+            {
+                const std::uint32_t t = ( x[0] ^ x[i] ) & p; // exchange
+                x[0] ^= t;
+                x[i] ^= t;
+            }
+        }
+    }
+    // Gray encode
+    for ( int i = 1; i < 3; ++i )
+        x[i] ^= x[i - 1];
+    std::uint32_t t = 0;
+    for ( std::uint32_t q = m; q > 1; q >>= 1 )
+        if ( x[2] & q )
+            t ^= q - 1;
+    for ( int i = 0; i < 3; ++i )
+        x[i] ^= t;
+    // x is the transposed index, the bits of x[0] are the most significant in each triple
+    return mortonKey( x[2], x[1], x[0] );
+}
+
+/// computes the positions of points along a space-filling curve inside given box
+class CurveKeyMaker
+{
+public:
+    CurveKeyMaker( const Box3f & box, SpaceCurve curve ) : min_( box.min ), curve_( curve )
+    {
+        const auto size = box.size();
+        for ( int i = 0; i < 3; ++i )
+            scale_[i] = size[i] > 0 ? cMaxCoord / size[i] : 0.0f;
+    }
+
+    std::uint64_t operator()( const Vector3f & p ) const
+    {
+        std::uint32_t q[3];
+        for ( int i = 0; i < 3; ++i )
+            q[i] = std::uint32_t( std::clamp( ( p[i] - min_[i] ) * scale_[i], 0.0f, cMaxCoord ) );
+        return curve_ == SpaceCurve::Hilbert ? hilbertKey( q[0], q[1], q[2] ) : mortonKey( q[0], q[1], q[2] );
+    }
+
+private:
+    static constexpr float cMaxCoord = float( ( 1 << cCurveBits ) - 1 );
+    Vector3f min_;
+    Vector3f scale_;
+    SpaceCurve curve_;
+};
+
+/// an element with its position along a curve
+struct CurveElement
+{
+    std::uint64_t key = 0;
+    std::uint32_t id = 0;
+    bool operator <( const CurveElement & b ) const
+        { return std::tie( key, id ) < std::tie( b.key, b.id ); }
+};
+
+/// Forsyth's score of a vertex depending on its position in LRU cache and the number of not-emitted incident triangles
+float vertexCacheScore( int cachePos, int numRemaining, int cacheSize )
+{
+    if ( numRemaining <= 0 )
+        return -1;
+    float score = 0;
+    if ( cachePos >= 0 )
+    {
+        if ( cachePos < 3 )
+            score = 0.75f; // the vertices of just emitted triangle
+        else
+            score = std::pow( 1 - float( cachePos - 3 ) / float( cacheSize - 3 ), 1.5f );
+    }
+    // prefer vertices with few remaining triangles to finish them and avoid isolated triangles in the end
+    return score + 2 / std::sqrt( float( numRemaining ) );
+}
+
 } // anonymous namespace
 
 FaceBMap getOptimalFaceOrdering( const Mesh & mesh )
@@ -276,4 +384,294 @@ UndirectedEdgeBMap getEdgeOrdering( const FaceBMap & faceMap, const MeshTopology
     return res;
 }
 
+FaceBMap getFaceOrderingAlongCurve( const Mesh & mesh, SpaceCurve curve )
+{
+    MR_TIMER;
+
+    FaceBMap res;
+    const auto numFaces = mesh.topology.numValidFaces();
+    res.b.resize( mesh.topology.faceSize() );
+    res.tsize = numFaces;
+
+    std::vector<CurveElement> ord( numFaces );
+    const bool packed = numFaces == mesh.topology.faceSize();
+    if ( !packed )
+    {
+        std::uint32_t n = 0;
+        for ( FaceId f = 0_f; f < res.b.size(); ++f )
+            if ( mesh.topology.hasFace( f ) )
+                ord[n++].id = f;
+            else
+                res.b[f] = FaceId{};
+    }
+
+    const CurveKeyMaker keyMaker( mesh.computeBoundingBox(), curve );
+    ParallelFor( ord, [&] ( size_t i )
+    {
+        if ( packed )
+            ord[i].id = std::uint32_t( i );
+        ord[i].key = keyMaker( mesh.triCenter( FaceId( ord[i].id ) ) );
+    } );
+    tbb::parallel_sort( ord.begin(), ord.end() );
+
+    ParallelFor( ord, [&] ( size_t i )
+    {
+        res.b[FaceId( ord[i].id )] = FaceId( i );
+    } );
+    return res;
+}
+
+VertBMap getVertexOrderingAlongCurve( const VertCoords & points, const VertBitSet & validPoints, SpaceCurve curve )
+{
+    MR_TIMER;
+
+    VertBMap res;
+    res.b.resize( points.size() );
+    std::vector<CurveElement> ord;
+    ord.reserve( validPoints.count() );
+    for ( VertId v = 0_v; v < points.size(); ++v )
+    {
+        if ( validPoints.test( v ) )
+            ord.push_back( { 0, std::uint32_t( v ) } );
+        else
+            res.b[v] = VertId{};
+    }
+    res.tsize = ord.size();
+
+    const CurveKeyMaker keyMaker( computeBoundingBox( points, validPoints ), curve );
+    ParallelFor( ord, [&] ( size_t i )
+    {
+        ord[i].key = keyMaker( points[VertId( ord[i].id )] );
+    } );
+    tbb::parallel_sort( ord.begin(), ord.end() );
+
+    ParallelFor( ord, [&] ( size_t i )
+    {
+        res.b[VertId( ord[i].id )] = VertId( i );
+    } );
+    return res;
+}
+
+FaceBMap getVertexCacheOptimalFaceOrdering( const MeshTopology & topology, const FaceBMap * initialOrder, int cacheSize )
+{
+    MR_TIMER;
+    cacheSize = std::max( cacheSize, 4 );
+
+    FaceBMap res;
+    const auto numFaces = topology.numValidFaces();
+    res.b.resize( topology.faceSize() );
+    res.tsize = numFaces;
+
+    // valid faces in the initial order
+    std::vector<FaceId> seq;
+    seq.reserve( numFaces );
+    for ( FaceId f = 0_f; f < res.b.size(); ++f )
+    {
+        res.b[f] = FaceId{};
+        if ( topology.hasFace( f ) )
+            seq.push_back( f );
+    }
+    if ( initialOrder )
+    {
+        assert( topology.lastValidFace() < (int)initialOrder->b.size() );
+        tbb::parallel_sort( seq.begin(), seq.end(), [&] ( FaceId a, FaceId b )
+        {
+            return std::tie( initialOrder->b[a], a ) < std::tie( initialOrder->b[b], b );
+        } );
+    }
+
+    const auto tris = topology.getTriangulation();
+
+    // not-emitted incident faces of each vertex are stored in vertFaces[vertFacesStart[v], vertFacesStart[v] + numRemaining[v])
+    const auto numVerts = topology.vertSize();
+    std::vector<int> vertFacesStart( numVerts + 1, 0 );
+    for ( auto f : seq )
+        for ( auto v : tris[f] )
+            ++vertFacesStart[v + 1];
+    std::vector<int> numRemaining( numVerts );
+    for ( size_t v = 0; v < numVerts; ++v )
+    {
+        numRemaining[v] = vertFacesStart[v + 1];
+        vertFacesStart[v + 1] += vertFacesStart[v];
+    }
+    std::vector<FaceId> vertFaces( vertFacesStart.back() );
+    {
+        std::vector<int> filled( numVerts, 0 );
+        for ( auto f : seq )
+            for ( auto v : tris[f] )
+                vertFaces[vertFacesStart[v] + filled[v]++] = f;
+    }
+
+    std::vector<int> cachePos( numVerts, -1 );
+    std::vector<float> vertScore( numVerts );
+    for ( size_t v = 0; v < numVerts; ++v )
+        vertScore[v] = vertexCacheScore( -1, numRemaining[v], cacheSize );
+
+    Vector<float, FaceId> faceScore( topology.faceSize() );
+    auto updateFaceScore = [&] ( FaceId f )
+    {
+        const auto & t = tris[f];
+        return faceScore[f] = vertScore[t[0]] + vertScore[t[1]] + vertScore[t[2]];
+    };
+    for ( auto f : seq )
+        updateFaceScore( f );
+
+    FaceBitSet emitted( topology.faceSize() );
+    std::vector<VertId> cache, newCache;
+    cache.reserve( cacheSize + 3 );
+    newCache.reserve( cacheSize + 3 );
+    size_t seqPos = 0;
+    FaceId best;
+    for ( FaceId newf = 0_f; newf < numFaces; ++newf )
+    {
+        if ( !best )
+        {
+            // no face in the cache, start from the first not emitted face in the initial order
+            while ( emitted.test( seq[seqPos] ) )
+                ++seqPos;
+            best = seq[seqPos];
+        }
+        res.b[best] = newf;
+        emitted.set( best );
+
+        // remove emitted face from the lists of its vertices, and put them in the front of the cache
+        const auto & t = tris[best];
+        newCache.clear();
+        for ( auto v : t )
+        {
+            const auto first = vertFaces.begin() + vertFacesStart[v];
+            const auto last = first + numRemaining[v];
+            const auto it = std::find( first, last, best );
+            assert( it != last );
+            std::iter_swap( it, last - 1 );
+            --numRemaining[v];
+            newCache.push_back( v );
+        }
+        for ( auto v : cache )
+            if ( v != t[0] && v != t[1] && v != t[2] )
+                newCache.push_back( v );
+
+        // update the scores of the vertices in the cache and of the vertices just evicted from it
+        for ( int i = 0; i < (int)newCache.size(); ++i )
+        {
+            const auto v = newCache[i];
+            cachePos[v] = i < cacheSize ? i : -1;
+            vertScore[v] = vertexCacheScore( cachePos[v], numRemaining[v], cacheSize );
+        }
+
+        // find the best face among not-emitted faces of the vertices in the cache
+        best = {};
+        float bestScore = -1;
+        for ( const auto v : newCache )
+        {
+            for ( int j = 0; j < numRemaining[v]; ++j )
+            {
+                const auto f = vertFaces[vertFacesStart[v] + j];
+                const auto score = updateFaceScore( f );
+                if ( cachePos[v] >= 0 && score > bestScore )
+                {
+                    bestScore = score;
+                    best = f;
+                }
+            }
+        }
+        if ( (int)newCache.size() > cacheSize )
+            newCache.resize( cacheSize );
+        cache.swap( newCache );
+    }
+
+    return res;
+}
+
+MeshLocalityStats computeLocalityStats( const MeshTopology & topology, int cacheSize )
+{
+    MR_TIMER;
+    MeshLocalityStats res;
+
+    double sumVertDist = 0;
+    size_t numFaces = 0;
+    // FIFO vertex cache: the vertex is in the cache if less than cacheSize misses happened after its insertion
+    std::vector<std::int64_t> insertedAt( topology.vertSize(), -1 );
+    std::int64_t numMisses = 0;
+    for ( FaceId f = 0_f; f < topology.faceSize(); ++f )
+    {
+        if ( !topology.hasFace( f ) )
+            continue;
+        ++numFaces;
+        const auto t = topology.getTriVerts( f );
+        sumVertDist += std::abs( int( t[0] ) - int( t[1] ) ) + std::abs( int( t[1] ) - int( t[2] ) ) + std::abs( int( t[2] ) - int( t[0] ) );
+        for ( auto v : t )
+        {
+            if ( insertedAt[v] >= 0 && numMisses - insertedAt[v] <= cacheSize )
+                continue;
+            insertedAt[v] = numMisses++;
+        }
+    }
+
+    double sumFaceDist = 0;
+    size_t numFacePairs = 0;
+    for ( UndirectedEdgeId ue = 0_ue; ue < topology.undirectedEdgeSize(); ++ue )
+    {
+        const auto l = topology.left( ue );
+        const auto r = topology.right( ue );
+        if ( !l || !r )
+            continue;
+        sumFaceDist += std::abs( int( l ) - int( r ) );
+        ++numFacePairs;
+    }
+
+    if ( numFaces > 0 )
+    {
+        res.avgVertIndexDistance = sumVertDist / ( 3 * numFaces );
+        res.acmr = double( numMisses ) / numFaces;
+    }
+    if ( numFacePairs > 0 )
+        res.avgNeighborFaceDistance = sumFaceDist / numFacePairs;
+    if ( auto numVerts = topology.numValidVerts(); numVerts > 0 )
+        res.atvr = double( numMisses ) / numVerts;
+    return res;
+}
+
+Expected<PackMapping> optimizeLocality( Mesh & mesh, const LocalityParams & params, ProgressCallback cb )
+{
+    MR_TIMER;
+
+    PackMapping map;
+    switch ( params.order )
+    {
+    case LocalityOrder::AABBTree:
+        map.f = getOptimalFaceOrdering( mesh );
+        break;
+    case LocalityOrder::Morton:
+        map.f = getFaceOrderingAlongCurve( mesh, SpaceCurve::Morton );
+        break;
+    case LocalityOrder::Hilbert:
+        map.f = getFaceOrderingAlongCurve( mesh, SpaceCurve::Hilbert );
+        break;
+    }
+    if ( !reportProgress( cb, 0.3f ) )
+        return unexpectedOperationCanceled();
+
+    if ( params.optimizeVertexCache )
+    {
+        map.f = getVertexCacheOptimalFaceOrdering( mesh.topology, &map.f, params.cacheSize );
+        if ( !reportProgress( cb, 0.5f ) )
+            return unexpectedOperationCanceled();
+    }
+
+    map.v = getVertexOrdering( map.f, mesh.topology );
+    if ( !reportProgress( cb, 0.6f ) )
+        return unexpectedOperationCanceled();
+
+    map.e = getEdgeOrdering( map.f, mesh.topology );
+    if ( !reportProgress( cb, 0.7f ) )
+        return unexpectedOperationCanceled();
+
+    mesh.invalidateCaches();
+    if ( auto r = mesh.pack( map, subprogress( cb, 0.7f, 1.0f ) ); !r )
+        return unexpected( std::move( r.error() ) );
+
+    return map;
+}
+
 } //namespace MR
@@ -2,6 +2,8 @@
 
 #include "MRId.h"
 #include "MRBuffer.h"
+#include "MRExpected.h"
+#include "MRProgressCallback.h"
 #include <tuple>
 
 namespace MR
@@ -21,4 +23,64 @@ namespace MR
 /// \param faceMap old face id -> new face id
 [[nodiscard]] MRMESH_API UndirectedEdgeBMap getEdgeOrdering( const FaceBMap & faceMap, const MeshTopology & topology );
 
+/// space-filling curves to order elements along
+enum class SpaceCurve
+{
+    Morton, ///< Z-order curve: fast to compute, but has long jumps between octants
+    Hilbert ///< continuous curve: neighbor elements along it are always close in space
+};
+
+/// computes the order of faces along given space-filling curve passing via triangle centroids: old face id -> new face id
+[[nodiscard]] MRMESH_API FaceBMap getFaceOrderingAlongCurve( const Mesh & mesh, SpaceCurve curve );
+
+/// computes the order of given points along given space-filling curve: old vertex id -> new vertex id,
+/// the points not from validPoints are put in the end and mapped into invalid ids;
+/// can be used both for mesh vertices and point clouds
+[[nodiscard]] MRMESH_API VertBMap getVertexOrderingAlongCurve( const VertCoords & points, const VertBitSet & validPoints, SpaceCurve curve );
+
+/// computes the order of faces to minimize the number of vertex cache misses during rendering of index buffer (Forsyth's algorithm):
+/// old face id -> new face id;
+/// \param initialOrder if provided, then new strips are started from the first not-yet-emitted face in this order to preserve spatial locality
+/// \param cacheSize the size of simulated LRU vertex cache
+[[nodiscard]] MRMESH_API FaceBMap getVertexCacheOptimalFaceOrdering( const MeshTopology & topology, const FaceBMap * initialOrder = nullptr, int cacheSize = 32 );
+
+/// measurements of the locality of mesh elements in memory
+struct MeshLocalityStats
+{
+    /// average difference of vertex ids in the pairs of vertices of each triangle
+    double avgVertIndexDistance = 0;
+    /// average difference of face ids of two triangles sharing an edge
+    double avgNeighborFaceDistance = 0;
+    /// average cache miss ratio: the number of vertex cache misses per triangle (from 0.5 for ideal order on big meshes to 3)
+    double acmr = 0;
+    /// average transform to vertex ratio: the number of vertex cache misses per vertex (1 is ideal)
+    double atvr = 0;
+};
+
+/// computes locality statistics of current order of elements in the mesh;
+/// \param cacheSize the size of simulated FIFO vertex cache, which visits triangles in the order of their ids
+[[nodiscard]] MRMESH_API MeshLocalityStats computeLocalityStats( const MeshTopology & topology, int cacheSize = 32 );
+
+/// the order of faces established by optimizeLocality
+enum class LocalityOrder
+{
+    AABBTree, ///< as in the leaves of AABB tree, see getOptimalFaceOrdering
+    Morton,   ///< along Z-order curve
+    Hilbert   ///< along Hilbert curve
+};
+
+struct LocalityParams
+{
+    LocalityOrder order = LocalityOrder::AABBTree;
+    /// if true then the spatial order of faces is refined to reduce vertex cache misses during rendering
+    bool optimizeVertexCache = false;
+    /// the size of simulated vertex cache for optimizeVertexCache
+    int cacheSize = 32;
+};
+
+/// tightly packs the mesh and reorders its faces, vertices and edges to put the elements close in space (and in rendering order) in close indices;
+/// vertices and edges follow the order of their faces; all mesh caches are invalidated
+/// \return the mapping from old ids into new ids, which can be used to rearrange per-element attributes
+MRMESH_API Expected<PackMapping> optimizeLocality( Mesh & mesh, const LocalityParams & params = {}, ProgressCallback cb = {} );
+
 } //namespace MR
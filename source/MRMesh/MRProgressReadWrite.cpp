@@ -1,6 +1,9 @@
 #include "MRProgressReadWrite.h"
+#include "MRParallelFor.h"
+#include "MRPch/MRTBB.h"
 #include <istream>
 #include <ostream>
+#include <thread>
 
 namespace MR
 {
@@ -59,4 +62,45 @@ bool readByBlocks( std::istream& in, char* data, size_t dataSize, ProgressCallba
     return true;
 }
 
+bool writeChunksInParallel( std::ostream& out, size_t numChunks,
+    const std::function<void( size_t chunk, std::vector<char>& buf )>& format, ProgressCallback callback /*= {}*/, size_t chunksPerBatch /*= 0*/ )
+{
+    if ( !numChunks )
+        return reportProgress( callback, 1.0f ) && (bool)out;
+
+    if ( chunksPerBatch == 0 )
+        chunksPerBatch = 4 * std::max( 1u, std::thread::hardware_concurrency() );
+
+    // the batch being formatted and the batch being written
+    std::vector<std::vector<char>> formatBufs( std::min( chunksPerBatch, numChunks ) ), writeBufs( formatBufs.size() );
+    tbb::task_group writer;
+    for ( size_t batchBegin = 0; batchBegin < numChunks; batchBegin += chunksPerBatch )
+    {
+        const auto batchEnd = std::min( batchBegin + chunksPerBatch, numChunks );
+        ParallelFor( batchBegin, batchEnd, [&]( size_t i )
+        {
+            auto & buf = formatBufs[i - batchBegin];
+            buf.clear();
+            format( i, buf );
+        } );
+
+        writer.wait();
+        std::swap( formatBufs, writeBufs );
+        const auto numWriteBufs = batchEnd - batchBegin;
+        writer.run( [&out, &writeBufs, numWriteBufs]
+        {
+            for ( size_t i = 0; i < numWriteBufs; ++i )
+                out.write( writeBufs[i].data(), writeBufs[i].size() );
+        } );
+
+        if ( !reportProgress( callback, float( batchEnd ) / numChunks ) )
+        {
+            writer.wait();
+            return false;
+        }
+    }
+    writer.wait();
+    return (bool)out;
+}
+
 }
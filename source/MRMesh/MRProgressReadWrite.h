@@ -1,7 +1,9 @@
 #pragma once
 #include "MRProgressCallback.h"
 #include "MRMeshFwd.h"
+#include <functional>
 #include <iosfwd>
+#include <vector>
 
 namespace MR
 {
@@ -21,4 +23,14 @@ MRMESH_API bool writeByBlocks( std::ostream& out, const char* data, size_t dataS
  */
 MRMESH_API bool readByBlocks( std::istream& in, char* data, size_t dataSize, ProgressCallback callback = {}, size_t blockSize = ( size_t( 1 ) << 16 ) );
 
+/**
+ * \brief writes numChunks chunks of data in out stream in their order, each chunk is produced by format function
+ * \details the chunks are formatted in parallel by batches of chunksPerBatch (0 means auto-select),
+ * and the writing of each batch in the stream is performed concurrently with the formatting of the next batch;
+ * format( i, buf ) must append the bytes of chunk #i in initially empty buf
+ * \return false if process was canceled (callback is set and return false ) or the stream failed
+ */
+MRMESH_API bool writeChunksInParallel( std::ostream& out, size_t numChunks,
+    const std::function<void( size_t chunk, std::vector<char>& buf )>& format, ProgressCallback callback = {}, size_t chunksPerBatch = 0 );
+
 }
@@ -0,0 +1,99 @@
+#include "MRQuantizedVertCoords.h"
+#include "MRComputeBoundingBox.h"
+#include "MRBitSetParallelFor.h"
+#include "MRParallelFor.h"
+#include "MRHeapBytes.h"
+#include "MRBitSet.h"
+#include "MRTimer.h"
+#include <algorithm>
+#include <cmath>
+
+namespace MR
+{
+
+QuantizedVertCoords::QuantizedVertCoords( const VertCoords & points, Precision precision, const VertBitSet * region )
+    : precision_( precision ), size_( points.size() )
+{
+    MR_TIMER;
+    box_ = computeBoundingBox( points, region );
+    if ( !box_.valid() )
+        box_ = Box3f( Vector3f(), Vector3f() );
+
+    const float maxQ = precision == Precision::Bits16 ? 65535.0f : float( cMask21 );
+    const auto size = box_.size();
+    Vector3f invStep;
+    for ( int i = 0; i < 3; ++i )
+    {
+        step_[i] = size[i] / maxQ;
+        invStep[i] = step_[i] > 0 ? 1 / step_[i] : 0.0f;
+    }
+
+    auto quantize = [&] ( VertId v, int i )
+    {
+        return std::uint32_t( std::clamp( std::round( ( points[v][i] - box_.min[i] ) * invStep[i] ), 0.0f, maxQ ) );
+    };
+
+    if ( precision == Precision::Bits16 )
+    {
+        data16_.resize( 3 * size_ );
+        auto encode = [&] ( VertId v )
+        {
+            auto * p = data16_.data() + 3 * size_t( v );
+            for ( int i = 0; i < 3; ++i )
+                p[i] = std::uint16_t( quantize( v, i ) );
+        };
+        if ( region )
+            BitSetParallelFor( *region, encode );
+        else
+            ParallelFor( points, encode );
+    }
+    else
+    {
+        data21_.resize( size_ );
+        auto encode = [&] ( VertId v )
+        {
+            data21_[v] = std::uint64_t( quantize( v, 0 ) )
+                | ( std::uint64_t( quantize( v, 1 ) ) << 21 )
+                | ( std::uint64_t( quantize( v, 2 ) ) << 42 );
+        };
+        if ( region )
+            BitSetParallelFor( *region, encode );
+        else
+            ParallelFor( points, encode );
+    }
+}
+
+VertCoords QuantizedVertCoords::toVertCoords() const
+{
+    VertCoords res;
+    decode( res );
+    return res;
+}
+
+void QuantizedVertCoords::decode( VertCoords & res, const VertBitSet * region ) const
+{
+    MR_TIMER;
+    if ( res.size() < size_ )
+        res.resizeNoInit( size_ );
+    auto decodeOne = [&] ( VertId v )
+    {
+        res[v] = ( *this )[v];
+    };
+    if ( region )
+    {
+        BitSetParallelFor( *region, [&] ( VertId v )
+        {
+            if ( v < size_ )
+                decodeOne( v );
+        } );
+    }
+    else
+        ParallelFor( 0_v, VertId( size_ ), decodeOne );
+}
+
+size_t QuantizedVertCoords::heapBytes() const
+{
+    return MR::heapBytes( data16_ ) + MR::heapBytes( data21_ );
+}
+
+} // namespace MR
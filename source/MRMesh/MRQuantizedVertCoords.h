@@ -0,0 +1,88 @@
+#pragma once
+
+#include "MRVector3.h"
+#include "MRBox.h"
+#include "MRId.h"
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+namespace MR
+{
+
+/// compact read-only storage of vertex coordinates: each coordinate is quantized on a uniform grid inside the bounding box of all points
+/// \details 16 bits per coordinate take 6 bytes per point (half of VertCoords) with the relative error 1/131070 of box size,
+/// 21 bits per coordinate are packed in 8 bytes per point (two thirds of VertCoords) with the relative error about 2.4e-7 of box size
+///
+/// The algorithms reading points can use it without decoding all points: extractPlaneSections has an overload for it,
+/// and extractIsolines or other functions taking per-vertex functors can call operator[].
+/// Projection and distance maps need AABBTree built over VertCoords, so the points (or only their region) have to be decoded in VertCoords first.
+/// \ingroup MeshAlgorithmGroup
+class QuantizedVertCoords
+{
+public:
+    enum class Precision : std::uint8_t
+    {
+        Bits16,
+        Bits21
+    };
+
+    QuantizedVertCoords() = default;
+
+    /// quantizes given points; if region is provided then only the points from it are stored and others become equal to box().min
+    MRMESH_API explicit QuantizedVertCoords( const VertCoords & points, Precision precision = Precision::Bits16, const VertBitSet * region = nullptr );
+
+    [[nodiscard]] Precision precision() const { return precision_; }
+
+    /// the number of stored points
+    [[nodiscard]] size_t size() const { return size_; }
+    [[nodiscard]] bool empty() const { return size_ == 0; }
+
+    /// the box of the quantization grid
+    [[nodiscard]] const Box3f & box() const { return box_; }
+
+    /// the distance between neighbor values of the quantization grid along each axis
+    [[nodiscard]] const Vector3f & step() const { return step_; }
+
+    /// the maximal difference between original and decoded coordinate along each axis
+    [[nodiscard]] Vector3f maxError() const { return 0.5f * step_; }
+
+    /// decodes one point
+    [[nodiscard]] Vector3f operator[]( VertId v ) const
+    {
+        assert( v < size_ );
+        if ( precision_ == Precision::Bits16 )
+        {
+            const auto * p = data16_.data() + 3 * size_t( v );
+            return decode_( p[0], p[1], p[2] );
+        }
+        const auto x = data21_[v];
+        return decode_( std::uint32_t( x & cMask21 ), std::uint32_t( ( x >> 21 ) & cMask21 ), std::uint32_t( x >> 42 ) );
+    }
+
+    /// decodes all points in parallel
+    [[nodiscard]] MRMESH_API VertCoords toVertCoords() const;
+
+    /// decodes given points in parallel writing them in (res), which is resized if necessary; other points of (res) are not touched
+    MRMESH_API void decode( VertCoords & res, const VertBitSet * region = nullptr ) const;
+
+    /// returns the amount of memory this object occupies on heap
+    [[nodiscard]] MRMESH_API size_t heapBytes() const;
+
+private:
+    static constexpr std::uint64_t cMask21 = ( std::uint64_t( 1 ) << 21 ) - 1;
+
+    [[nodiscard]] Vector3f decode_( std::uint32_t x, std::uint32_t y, std::uint32_t z ) const
+    {
+        return { box_.min.x + step_.x * float( x ), box_.min.y + step_.y * float( y ), box_.min.z + step_.z * float( z ) };
+    }
+
+    Precision precision_ = Precision::Bits16;
+    size_t size_ = 0;
+    Box3f box_;
+    Vector3f step_;
+    std::vector<std::uint16_t> data16_; ///< three values per point for Bits16
+    std::vector<std::uint64_t> data21_; ///< one packed value per point for Bits21
+};
+
+} // namespace MR
@@ -1,6 +1,7 @@
 #include "MRSeparationPoint.h"
 #include "MRParallelFor.h"
 #include "MRTimer.h"
+#include <algorithm>
 
 namespace MR
 {
@@ -69,4 +70,14 @@ void SeparationPointStorage::getPoints( VertCoords & points ) const
     } );
 }
 
+Vector3f SeparationPointStorage::getPoint( VertId v ) const
+{
+    // the last block with shift <= v, empty blocks have the same shift as the next block
+    auto it = std::upper_bound( blocks_.begin(), blocks_.end(), v, [] ( VertId v, const Block & b ) { return v < b.shift; } );
+    assert( it != blocks_.begin() );
+    --it;
+    assert( v - it->shift < it->coords.size() );
+    return it->coords[v - it->shift];
+}
+
 } //namespace MR
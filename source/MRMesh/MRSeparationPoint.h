@@ -59,6 +59,9 @@ public:
     /// obtains coordinates of all stored points
     MRMESH_API void getPoints( VertCoords & points ) const;
 
+    /// obtains coordinates of one stored point by its unique id (after makeUniqueVids())
+    [[nodiscard]] MRMESH_API Vector3f getPoint( VertId v ) const;
+
 private:
     size_t blockSize_ = 0;
     std::vector<Block> blocks_;
@@ -3,6 +3,8 @@
 #include "MRAABBTreePolyline.h"
 #include "MRAABBTreePoints.h"
 #include "MRDipole.h"
+#include "MRCollisionTriangle.h"
+#include "MRHeatGeodesics.h"
 #include "MRHeapBytes.h"
 #include "MRTbbTaskArenaAndGroup.h"
 #include "MRPch/MRSuppressWarning.h"
@@ -125,6 +127,8 @@ template class SharedThreadSafeOwner<AABBTreePolyline2>;
 template class SharedThreadSafeOwner<AABBTreePolyline3>;
 template class SharedThreadSafeOwner<AABBTreePoints>;
 template class SharedThreadSafeOwner<Dipoles>;
+template class SharedThreadSafeOwner<CollisionTriangles>;
+template class SharedThreadSafeOwner<HeatGeodesics>;
 
 } //namespace MR
 
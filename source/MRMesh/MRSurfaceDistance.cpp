@@ -1,7 +1,12 @@
 #include "MRSurfaceDistance.h"
 #include "MRSurfaceDistanceBuilder.h"
 #include "MRMesh.h"
+#include "MRRingIterator.h"
+#include "MRParallelFor.h"
 #include "MRTimer.h"
+#include "MRphmap.h"
+#include "MRPch/MRTBB.h"
+#include <atomic>
 
 namespace MR
 {
@@ -163,4 +168,225 @@ VertScalars computeSurfaceDistances( const Mesh& mesh, const std::vector<MeshTri
     return b.takeDistanceMap();
 }
 
+namespace
+{
+
+/// decreases the value in (a) to (d) if it is larger, returns whether the value was decreased
+bool atomicDecrease( std::atomic<float> & a, float d )
+{
+    float curr = a.load( std::memory_order_relaxed );
+    while ( d < curr )
+    {
+        if ( a.compare_exchange_weak( curr, d, std::memory_order_relaxed ) )
+            return true;
+    }
+    return false;
+}
+
+/// computes surface distances by delta-stepping: the vertices with the distances in current bucket
+/// relax the distances of their neighbors concurrently
+class ParallelSurfaceDistanceBuilder
+{
+public:
+    ParallelSurfaceDistanceBuilder( const Mesh & mesh, const VertBitSet * region, int maxVertUpdates )
+        : mesh_( mesh )
+        , region_( region )
+        , maxVertUpdates_( std::clamp( maxVertUpdates, 1, 255 ) )
+        , dist_( size_t( mesh.topology.lastValidVert() + 1 ) )
+        , queued_( dist_.size() )
+    {
+        MR_TIMER;
+        updatedTimes_.resize( dist_.size(), 0 );
+        ParallelFor( dist_, [&]( size_t i )
+        {
+            dist_[i].store( FLT_MAX, std::memory_order_relaxed );
+            queued_[i].store( false, std::memory_order_relaxed );
+        } );
+    }
+
+    /// sets the distance in given start vertex, which will propagate it independently of region
+    void addStart( VertId v, float d )
+    {
+        atomicDecrease( dist_[v], d );
+        if ( !queued_[v].exchange( true, std::memory_order_relaxed ) )
+            pending_.push_back( v );
+    }
+
+    /// propagates the distances till all vertices closer than maxDist are processed
+    void run( float maxDist, float delta )
+    {
+        MR_TIMER;
+        std::vector<VertId> frontier;
+        tbb::enumerable_thread_specific<std::vector<VertId>> newPending;
+        while ( !pending_.empty() )
+        {
+            float minDist = FLT_MAX;
+            for ( auto v : pending_ )
+                minDist = std::min( minDist, dist( v ) );
+            if ( !( minDist < maxDist ) )
+                break;
+            float bucketEnd = std::min( maxDist, ( std::floor( minDist / delta ) + 1 ) * delta );
+            if ( bucketEnd <= minDist )
+                bucketEnd = std::nextafter( minDist, FLT_MAX );
+
+            // take out of pending all vertices in current bucket
+            const auto it = std::partition( pending_.begin(), pending_.end(), [&]( VertId v ) { return !( dist( v ) < bucketEnd ); } );
+            frontier.assign( it, pending_.end() );
+            pending_.erase( it, pending_.end() );
+
+            ParallelFor( size_t( 0 ), frontier.size(), newPending, [&]( size_t i, std::vector<VertId> & myPending )
+            {
+                const auto v = frontier[i];
+                queued_[v].store( false, std::memory_order_relaxed );
+                auto & numUpdated = updatedTimes_[v];
+                if ( numUpdated >= maxVertUpdates_ )
+                    return; // stop updating to avoid infinite loops
+                ++numUpdated;
+                suggestDistancesAround_( v, myPending );
+            } );
+
+            for ( auto & myPending : newPending )
+            {
+                pending_.insert( pending_.end(), myPending.begin(), myPending.end() );
+                myPending.clear();
+            }
+        }
+    }
+
+    float dist( VertId v ) const { return dist_[v].load( std::memory_order_relaxed ); }
+
+    VertScalars takeDistanceMap()
+    {
+        MR_TIMER;
+        VertScalars res( dist_.size() );
+        ParallelFor( res, [&]( VertId v )
+        {
+            res[v] = dist( v );
+        } );
+        return res;
+    }
+
+private:
+    void suggestVertDistance_( VertId v, float d, std::vector<VertId> & myPending )
+    {
+        if ( !atomicDecrease( dist_[v], d ) )
+            return;
+        if ( region_ && !region_->test( v ) )
+            return;
+        if ( !queued_[v].exchange( true, std::memory_order_relaxed ) )
+            myPending.push_back( v );
+    }
+
+    void suggestDistancesAround_( VertId v, std::vector<VertId> & myPending )
+    {
+        const float vDist = dist( v );
+        for ( EdgeId e : orgRing( mesh_.topology, v ) )
+        {
+            float d = vDist + mesh_.edgeLength( e );
+            if ( d <= vDist )
+                d = std::nextafter( vDist, FLT_MAX );
+            suggestVertDistance_( mesh_.topology.dest( e ), d, myPending );
+            considerLeftTriPath_( e, myPending );
+            considerLeftTriPath_( e.sym(), myPending );
+        }
+    }
+
+    /// consider a path going in the left triangle from edge (e) to the opposing vertex, see SurfaceDistanceBuilder
+    void considerLeftTriPath_( EdgeId e, std::vector<VertId> & myPending )
+    {
+        if ( !mesh_.topology.left( e ) )
+            return;
+        VertId a, b, c;
+        mesh_.topology.getLeftTriVerts( e, a, b, c );
+        float va = dist( a );
+        float vb = dist( b );
+        if ( va == FLT_MAX || vb == FLT_MAX )
+            return;
+        if ( vb < va )
+        {
+            std::swap( a, b );
+            std::swap( va, vb );
+        }
+
+        float dvac = 0;
+        if ( !getFieldAtC( mesh_.points[b] - mesh_.points[a], mesh_.points[c] - mesh_.points[a], vb - va, dvac ) )
+            return;
+
+        float vc = va + dvac;
+        if ( vc <= va )
+            vc = std::nextafter( va, FLT_MAX );
+        suggestVertDistance_( c, vc, myPending );
+    }
+
+    const Mesh & mesh_;
+    const VertBitSet * region_ = nullptr;
+    int maxVertUpdates_ = 16;
+    std::vector<std::atomic<float>> dist_;
+    std::vector<std::atomic<bool>> queued_; ///< whether the vertex is in pending_ or in some thread's new pending vertices
+    Vector<std::uint8_t, VertId> updatedTimes_; ///< modified only by the thread processing the vertex
+    std::vector<VertId> pending_; ///< vertices with updated distances, which have not been propagated yet
+};
+
+float autoDelta( const Mesh & mesh, float delta )
+{
+    if ( delta > 0 )
+        return delta;
+    // several edges per bucket give enough parallelism not making too many repeated updates
+    delta = 4 * mesh.averageEdgeLength();
+    return delta > 0 ? delta : FLT_MAX;
+}
+
+} // anonymous namespace
+
+VertScalars computeSurfaceDistancesParallel( const Mesh& mesh, const HashMap<VertId, float>& startVertices, float maxDist,
+    const VertBitSet* region, float delta, int maxVertUpdates )
+{
+    MR_TIMER;
+
+    ParallelSurfaceDistanceBuilder b( mesh, region, maxVertUpdates );
+    for ( const auto & [v, dist] : startVertices )
+        b.addStart( v, dist );
+    b.run( maxDist, autoDelta( mesh, delta ) );
+    return b.takeDistanceMap();
+}
+
+VertScalars computeSurfaceDistancesParallel( const Mesh& mesh, const VertBitSet& startVertices, float maxDist,
+    const VertBitSet* region, float delta, int maxVertUpdates )
+{
+    MR_TIMER;
+
+    ParallelSurfaceDistanceBuilder b( mesh, region, maxVertUpdates );
+    for ( auto v : startVertices )
+        b.addStart( v, 0 );
+    b.run( maxDist, autoDelta( mesh, delta ) );
+    return b.takeDistanceMap();
+}
+
+Expected<std::vector<VertScalars>> computeSurfaceDistancesBatch( const Mesh& mesh, const std::vector<VertBitSet>& startVertices, float maxDist,
+    const VertBitSet* region, ProgressCallback cb )
+{
+    MR_TIMER;
+
+    std::vector<VertScalars> res( startVertices.size() );
+    if ( res.size() >= size_t( tbb::this_task_arena::max_concurrency() ) )
+    {
+        // enough independent fields to load all threads
+        if ( !ParallelFor( res, [&]( size_t i )
+        {
+            res[i] = computeSurfaceDistances( mesh, startVertices[i], maxDist, region );
+        }, cb, 1 ) )
+            return unexpectedOperationCanceled();
+        return res;
+    }
+
+    const auto delta = autoDelta( mesh, 0 );
+    for ( size_t i = 0; i < res.size(); ++i )
+    {
+        res[i] = computeSurfaceDistancesParallel( mesh, startVertices[i], maxDist, region, delta );
+        if ( !reportProgress( cb, float( i + 1 ) / res.size() ) )
+            return unexpectedOperationCanceled();
+    }
+    return res;
+}
+
 } //namespace MR
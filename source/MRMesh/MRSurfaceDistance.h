@@ -1,7 +1,9 @@
 #pragma once
 
 #include "MRMeshFwd.h"
+#include "MRExpected.h"
 #include <cfloat>
+#include <vector>
 
 namespace MR
 {
@@ -51,6 +53,26 @@ MRMESH_API VertScalars computeSurfaceDistances( const Mesh& mesh, const std::vec
 MRMESH_API VertScalars computeSurfaceDistances( const Mesh& mesh, const std::vector<MeshTriPoint>& starts, const std::vector<MeshTriPoint>& ends,
     const VertBitSet* region = nullptr, bool * endReached = nullptr, int maxVertUpdates = 3 );
 
+/// computes path distances in mesh vertices from given start vertices with values in them, stopping when maxDist is reached;
+/// unlike computeSurfaceDistances, the front is propagated by many threads concurrently (delta-stepping):
+/// all vertices with the distances in current bucket [k*delta, (k+1)*delta) relax their neighbors in parallel until the bucket stabilizes,
+/// and only then next bucket is processed; the result is equal to the one of computeSurfaceDistances within small tolerance;
+/// considered paths can go either along edges or straightly within triangles
+/// \param delta the width of distance buckets, 0 means auto-select as several average edge lengths
+/// \param maxVertUpdates the maximum number of times each vertex can propagate its distance to the neighbors
+MRMESH_API VertScalars computeSurfaceDistancesParallel( const Mesh& mesh, const HashMap<VertId, float>& startVertices, float maxDist = FLT_MAX,
+    const VertBitSet* region = nullptr, float delta = 0, int maxVertUpdates = 16 );
+
+/// computes path distances in mesh vertices from given start vertices in parallel by delta-stepping, stopping when maxDist is reached
+MRMESH_API VertScalars computeSurfaceDistancesParallel( const Mesh& mesh, const VertBitSet& startVertices, float maxDist = FLT_MAX,
+    const VertBitSet* region = nullptr, float delta = 0, int maxVertUpdates = 16 );
+
+/// computes independent distance fields from each given set of start vertices, stopping when maxDist is reached;
+/// if there are many sets then the fields are computed in parallel, each by single thread,
+/// otherwise the fields are computed one by one, each by computeSurfaceDistancesParallel
+MRMESH_API Expected<std::vector<VertScalars>> computeSurfaceDistancesBatch( const Mesh& mesh, const std::vector<VertBitSet>& startVertices, float maxDist = FLT_MAX,
+    const VertBitSet* region = nullptr, ProgressCallback cb = {} );
+
 /// \}
 
 } // namespace MR
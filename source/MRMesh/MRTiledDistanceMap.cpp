@@ -0,0 +1,327 @@
+#include "MRTiledDistanceMap.h"
+#include "MRDistanceMap.h"
+#include "MRMesh.h"
+#include "MRMeshTriPoint.h"
+#include "MRBitSetParallelFor.h"
+#include "MRParallelFor.h"
+#include "MRHeapBytes.h"
+#include "MRTimer.h"
+#include <algorithm>
+#include <cfloat>
+
+namespace MR
+{
+
+namespace
+{
+
+/// the parameters define the same rays, so the same face lists can be used
+bool sameProjection( const MeshToDistanceMapParams & a, const MeshToDistanceMapParams & b )
+{
+    return a.xRange == b.xRange && a.yRange == b.yRange && a.direction == b.direction && a.orgPoint == b.orgPoint
+        && a.resolution == b.resolution && a.allowNegativeValues == b.allowNegativeValues;
+}
+
+/// the same shift of ray origins as in computeDistanceMap
+float computeShift( const MeshPart & mp, const MeshToDistanceMapParams & params )
+{
+    if ( !params.allowNegativeValues )
+        return 0;
+    AffineXf3f xf( Matrix3f( params.xRange.normalized(), params.yRange.normalized(), params.direction.normalized() ), Vector3f() );
+    const auto box = mp.mesh.computeBoundingBox( mp.region, &xf );
+    const float shift = dot( params.direction, params.orgPoint - box.min );
+    return shift > 0 ? shift : 0.0f;
+}
+
+/// tolerance in pixels for finding pixels covered by face projections
+constexpr float cPixelEps = 1e-3f;
+
+/// tolerance for barycentric coordinates of ray intersection point
+constexpr float cBaryEps = 1e-6f;
+
+} // anonymous namespace
+
+TiledDistanceMapRenderer::TiledDistanceMapRenderer( const MeshPart & mp, int tileSize )
+    : mp_( mp )
+    , tileSize_( std::max( tileSize, 1 ) )
+{
+}
+
+Box2i TiledDistanceMapRenderer::findFaceTiles_( const View & view, FaceId f ) const
+{
+    Box2f box;
+    for ( auto v : mp_.mesh.topology.getTriVerts( f ) )
+    {
+        const auto p = view.toPixel( mp_.mesh.points[v] );
+        box.include( Vector2f( p.x, p.y ) );
+    }
+    const auto & res = view.params.resolution;
+    // pixel (x,y) is covered if its center (x+0.5,y+0.5) is inside the box
+    const float x0 = std::ceil( box.min.x - 0.5f - cPixelEps );
+    const float y0 = std::ceil( box.min.y - 0.5f - cPixelEps );
+    const float x1 = std::floor( box.max.x - 0.5f + cPixelEps );
+    const float y1 = std::floor( box.max.y - 0.5f + cPixelEps );
+    if ( !( x0 <= x1 && y0 <= y1 && x1 >= 0 && y1 >= 0 && x0 < res.x && y0 < res.y ) )
+        return {};
+    const Vector2i pmin( int( std::max( x0, 0.0f ) ), int( std::max( y0, 0.0f ) ) );
+    const Vector2i pmax( int( std::min( x1, float( res.x - 1 ) ) ), int( std::min( y1, float( res.y - 1 ) ) ) );
+    return Box2i( Vector2i( pmin.x / tileSize_, pmin.y / tileSize_ ), Vector2i( pmax.x / tileSize_, pmax.y / tileSize_ ) );
+}
+
+void TiledDistanceMapRenderer::binFaces_( View & view, const FaceBitSet & faces ) const
+{
+    MR_TIMER;
+    BitSetParallelFor( faces, [&] ( FaceId f )
+    {
+        view.faceTiles[f] = findFaceTiles_( view, f );
+    } );
+    for ( auto f : faces )
+    {
+        const auto & tiles = view.faceTiles[f];
+        if ( !tiles.valid() )
+            continue;
+        for ( int ty = tiles.min.y; ty <= tiles.max.y; ++ty )
+            for ( int tx = tiles.min.x; tx <= tiles.max.x; ++tx )
+                view.tileFaces[size_t( ty ) * view.numTiles.x + tx].push_back( f );
+    }
+}
+
+TiledDistanceMapRenderer::View & TiledDistanceMapRenderer::getView_( const MeshToDistanceMapParams & params )
+{
+    for ( size_t i = 0; i < views_.size(); ++i )
+    {
+        if ( sameProjection( views_[i].params, params ) )
+        {
+            // move the most recently used view in front
+            std::rotate( views_.begin(), views_.begin() + i, views_.begin() + i + 1 );
+            views_.front().params = params; // distance limits can be different
+            return views_.front();
+        }
+    }
+
+    View view;
+    view.params = params;
+    view.toPixel = params.xf().inverse();
+    view.shift = computeShift( mp_, params );
+    view.numTiles = Vector2i( ( params.resolution.x + tileSize_ - 1 ) / tileSize_, ( params.resolution.y + tileSize_ - 1 ) / tileSize_ );
+    view.tileFaces.resize( size_t( view.numTiles.x ) * view.numTiles.y );
+    view.faceTiles.resize( mp_.mesh.topology.faceSize() );
+    binFaces_( view, mp_.mesh.topology.getFaceIds( mp_.region ) );
+
+    views_.insert( views_.begin(), std::move( view ) );
+    if ( views_.size() > maxCachedViews_ )
+        views_.resize( maxCachedViews_ );
+    return views_.front();
+}
+
+bool TiledDistanceMapRenderer::computeTiles_( const View & view, DistanceMap & distMap, const Box2i & pixelRect,
+    const std::vector<int> & tiles, ProgressCallback cb, std::vector<MeshTriPoint> * outSamples ) const
+{
+    MR_TIMER;
+    const auto & params = view.params;
+    const auto & points = mp_.mesh.points;
+    const auto toWorld = params.xf();
+
+    return ParallelFor( size_t( 0 ), tiles.size(), [&] ( size_t i )
+    {
+        const int tile = tiles[i];
+        const int tx = tile % view.numTiles.x;
+        const int ty = tile / view.numTiles.x;
+        const Box2i tileBox( Vector2i( tx * tileSize_, ty * tileSize_ ),
+            Vector2i( std::min( ( tx + 1 ) * tileSize_, params.resolution.x ) - 1, std::min( ( ty + 1 ) * tileSize_, params.resolution.y ) - 1 ) );
+        const auto pix = tileBox.intersection( pixelRect );
+        if ( !pix.valid() )
+            return;
+        const int w = pix.max.x - pix.min.x + 1;
+        const int h = pix.max.y - pix.min.y + 1;
+
+        // all rays of the tile are parallel to z-axis in pixel space, so ray-triangle intersection is a point-in-triangle test
+        std::vector<float> bestKey( size_t( w ) * h, FLT_MAX );
+        std::vector<float> bestDist( size_t( w ) * h );
+        std::vector<FaceId> bestFace( size_t( w ) * h );
+        for ( auto f : view.tileFaces[tile] )
+        {
+            auto [v0, v1, v2] = mp_.mesh.topology.getTriVerts( f );
+            const auto a = view.toPixel( points[v0] );
+            const auto b = view.toPixel( points[v1] );
+            const auto c = view.toPixel( points[v2] );
+            const Vector2f a2( a.x, a.y ), b2( b.x, b.y ), c2( c.x, c.y );
+            const float area = cross( b2 - a2, c2 - a2 );
+            if ( area == 0 )
+                continue; // the triangle is parallel to the rays
+            const float rArea = 1 / area;
+
+            const int x0 = std::max( pix.min.x, int( std::ceil( std::min( { a.x, b.x, c.x } ) - 0.5f - cPixelEps ) ) );
+            const int x1 = std::min( pix.max.x, int( std::floor( std::max( { a.x, b.x, c.x } ) - 0.5f + cPixelEps ) ) );
+            const int y0 = std::max( pix.min.y, int( std::ceil( std::min( { a.y, b.y, c.y } ) - 0.5f - cPixelEps ) ) );
+            const int y1 = std::min( pix.max.y, int( std::floor( std::max( { a.y, b.y, c.y } ) - 0.5f + cPixelEps ) ) );
+            for ( int y = y0; y <= y1; ++y )
+            {
+                for ( int x = x0; x <= x1; ++x )
+                {
+                    const Vector2f p( x + 0.5f, y + 0.5f );
+                    const float w0 = cross( b2 - p, c2 - p ) * rArea;
+                    const float w1 = cross( c2 - p, a2 - p ) * rArea;
+                    const float w2 = 1 - w0 - w1;
+                    if ( w0 < -cBaryEps || w1 < -cBaryEps || w2 < -cBaryEps )
+                        continue;
+                    const float t = w0 * a.z + w1 * b.z + w2 * c.z;
+                    const float key = std::abs( t + view.shift );
+                    const auto k = size_t( y - pix.min.y ) * w + ( x - pix.min.x );
+                    if ( key < bestKey[k] )
+                    {
+                        bestKey[k] = key;
+                        bestDist[k] = t;
+                        bestFace[k] = f;
+                    }
+                }
+            }
+        }
+
+        for ( int y = pix.min.y; y <= pix.max.y; ++y )
+        {
+            for ( int x = pix.min.x; x <= pix.max.x; ++x )
+            {
+                const auto k = size_t( y - pix.min.y ) * w + ( x - pix.min.x );
+                const auto idx = distMap.toIndex( { x, y } );
+                const float t = bestDist[k];
+                // the same condition as in computeDistanceMap, where the limits are applied to the distance from the shifted ray origin
+                const float shiftedT = t + view.shift;
+                if ( !bestFace[k] || !( !params.useDistanceLimits || shiftedT < params.minValue || shiftedT > params.maxValue ) )
+                {
+                    distMap.unset( idx );
+                    continue;
+                }
+                distMap.set( idx, t );
+                if ( outSamples )
+                    ( *outSamples )[idx] = mp_.mesh.toTriPoint( bestFace[k], toWorld( Vector3f( x + 0.5f, y + 0.5f, t ) ) );
+            }
+        }
+    }, cb, 1 );
+}
+
+Expected<DistanceMap> TiledDistanceMapRenderer::compute( const MeshToDistanceMapParams & params, ProgressCallback cb,
+    std::vector<MeshTriPoint> * outSamples )
+{
+    MR_TIMER;
+    const auto & view = getView_( params );
+    if ( !reportProgress( cb, 0.1f ) )
+        return unexpectedOperationCanceled();
+
+    DistanceMap distMap( params.resolution.x, params.resolution.y );
+    if ( outSamples )
+    {
+        outSamples->clear();
+        outSamples->resize( size_t( params.resolution.x ) * params.resolution.y );
+    }
+    std::vector<int> tiles( view.tileFaces.size() );
+    for ( int i = 0; i < tiles.size(); ++i )
+        tiles[i] = i;
+    if ( !computeTiles_( view, distMap, Box2i( Vector2i(), params.resolution - Vector2i::diagonal( 1 ) ), tiles,
+        subprogress( cb, 0.1f, 1.0f ), outSamples ) )
+        return unexpectedOperationCanceled();
+    return distMap;
+}
+
+Expected<void> TiledDistanceMapRenderer::update( DistanceMap & distMap, const MeshToDistanceMapParams & params, const Box2i & pixelRect,
+    ProgressCallback cb )
+{
+    MR_TIMER;
+    if ( distMap.resX() != params.resolution.x || distMap.resY() != params.resolution.y )
+        return unexpected( "Distance map resolution does not match the parameters" );
+
+    const auto rect = pixelRect.intersection( Box2i( Vector2i(), params.resolution - Vector2i::diagonal( 1 ) ) );
+    if ( !rect.valid() )
+        return {};
+
+    const auto & view = getView_( params );
+    std::vector<int> tiles;
+    for ( int ty = rect.min.y / tileSize_; ty <= rect.max.y / tileSize_; ++ty )
+        for ( int tx = rect.min.x / tileSize_; tx <= rect.max.x / tileSize_; ++tx )
+            tiles.push_back( ty * view.numTiles.x + tx );
+    if ( !computeTiles_( view, distMap, rect, tiles, cb, nullptr ) )
+        return unexpectedOperationCanceled();
+    return {};
+}
+
+Expected<void> TiledDistanceMapRenderer::updateFaces( DistanceMap & distMap, const MeshToDistanceMapParams & params, const FaceBitSet & changedFaces,
+    ProgressCallback cb )
+{
+    MR_TIMER;
+    if ( distMap.resX() != params.resolution.x || distMap.resY() != params.resolution.y )
+        return unexpected( "Distance map resolution does not match the parameters" );
+
+    // face lists of other projections become stale
+    std::erase_if( views_, [&] ( const View & v ) { return !sameProjection( v.params, params ); } );
+    if ( views_.empty() )
+    {
+        // previous positions of the faces are unknown, so recompute everything
+        auto res = compute( params, cb );
+        if ( !res )
+            return unexpected( std::move( res.error() ) );
+        distMap = std::move( *res );
+        return {};
+    }
+
+    auto & view = views_.front();
+    view.params = params;
+    view.shift = computeShift( mp_, params );
+
+    // remove changed faces from the tiles where they were
+    std::vector<char> dirty( view.tileFaces.size(), 0 );
+    auto markTiles = [&] ( FaceId f )
+    {
+        if ( f >= view.faceTiles.size() )
+            return;
+        const auto & tiles = view.faceTiles[f];
+        if ( !tiles.valid() )
+            return;
+        for ( int ty = tiles.min.y; ty <= tiles.max.y; ++ty )
+            for ( int tx = tiles.min.x; tx <= tiles.max.x; ++tx )
+                dirty[size_t( ty ) * view.numTiles.x + tx] = 1;
+    };
+    for ( auto f : changedFaces )
+        markTiles( f );
+    ParallelFor( view.tileFaces, [&] ( size_t i )
+    {
+        if ( dirty[i] )
+            std::erase_if( view.tileFaces[i], [&] ( FaceId f ) { return changedFaces.test( f ); } );
+    } );
+
+    // add them in the tiles where they are now
+    const auto faces = changedFaces & mp_.mesh.topology.getFaceIds( mp_.region );
+    view.faceTiles.resize( mp_.mesh.topology.faceSize() );
+    for ( auto f : changedFaces )
+        if ( f < view.faceTiles.size() )
+            view.faceTiles[f] = {};
+    binFaces_( view, faces );
+    for ( auto f : faces )
+        markTiles( f );
+
+    std::vector<int> tiles;
+    for ( int i = 0; i < dirty.size(); ++i )
+        if ( dirty[i] )
+            tiles.push_back( i );
+    if ( !computeTiles_( view, distMap, Box2i( Vector2i(), params.resolution - Vector2i::diagonal( 1 ) ), tiles, cb, nullptr ) )
+        return unexpectedOperationCanceled();
+    return {};
+}
+
+void TiledDistanceMapRenderer::invalidate()
+{
+    views_.clear();
+}
+
+size_t TiledDistanceMapRenderer::heapBytes() const
+{
+    size_t res = views_.capacity() * sizeof( View );
+    for ( const auto & view : views_ )
+    {
+        res += MR::heapBytes( view.tileFaces ) + view.faceTiles.heapBytes();
+        for ( const auto & faces : view.tileFaces )
+            res += MR::heapBytes( faces );
+    }
+    return res;
+}
+
+} // namespace MR
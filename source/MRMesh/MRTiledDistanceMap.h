@@ -0,0 +1,87 @@
+#pragma once
+
+#include "MRDistanceMapParams.h"
+#include "MRMeshPart.h"
+#include "MRExpected.h"
+#include "MRProgressCallback.h"
+#include "MRVector.h"
+#include <vector>
+
+namespace MR
+{
+
+/// \addtogroup DistanceMapGroup
+/// \{
+
+/// computes distance maps of a mesh by square tiles of pixels:
+/// the faces are distributed once in the tiles overlapped by their projections,
+/// and then all rays of a tile (which are parallel) are intersected only with the faces of this tile in parallel with other tiles;
+/// the lists of tile's faces are cached for several last projection parameters,
+/// so repeated computations, computations of sub-rectangles and updates after local changes of the mesh are fast;
+/// the result is the same as of computeDistanceMap up to rounding
+class TiledDistanceMapRenderer
+{
+public:
+    /// the mesh (and the region) must remain alive while this object is used;
+    /// \param tileSize the number of pixels in each side of a square tile
+    MRMESH_API explicit TiledDistanceMapRenderer( const MeshPart & mp, int tileSize = 32 );
+
+    /// computes distance map for given projection parameters
+    /// \param outSamples optional output of the intersection point in every valid pixel
+    MRMESH_API Expected<DistanceMap> compute( const MeshToDistanceMapParams & params, ProgressCallback cb = {},
+        std::vector<MeshTriPoint> * outSamples = nullptr );
+
+    /// recomputes the pixels from pixelRect.min to pixelRect.max inclusive in distance map previously computed with the same parameters
+    MRMESH_API Expected<void> update( DistanceMap & distMap, const MeshToDistanceMapParams & params, const Box2i & pixelRect,
+        ProgressCallback cb = {} );
+
+    /// updates cached lists of faces after given faces have been moved in the mesh (the vertices of these faces changed their positions),
+    /// and recomputes the pixels of affected tiles in distance map previously computed with the same parameters;
+    /// the lists for other cached parameters are dropped
+    MRMESH_API Expected<void> updateFaces( DistanceMap & distMap, const MeshToDistanceMapParams & params, const FaceBitSet & changedFaces,
+        ProgressCallback cb = {} );
+
+    /// drops all cached face lists, e.g. after the topology of the mesh has been changed
+    MRMESH_API void invalidate();
+
+    /// the maximal number of projection parameters with cached face lists
+    void setMaxCachedViews( int n ) { maxCachedViews_ = std::max( n, 1 ); }
+    [[nodiscard]] int getMaxCachedViews() const { return maxCachedViews_; }
+
+    /// returns the amount of memory this object occupies on heap
+    [[nodiscard]] MRMESH_API size_t heapBytes() const;
+
+private:
+    /// cached data for one projection
+    struct View
+    {
+        MeshToDistanceMapParams params;
+        /// from mesh space to pixel space: x and y are pixel coordinates (pixel centers have half-integer coordinates), z is distance along the ray
+        AffineXf3f toPixel;
+        /// as in computeDistanceMap, the intersection closest to the point located this distance behind ray origin is taken
+        float shift = 0;
+        Vector2i numTiles;
+        /// faces with projections overlapping each tile
+        std::vector<std::vector<FaceId>> tileFaces;
+        /// the range of tiles [min, max] overlapped by each face, invalid box if none
+        Vector<Box2i, FaceId> faceTiles;
+    };
+
+    View & getView_( const MeshToDistanceMapParams & params );
+    /// returns the range of tiles overlapped by the projection of given face
+    Box2i findFaceTiles_( const View & view, FaceId f ) const;
+    /// adds given faces in the lists of the tiles they overlap
+    void binFaces_( View & view, const FaceBitSet & faces ) const;
+    bool computeTiles_( const View & view, DistanceMap & distMap, const Box2i & pixelRect, const std::vector<int> & tiles,
+        ProgressCallback cb, std::vector<MeshTriPoint> * outSamples ) const;
+
+    MeshPart mp_;
+    int tileSize_ = 32;
+    int maxCachedViews_ = 4;
+    /// the most recently used view is the first
+    std::vector<View> views_;
+};
+
+/// \}
+
+} // namespace MR
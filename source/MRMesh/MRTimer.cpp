@@ -1,5 +1,6 @@
 #include "MRTimer.h"
 #include "MRTimeRecord.h"
+#include "MRTimerTrace.h"
 #include "MRPch/MRSpdlog.h"
 
 #include <sstream>
@@ -97,6 +98,7 @@ static thread_local TimeRecord* currentRecord = nullptr;
 ThreadRootTimeRecord::ThreadRootTimeRecord( const char * tdName ) : threadName( tdName )
 {
     count = 1;
+    setTimerTraceThreadName( tdName );
 }
 
 void ThreadRootTimeRecord::printTree()
@@ -191,12 +193,19 @@ void Timer::restart( std::string name )
 void Timer::start( const char * name )
 {
     if ( !currentRecord )
+    {
+        // parallel worker threads have no timing tree, but they are traced if requested
+        if ( isTimerTracing() )
+            traceSpan_ = beginTimerSpan( name );
         return; // the name will be thrown away, do not allocate a string for it
+    }
     start( std::string( name ) );
 }
 
 void Timer::start( std::string name )
 {
+    if ( isTimerTracing() )
+        traceSpan_ = beginTimerSpan( name.c_str() );
     auto parent = currentRecord;
     if ( !parent )
         return;
@@ -208,6 +217,11 @@ void Timer::start( std::string name )
 
 void Timer::finish()
 {
+    if ( traceSpan_ >= 0 )
+    {
+        endTimerSpan( traceSpan_ );
+        traceSpan_ = -1;
+    }
     if ( !started_ )
         return;
     started_ = false;
@@ -221,4 +235,10 @@ void Timer::finish()
     currentRecord = currentParent;
 }
 
+void Timer::addCounter( const char * name, double value )
+{
+    if ( traceSpan_ >= 0 )
+        addTimerSpanCounter( traceSpan_, name, value );
+}
+
 } //namespace MR
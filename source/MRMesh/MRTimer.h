@@ -27,6 +27,10 @@ public:
     MRMESH_API void start( const char * name );
     MRMESH_API void finish();
 
+    /// attaches a named value (e.g. bytes processed or number of items) to the current interval of this timer,
+    /// the values with the same name are summed; does nothing if timer tracing is off
+    MRMESH_API void addCounter( const char * name, double value );
+
     Timer( const Timer & ) = delete;
     Timer & operator =( const Timer & ) = delete;
     Timer( Timer && ) = delete;
@@ -37,6 +41,7 @@ public:
 private:
     std::chrono::time_point<std::chrono::high_resolution_clock> start_;
     bool started_{ false };
+    int traceSpan_{ -1 }; ///< index of the span in timer trace if it is on, see MRTimerTrace.h
 };
 
 /// enables or disables printing of timing tree when application terminates
@@ -0,0 +1,310 @@
+#include "MRTimerTrace.h"
+#include "MRStringConvert.h"
+#include "MRPch/MRFmt.h"
+
+#include <atomic>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+
+using namespace std::chrono;
+
+namespace MR
+{
+
+namespace
+{
+
+struct ThreadTraceBuffer
+{
+    /// locked by the owner thread on each modification and by the readers of the trace
+    std::mutex mutex;
+    int index = 0;
+    std::string threadName;
+    std::vector<TimerSpan> spans;
+    /// the innermost running span of the thread
+    int openSpan = -1;
+};
+
+struct TraceRegistry
+{
+    std::atomic<bool> on{ false };
+    /// time_since_epoch of high_resolution_clock when the trace was started
+    std::atomic<std::int64_t> startNs{ 0 };
+    bool started = false;
+
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadTraceBuffer>> buffers;
+};
+
+TraceRegistry & registry()
+{
+    static TraceRegistry r;
+    return r;
+}
+
+thread_local std::shared_ptr<ThreadTraceBuffer> tlsBuffer;
+
+ThreadTraceBuffer & myBuffer()
+{
+    if ( !tlsBuffer )
+    {
+        auto buf = std::make_shared<ThreadTraceBuffer>();
+        auto & r = registry();
+        std::lock_guard lock( r.mutex );
+        buf->index = (int)r.buffers.size();
+        buf->threadName = fmt::format( "Thread {}", buf->index );
+        r.buffers.push_back( buf );
+        tlsBuffer = std::move( buf );
+    }
+    return *tlsBuffer;
+}
+
+nanoseconds sinceTraceStart()
+{
+    return duration_cast<nanoseconds>( high_resolution_clock::now().time_since_epoch() )
+        - nanoseconds( registry().startNs.load( std::memory_order_relaxed ) );
+}
+
+void writeJsonString( std::ostream & out, std::string_view s )
+{
+    out << '"';
+    for ( char c : s )
+    {
+        switch ( c )
+        {
+        case '"':  out << "\\\""; break;
+        case '\\': out << "\\\\"; break;
+        case '\n': out << "\\n"; break;
+        case '\r': out << "\\r"; break;
+        case '\t': out << "\\t"; break;
+        default:
+            if ( (unsigned char)c < 0x20 )
+                out << fmt::format( "\\u{:04x}", (int)c );
+            else
+                out << c;
+        }
+    }
+    out << '"';
+}
+
+// folded-stack format uses ';' as frame separator and ' ' before the value
+std::string foldedFrameName( std::string name )
+{
+    for ( auto & c : name )
+        if ( c == ';' || c == '\n' )
+            c = ',';
+    return name;
+}
+
+} // anonymous namespace
+
+void setTimerTracing( bool on )
+{
+    auto & r = registry();
+    std::lock_guard lock( r.mutex );
+    if ( on && !r.started )
+    {
+        r.startNs = duration_cast<nanoseconds>( high_resolution_clock::now().time_since_epoch() ).count();
+        r.started = true;
+    }
+    r.on = on;
+}
+
+bool isTimerTracing()
+{
+    return registry().on.load( std::memory_order_relaxed );
+}
+
+void setTimerTraceThreadName( std::string name )
+{
+    auto & buf = myBuffer();
+    std::lock_guard lock( buf.mutex );
+    buf.threadName = std::move( name );
+}
+
+void clearTimerTrace()
+{
+    auto & r = registry();
+    std::lock_guard lock( r.mutex );
+    for ( const auto & buf : r.buffers )
+    {
+        std::lock_guard bufLock( buf->mutex );
+        buf->spans.clear();
+        buf->openSpan = -1;
+    }
+    r.started = false;
+    if ( r.on )
+    {
+        r.startNs = duration_cast<nanoseconds>( high_resolution_clock::now().time_since_epoch() ).count();
+        r.started = true;
+    }
+}
+
+std::vector<TimerThreadTrace> getTimerTrace()
+{
+    std::vector<TimerThreadTrace> res;
+    auto & r = registry();
+    std::lock_guard lock( r.mutex );
+    res.reserve( r.buffers.size() );
+    for ( const auto & buf : r.buffers )
+    {
+        std::lock_guard bufLock( buf->mutex );
+        res.push_back( { buf->threadName, buf->spans } );
+    }
+    return res;
+}
+
+Expected<void> saveTimerTraceJson( std::ostream & out )
+{
+    const auto trace = getTimerTrace();
+    out << "{\"traceEvents\":[";
+    bool first = true;
+    auto nextEvent = [&]
+    {
+        out << ( first ? "\n" : ",\n" );
+        first = false;
+    };
+    for ( int t = 0; t < trace.size(); ++t )
+    {
+        const auto & thread = trace[t];
+        if ( thread.spans.empty() )
+            continue;
+        nextEvent();
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << t << ",\"args\":{\"name\":";
+        writeJsonString( out, thread.threadName );
+        out << "}}";
+        for ( const auto & span : thread.spans )
+        {
+            nextEvent();
+            out << "{\"name\":";
+            writeJsonString( out, span.name );
+            out << fmt::format( ",\"cat\":\"timer\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}",
+                t, span.start.count() * 1e-3, span.duration.count() * 1e-3 );
+            if ( !span.counters.empty() )
+            {
+                out << ",\"args\":{";
+                for ( int i = 0; i < span.counters.size(); ++i )
+                {
+                    if ( i > 0 )
+                        out << ',';
+                    writeJsonString( out, span.counters[i].first );
+                    out << ':' << fmt::format( "{}", span.counters[i].second );
+                }
+                out << '}';
+            }
+            out << '}';
+        }
+    }
+    out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    if ( !out )
+        return unexpected( std::string( "Error saving timer trace" ) );
+    return {};
+}
+
+Expected<void> saveTimerTraceJson( const std::filesystem::path & file )
+{
+    std::ofstream out( file, std::ofstream::binary );
+    if ( !out )
+        return unexpected( std::string( "Cannot open file for writing " ) + utf8string( file ) );
+
+    return saveTimerTraceJson( out );
+}
+
+Expected<void> saveTimerTraceFolded( std::ostream & out )
+{
+    const auto trace = getTimerTrace();
+    // self time in nanoseconds for each unique stack
+    std::map<std::string, std::int64_t> stacks;
+    for ( const auto & thread : trace )
+    {
+        const auto & spans = thread.spans;
+        std::vector<std::string> paths( spans.size() );
+        std::vector<std::int64_t> selfNs( spans.size() );
+        for ( int i = 0; i < spans.size(); ++i )
+        {
+            const auto & span = spans[i];
+            selfNs[i] += span.duration.count();
+            // parent spans are always recorded before their children
+            if ( span.parent >= 0 )
+            {
+                selfNs[span.parent] -= span.duration.count();
+                paths[i] = paths[span.parent] + ';' + foldedFrameName( span.name );
+            }
+            else
+                paths[i] = foldedFrameName( thread.threadName ) + ';' + foldedFrameName( span.name );
+        }
+        for ( int i = 0; i < spans.size(); ++i )
+            stacks[paths[i]] += selfNs[i];
+    }
+
+    for ( const auto & [path, ns] : stacks )
+    {
+        const auto us = ( ns + 500 ) / 1000;
+        if ( us > 0 )
+            out << path << ' ' << us << '\n';
+    }
+
+    if ( !out )
+        return unexpected( std::string( "Error saving timer trace" ) );
+    return {};
+}
+
+Expected<void> saveTimerTraceFolded( const std::filesystem::path & file )
+{
+    std::ofstream out( file, std::ofstream::binary );
+    if ( !out )
+        return unexpected( std::string( "Cannot open file for writing " ) + utf8string( file ) );
+
+    return saveTimerTraceFolded( out );
+}
+
+int beginTimerSpan( const char * name )
+{
+    auto & buf = myBuffer();
+    const auto start = sinceTraceStart();
+    std::lock_guard lock( buf.mutex );
+    const int res = (int)buf.spans.size();
+    auto & span = buf.spans.emplace_back();
+    span.name = name;
+    span.thread = buf.index;
+    span.parent = buf.openSpan;
+    span.start = start;
+    buf.openSpan = res;
+    return res;
+}
+
+void endTimerSpan( int span )
+{
+    const auto finish = sinceTraceStart();
+    auto & buf = myBuffer();
+    std::lock_guard lock( buf.mutex );
+    if ( span < 0 || span >= buf.spans.size() )
+        return; // the trace was cleared while the timer was running
+    auto & s = buf.spans[span];
+    s.duration = finish - s.start;
+    buf.openSpan = s.parent;
+}
+
+void addTimerSpanCounter( int span, const char * name, double value )
+{
+    auto & buf = myBuffer();
+    std::lock_guard lock( buf.mutex );
+    if ( span < 0 || span >= buf.spans.size() )
+        return;
+    auto & counters = buf.spans[span].counters;
+    for ( auto & c : counters )
+    {
+        if ( c.first == name )
+        {
+            c.second += value;
+            return;
+        }
+    }
+    counters.emplace_back( name, value );
+}
+
+} // namespace MR
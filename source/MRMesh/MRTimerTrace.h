@@ -0,0 +1,77 @@
+#pragma once
+
+#include "MRMeshFwd.h"
+#include "MRExpected.h"
+#include "MRPch/MRBindingMacros.h"
+#include <chrono>
+#include <filesystem>
+#include <iosfwd>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace MR
+{
+
+/// \addtogroup BasicGroup
+/// \{
+
+/// one interval of some Timer recorded while timer tracing was on
+struct MR_BIND_IGNORE TimerSpan
+{
+    std::string name;
+    /// sequential index of the thread where the timer was running, 0 is given to the first traced thread
+    int thread = 0;
+    /// index of the enclosing span in the same thread (in TimerThreadTrace::spans returned by getTimerTrace), or -1 for top-level spans
+    int parent = -1;
+    /// start time measured from the moment when tracing was switched on
+    std::chrono::nanoseconds start{ 0 };
+    /// time between start and finish of the timer, zero if the timer is still running
+    std::chrono::nanoseconds duration{ 0 };
+    /// user counters attached via Timer::addCounter (e.g. bytes processed, number of items)
+    std::vector<std::pair<std::string, double>> counters;
+};
+
+/// name of one traced thread and its spans
+struct MR_BIND_IGNORE TimerThreadTrace
+{
+    std::string threadName;
+    std::vector<TimerSpan> spans;
+};
+
+/// starts or stops recording of all timer intervals in all threads including parallel worker threads;
+/// unlike timing tree, tracing preserves each interval separately together with its start time and counters;
+/// the recorded spans are kept after tracing is stopped until clearTimerTrace() is called
+MRMESH_API void setTimerTracing( bool on );
+
+/// returns true if timer tracing is on now
+[[nodiscard]] MRMESH_API bool isTimerTracing();
+
+/// sets the name of current thread in the trace, by default the threads are named "Thread N"
+MRMESH_API void setTimerTraceThreadName( std::string name );
+
+/// removes all recorded spans, it must be called when no traced timer is running
+MRMESH_API void clearTimerTrace();
+
+/// returns a copy of all recorded spans grouped by threads
+[[nodiscard]] MR_BIND_IGNORE MRMESH_API std::vector<TimerThreadTrace> getTimerTrace();
+
+/// writes recorded spans in Chrome trace-event JSON format, which can be opened in chrome://tracing, Perfetto or Speedscope
+MR_BIND_IGNORE MRMESH_API Expected<void> saveTimerTraceJson( std::ostream & out );
+MRMESH_API Expected<void> saveTimerTraceJson( const std::filesystem::path & file );
+
+/// writes recorded spans in folded-stack format ("thread;outer;inner self_microseconds" per line),
+/// which is the input of flamegraph.pl and Speedscope
+MR_BIND_IGNORE MRMESH_API Expected<void> saveTimerTraceFolded( std::ostream & out );
+MRMESH_API Expected<void> saveTimerTraceFolded( const std::filesystem::path & file );
+
+/// low-level functions used by Timer: starts a new span in current thread and returns its index
+[[nodiscard]] MR_BIND_IGNORE MRMESH_API int beginTimerSpan( const char * name );
+/// finishes given span started in current thread
+MR_BIND_IGNORE MRMESH_API void endTimerSpan( int span );
+/// adds a counter to given span started in current thread
+MR_BIND_IGNORE MRMESH_API void addTimerSpanCounter( int span, const char * name, double value );
+
+/// \}
+
+} // namespace MR
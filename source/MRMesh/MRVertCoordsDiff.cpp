@@ -4,6 +4,8 @@
 #include "MRTimer.h"
 #include "MRHeapBytes.h"
 #include "MRId.h"
+#include <istream>
+#include <ostream>
 
 namespace MR
 {
@@ -55,4 +57,36 @@ size_t VertCoordsDiff::heapBytes() const
     return MR::heapBytes( changedPoints_ );
 }
 
+void VertCoordsDiff::write( std::ostream & s ) const
+{
+    const std::uint64_t header[2] = { toPointsSize_, changedPoints_.size() };
+    s.write( (const char*)header, sizeof( header ) );
+    for ( const auto & [v, pos] : changedPoints_ )
+    {
+        s.write( (const char*)&v, sizeof( v ) );
+        s.write( (const char*)&pos, sizeof( pos ) );
+    }
+}
+
+Expected<void> VertCoordsDiff::read( std::istream & s )
+{
+    std::uint64_t header[2] = {};
+    if ( !s.read( (char*)header, sizeof( header ) ) )
+        return unexpected( "Cannot read coordinates difference" );
+    toPointsSize_ = header[0];
+    changedPoints_.clear();
+    changedPoints_.reserve( header[1] );
+    for ( std::uint64_t i = 0; i < header[1]; ++i )
+    {
+        VertId v;
+        Vector3f pos;
+        s.read( (char*)&v, sizeof( v ) );
+        s.read( (char*)&pos, sizeof( pos ) );
+        if ( !s )
+            return unexpected( "Cannot read coordinates difference" );
+        changedPoints_[v] = pos;
+    }
+    return {};
+}
+
 } // namespace MR
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "MRphmap.h"
+#include "MRExpected.h"
+#include <iosfwd>
 
 namespace MR
 {
@@ -29,6 +31,12 @@ public:
     /// returns the amount of memory this object occupies on heap
     [[nodiscard]] MRMESH_API size_t heapBytes() const;
 
+    /// saves in binary stream
+    MRMESH_API void write( std::ostream & s ) const;
+
+    /// loads from binary stream
+    MRMESH_API Expected<void> read( std::istream & s );
+
 private:
     size_t toPointsSize_ = 0;
     HashMap<VertId, Vector3f> changedPoints_;
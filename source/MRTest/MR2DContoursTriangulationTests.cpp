@@ -383,6 +383,52 @@ void runBench( const char* name, size_t nverts, int warmup, int iters, const std
 
 } // anonymous namespace
 
+TEST( MRMesh, PlanarTriangulationParallel )
+{
+    auto square = [] ( Vector2f c, float r, bool ccw )
+    {
+        Contour2f cont{ c + Vector2f( -r, -r ), c + Vector2f( r, -r ), c + Vector2f( r, r ), c + Vector2f( -r, r ) };
+        if ( !ccw )
+            std::reverse( cont.begin(), cont.end() );
+        cont.push_back( cont.front() );
+        return cont;
+    };
+
+    // grid of squares with holes, and two crossing squares in the last cell
+    Contours2f contours;
+    for ( int x = 0; x < 3; ++x )
+    {
+        for ( int y = 0; y < 3; ++y )
+        {
+            const Vector2f c( 3.0f * x, 3.0f * y );
+            contours.push_back( square( c, 1.0f, true ) );
+            contours.push_back( square( c, 0.5f, false ) );
+        }
+    }
+    contours.push_back( square( Vector2f( 9.0f, 9.0f ), 1.0f, true ) );
+    contours.push_back( square( Vector2f( 9.5f, 9.5f ), 1.0f, true ) );
+
+    Vector<int, FaceId> seqWinding, parWinding;
+    PlanarTriangulation::IntersectionsMap seqInter, parInter;
+    const auto seq = PlanarTriangulation::triangulateContours( contours, { .outFaceWinding = &seqWinding, .outInterMap = &seqInter } );
+    const auto par = PlanarTriangulation::triangulateContoursParallel( contours, { .outFaceWinding = &parWinding, .outInterMap = &parInter } );
+
+    EXPECT_EQ( par.topology.numValidFaces(), seq.topology.numValidFaces() );
+    EXPECT_NEAR( par.area(), seq.area(), 1e-4 );
+    EXPECT_EQ( parWinding.size(), par.topology.faceSize() );
+    EXPECT_EQ( parInter.shift, seqInter.shift );
+    EXPECT_EQ( parInter.map.size(), seqInter.map.size() );
+    for ( VertId v( 0 ); v < parInter.shift; ++v )
+        EXPECT_LT( ( par.points[v] - seq.points[v] ).length(), 1e-5f ); // only rounding can differ
+    EXPECT_TRUE( par.topology.checkValidity() );
+
+    auto batch = PlanarTriangulation::triangulateContoursBatch( std::vector<Contours2f>( 4, contours ) );
+    ASSERT_TRUE( batch.has_value() );
+    ASSERT_EQ( batch->size(), 4 );
+    for ( const auto& m : *batch )
+        EXPECT_EQ( m.topology.numValidFaces(), seq.topology.numValidFaces() );
+}
+
 // local A/B benchmark for the SweepLineQueue predicate refactor; opt-in:
 //   MRTest.exe --gtest_also_run_disabled_tests --gtest_filter=*PlanarTriangulationBench*
 // Order matters for interleaved (DLL-swap) A/B: the priority sort-bound workload runs
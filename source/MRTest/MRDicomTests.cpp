@@ -36,6 +36,52 @@ TEST( MRMesh, DicomSaveLoad )
         EXPECT_EQ( a.data[i], b.data[i] );
 }
 
+TEST( MRMesh, DicomFolderDenseLoad )
+{
+    const Vector3i dims{ 5, 4, 6 };
+    const int sliceSize = dims.x * dims.y;
+    UniqueTemporaryFolder tmpFolder;
+    for ( int z = 0; z < dims.z; ++z )
+    {
+        SimpleVolumeU16 slice
+        {
+            .dims = { dims.x, dims.y, 1 },
+            .voxelSize = { 1.f, 1.f, 1.f }
+        };
+        for ( int i = 0; i < sliceSize; ++i )
+            slice.data.push_back( uint16_t( 100 * z + i ) );
+        auto saveRes = VoxelsSave::toDicom( slice, tmpFolder / ( "slice" + std::to_string( z ) + ".dcm" ), MinMaxf{ 0, 65535 } );
+        ASSERT_TRUE( saveRes.has_value() );
+    }
+
+    auto dense = VoxelsLoad::loadDicomFolderDense( tmpFolder );
+    ASSERT_TRUE( dense.has_value() );
+    auto dense16 = VoxelsLoad::loadDicomFolderDenseU16( tmpFolder );
+    ASSERT_TRUE( dense16.has_value() );
+    EXPECT_EQ( dense->vol.dims, dims );
+    EXPECT_EQ( dense16->vol.dims, dims );
+    EXPECT_NEAR( dense16->sourceScale.min, 0.f, 1e-3f );
+    EXPECT_NEAR( dense16->sourceScale.max, 65535.f, 1e-1f );
+    for ( size_t n = 0; n < dense->vol.data.size(); ++n )
+    {
+        const auto expected = uint16_t( 100 * ( n / sliceSize ) + n % sliceSize );
+        EXPECT_EQ( dense->vol.data[VoxelId( n )], float( expected ) );
+        EXPECT_EQ( dense16->vol.data[VoxelId( n )], expected );
+    }
+    EXPECT_EQ( dense->vol.min, 0.f );
+    EXPECT_EQ( dense->vol.max, float( 100 * ( dims.z - 1 ) + sliceSize - 1 ) );
+
+    VoxelsLoad::DicomFolderLoadSettings settings;
+    settings.downsample = 2;
+    auto half = VoxelsLoad::loadDicomFolderDense( tmpFolder, settings );
+    ASSERT_TRUE( half.has_value() );
+    EXPECT_EQ( half->vol.dims, Vector3i( 3, 2, 3 ) );
+    // the average of 2x2x2 block
+    EXPECT_EQ( half->vol.data[0_vox], ( 0 + 1 + 5 + 6 + 100 + 101 + 105 + 106 ) / 8.f );
+    // the average of incomplete 1x2x2 block
+    EXPECT_EQ( half->vol.data[2_vox], ( 4 + 9 + 104 + 109 ) / 4.f );
+}
+
 } //namespace MR
 
 #endif //!MRVOXELS_NO_DICOM
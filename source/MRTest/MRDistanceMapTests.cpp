@@ -8,6 +8,10 @@
 #include <MRMesh/MRVector.h>
 #include <MRMesh/MRMeshIntersect.h>
 #include <MRMesh/MRLine3.h>
+#include <MRMesh/MRTiledDistanceMap.h>
+#include <MRMesh/MRMesh.h>
+#include <MRMesh/MRBitSet.h>
+#include <MRMesh/MRRegionBoundary.h>
 
 namespace MR
 {
@@ -336,4 +340,98 @@ TEST( MRMesh, DistanceMapInterpolation )
     }
 }
 
+TEST( MRMesh, DistanceMapTiled )
+{
+    Mesh sphere = makeUVSphere( 1, 50, 50 );
+    AffineXf3f xf( Matrix3f(), Vector3f( -1.2f, -1.2f, -2.f ) );
+    MeshToDistanceMapParams params( xf, Vector2f{ 0.02f, 0.02f }, Vector2i{ 120, 120 } );
+
+    auto sameMaps = [] ( const DistanceMap & a, const DistanceMap & b )
+    {
+        if ( a.resX() != b.resX() || a.resY() != b.resY() )
+            return false;
+        for ( size_t i = 0; i < a.size(); ++i )
+            if ( a.get( i ) != b.get( i ) )
+                return false;
+        return true;
+    };
+
+    const auto ref = computeDistanceMap( sphere, params );
+    TiledDistanceMapRenderer renderer( sphere, 16 );
+    auto dm = renderer.compute( params );
+    ASSERT_TRUE( dm.has_value() );
+
+    int numDifferentValidity = 0;
+    for ( int y = 0; y < ref.resY(); y++ )
+    {
+        for ( int x = 0; x < ref.resX(); x++ )
+        {
+            const auto v1 = ref.get( x, y );
+            const auto v2 = dm->get( x, y );
+            if ( bool( v1 ) != bool( v2 ) )
+            {
+                ++numDifferentValidity; // possible only for the rays touching the silhouette
+            }
+            else if ( v1 )
+            {
+                EXPECT_NEAR( *v1, *v2, 1e-4f );
+            }
+        }
+    }
+    EXPECT_LE( numDifferentValidity, 4 );
+
+    // recompute a sub-rectangle
+    auto partial = *dm;
+    for ( int y = 30; y <= 70; y++ )
+        for ( int x = 20; x <= 50; x++ )
+            partial.unset( x, y );
+    EXPECT_TRUE( renderer.update( partial, params, Box2i( Vector2i( 20, 30 ), Vector2i( 50, 70 ) ) ).has_value() );
+    EXPECT_TRUE( sameMaps( partial, *dm ) );
+
+    // move some vertices and update only affected tiles
+    VertBitSet movedVerts( sphere.topology.vertSize() );
+    for ( auto v : sphere.topology.getValidVerts() )
+        if ( sphere.points[v].z < -0.8f && sphere.points[v].x > 0 )
+            movedVerts.set( v );
+    for ( auto v : movedVerts )
+        sphere.points[v].z -= 0.1f;
+    sphere.invalidateCaches();
+    EXPECT_TRUE( renderer.updateFaces( *dm, params, getIncidentFaces( sphere.topology, movedVerts ) ).has_value() );
+
+    TiledDistanceMapRenderer freshRenderer( sphere, 16 );
+    const auto full = freshRenderer.compute( params );
+    ASSERT_TRUE( full.has_value() );
+    EXPECT_TRUE( sameMaps( *full, *dm ) );
+
+    // ray origins inside the mesh are shifted back, and the distance limits are applied before the shift is subtracted
+    MeshToDistanceMapParams limitedParams( AffineXf3f( Matrix3f(), Vector3f( -1.2f, -1.2f, 0.f ) ), Vector2f{ 0.02f, 0.02f }, Vector2i{ 120, 120 } );
+    limitedParams.allowNegativeValues = true;
+    limitedParams.setDistanceLimits( 0.5f, 1.5f );
+    const auto limitedRef = computeDistanceMap( sphere, limitedParams );
+    const auto limited = freshRenderer.compute( limitedParams );
+    ASSERT_TRUE( limited.has_value() );
+
+    int numLimitedValid = 0;
+    numDifferentValidity = 0;
+    for ( int y = 0; y < limitedRef.resY(); y++ )
+    {
+        for ( int x = 0; x < limitedRef.resX(); x++ )
+        {
+            const auto v1 = limitedRef.get( x, y );
+            const auto v2 = limited->get( x, y );
+            if ( bool( v1 ) != bool( v2 ) )
+            {
+                ++numDifferentValidity; // possible only for the rays touching the silhouette or hitting the mesh at the limits
+            }
+            else if ( v1 )
+            {
+                ++numLimitedValid;
+                EXPECT_NEAR( *v1, *v2, 1e-4f );
+            }
+        }
+    }
+    EXPECT_GT( numLimitedValid, 0 );
+    EXPECT_LE( numDifferentValidity, 8 );
+}
+
 }
@@ -5,6 +5,8 @@
 #include <MRMesh/MRCube.h>
 #include <MRMesh/MRLineSegm.h>
 #include <MRMesh/MRPlane3.h>
+#include <MRMesh/MRTorus.h>
+#include <MRMesh/MRBitSet.h>
 
 namespace MR
 {
@@ -155,6 +157,29 @@ TEST( MRMesh, ExtractXYPlaneSections )
     EXPECT_EQ( findTriangleSectionsByXYPlane( mesh, testLevel, nullptr, UseAABBTree::Yes ).size(), 6 );
 }
 
+TEST( MRMesh, ExtractXYPlaneSectionsMultiple )
+{
+    Mesh mesh = makeTorus( 1.0f, 0.3f, 32, 16 );
+    // unsorted levels with repetitions and levels outside of the mesh
+    std::vector<float> zLevels{ 0.1f, -0.5f, 0.0f, 0.25f, -0.2f, 0.1f, 0.5f, 0.29f };
+    for ( int i = 0; i < 20; ++i )
+        zLevels.push_back( -0.3f + 0.03f * i );
+
+    auto res = extractXYPlaneSections( mesh, zLevels );
+    ASSERT_TRUE( res.has_value() );
+    ASSERT_EQ( res->size(), zLevels.size() );
+    for ( int i = 0; i < zLevels.size(); ++i )
+        EXPECT_EQ( ( *res )[i], extractXYPlaneSections( mesh, zLevels[i], UseAABBTree::No ) );
+
+    FaceBitSet region( mesh.topology.faceSize() );
+    for ( FaceId f( 0 ); f < region.size(); f += 2 )
+        region.set( f );
+    res = extractXYPlaneSections( MeshPart( mesh, &region ), zLevels );
+    ASSERT_TRUE( res.has_value() );
+    for ( int i = 0; i < zLevels.size(); ++i )
+        EXPECT_EQ( ( *res )[i], extractXYPlaneSections( MeshPart( mesh, &region ), zLevels[i], UseAABBTree::Yes ) );
+}
+
 TEST( MRMesh, TrackPlaneSection )
 {
     const Mesh mesh = MR::makeCube( Vector3f::diagonal( 1.F ), Vector3f::diagonal( -0.5F ) );
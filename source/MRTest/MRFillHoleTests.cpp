@@ -3,6 +3,8 @@
 #include <MRMesh/MRMeshBuilder.h>
 #include <MRMesh/MRMeshFixer.h>
 #include <MRMesh/MRRingIterator.h>
+#include <MRMesh/MRCylinder.h>
+#include <MRMesh/MRMakeSphereMesh.h>
 #include <gtest/gtest.h>
 
 namespace MR
@@ -320,4 +322,77 @@ TEST( MRMesh, HoleFillPlanSymAnchorMultipleEdge )
     EXPECT_FALSE( isFillingMultipleEdgeFree( mesh.topology, plan ) );
 }
 
+TEST( MRMesh, FillHolesParallel )
+{
+    Mesh mesh = makeUVSphere( 1.0f, 32, 32 );
+    FaceBitSet toDelete( mesh.topology.faceSize() );
+    for ( FaceId f( 0 ); f < toDelete.size(); f += 11 )
+        toDelete.set( f );
+    mesh.topology.deleteFaces( toDelete );
+    auto holes = mesh.topology.findHoleRepresentiveEdges();
+    EXPECT_GT( holes.size(), 10 );
+
+    Mesh seqMesh = mesh;
+    for ( auto e : holes )
+        fillHole( seqMesh, e );
+
+    const auto numFaces0 = mesh.topology.numValidFaces();
+    FaceBitSet newFaces;
+    FillHoleParams params;
+    params.outNewFaces = &newFaces;
+    fillHoles( mesh, holes, params );
+    EXPECT_EQ( mesh.topology.findNumHoles(), 0 );
+    EXPECT_EQ( mesh.topology.numValidFaces(), seqMesh.topology.numValidFaces() );
+    EXPECT_EQ( newFaces.count(), mesh.topology.numValidFaces() - numFaces0 );
+    EXPECT_TRUE( mesh.topology.checkValidity() );
+}
+
+TEST( MRMesh, FillLongHoleApproximately )
+{
+    const int n = 256;
+    Mesh mesh = makeOpenCylinder( 1.0f, -1.0f, 1.0f, n );
+    const auto numFaces0 = mesh.topology.numValidFaces();
+    auto holes = mesh.topology.findHoleRepresentiveEdges();
+    ASSERT_EQ( holes.size(), 2 );
+
+    FillHoleParams params;
+    params.maxExactHoleSize = 32;
+    fillHole( mesh, holes[0], params );
+    fillHoles( mesh, { holes[1] }, params );
+    EXPECT_EQ( mesh.topology.findNumHoles(), 0 );
+    EXPECT_EQ( mesh.topology.numValidFaces(), numFaces0 + 2 * ( n - 2 ) );
+    EXPECT_TRUE( mesh.topology.checkValidity() );
+}
+
+TEST( MRMesh, FillLongHoleApproximatelyExistingChord )
+{
+    // narrow strip of quads, its boundary is one hole where the closest chords between opposite sides are the existing rungs of the strip
+    const int numQuads = 62;
+    VertCoords points;
+    Triangulation t;
+    for ( int k = 0; k <= numQuads; ++k )
+    {
+        points.push_back( Vector3f( float( k ), 0.0f, 0.0f ) ); // bottom vertex 2k
+        points.push_back( Vector3f( float( k ), 0.1f, 0.0f ) ); // top vertex 2k+1
+        if ( k == numQuads )
+            break;
+        const VertId b0( 2 * k ), t0( 2 * k + 1 ), b1( 2 * k + 2 ), t1( 2 * k + 3 );
+        t.push_back( { b0, b1, t1 } );
+        t.push_back( { b0, t1, t0 } );
+    }
+    Mesh mesh = Mesh::fromTriangles( std::move( points ), t );
+    const auto numFaces0 = mesh.topology.numValidFaces();
+    auto holes = mesh.topology.findHoleRepresentiveEdges();
+    ASSERT_EQ( holes.size(), 1 );
+    const int holeSize = 2 * numQuads + 2;
+
+    FillHoleParams params;
+    params.maxExactHoleSize = 16;
+    fillHole( mesh, holes[0], params );
+    EXPECT_EQ( mesh.topology.findNumHoles(), 0 );
+    EXPECT_EQ( mesh.topology.numValidFaces(), numFaces0 + holeSize - 2 );
+    EXPECT_FALSE( hasMultipleEdges( mesh.topology ) );
+    EXPECT_TRUE( mesh.topology.checkValidity() );
+}
+
 } //namespace MR
@@ -2,6 +2,7 @@
 #include <MRMesh/MRMesh.h>
 #include <MRMesh/MRTorus.h>
 #include <MRMesh/MRBitSet.h>
+#include <MRMesh/MRAffineXf3.h>
 #include <gtest/gtest.h>
 
 namespace MR
@@ -29,4 +30,73 @@ TEST( MRMesh, FixSelfIntersections )
     EXPECT_EQ( intersections->count(), 0 );
 }
 
+TEST( MRMesh, FixSelfIntersectionsParallelRegions )
+{
+    const Mesh torus = makeTorusWithSelfIntersections( 1.0f, 0.2f, 32, 16 );
+    Mesh mesh = torus;
+    Mesh shifted = torus;
+    shifted.transform( AffineXf3f::translation( Vector3f( 5.0f, 0.0f, 0.0f ) ) );
+    mesh.addMesh( shifted );
+
+    auto intersections = SelfIntersections::getFaces( mesh, false );
+    EXPECT_TRUE( intersections.has_value() );
+    EXPECT_EQ( intersections->count(), 256 );
+
+    std::vector<SelfIntersections::RegionReport> reports;
+    SelfIntersections::Settings settings;
+    settings.method = SelfIntersections::Settings::Method::CutAndFill;
+    settings.touchIsIntersection = false;
+    settings.parallelRegions = true;
+    settings.outRegionReports = &reports;
+    EXPECT_TRUE( SelfIntersections::fix( mesh, settings ).has_value() );
+
+    ASSERT_EQ( reports.size(), 2 );
+    for ( const auto & r : reports )
+    {
+        EXPECT_EQ( r.numBadFaces, 128 );
+        EXPECT_GE( r.seconds, 0.0 );
+    }
+    EXPECT_FALSE( reports[0].box.intersects( reports[1].box ) );
+
+    intersections = SelfIntersections::getFaces( mesh, false );
+    EXPECT_TRUE( intersections.has_value() );
+    EXPECT_EQ( intersections->count(), 0 );
+    EXPECT_TRUE( mesh.topology.checkValidity() );
+}
+
+TEST( MRMesh, FixSelfIntersectionsParallelRegionsOpenMesh )
+{
+    const int primaryResolution = 32, secondaryResolution = 64;
+    Mesh mesh = makeTorusWithSelfIntersections( 1.0f, 0.2f, primaryResolution, secondaryResolution );
+
+    // delete one row of quads between the self-intersections, so the region around them reaches the boundary of the mesh
+    const int holeRow = 25;
+    FaceBitSet rowFaces( mesh.topology.faceSize() );
+    for ( int f = 2 * holeRow * primaryResolution; f < 2 * ( holeRow + 1 ) * primaryResolution; ++f )
+        rowFaces.set( FaceId( f ) );
+    mesh.deleteFaces( rowFaces );
+    EXPECT_EQ( mesh.topology.findNumHoles(), 2 );
+
+    auto intersections = SelfIntersections::getFaces( mesh, false );
+    EXPECT_TRUE( intersections.has_value() );
+    EXPECT_GT( intersections->count(), 0 );
+
+    std::vector<SelfIntersections::RegionReport> reports;
+    SelfIntersections::Settings settings;
+    settings.method = SelfIntersections::Settings::Method::CutAndFill;
+    settings.touchIsIntersection = false;
+    settings.parallelRegions = true;
+    settings.outRegionReports = &reports;
+    EXPECT_TRUE( SelfIntersections::fix( mesh, settings ).has_value() );
+
+    ASSERT_EQ( reports.size(), 1 );
+    EXPECT_TRUE( reports[0].merged );
+
+    intersections = SelfIntersections::getFaces( mesh, false );
+    EXPECT_TRUE( intersections.has_value() );
+    EXPECT_EQ( intersections->count(), 0 );
+    EXPECT_TRUE( mesh.topology.checkValidity() );
+    EXPECT_EQ( mesh.topology.findNumHoles(), 2 );
+}
+
 } //namespace MR
@@ -0,0 +1,83 @@
+#include <MRMesh/MRGcodeProcessor.h>
+#include <gtest/gtest.h>
+#include <sstream>
+
+namespace MR
+{
+
+TEST( MRMesh, GcodeProcessorStreaming )
+{
+    GcodeSource source;
+    source.push_back( "G21 G90 G17" );
+    source.push_back( "G0 X0 Y0 Z10" );
+    source.push_back( "G1 Z0 F200 ; plunge" );
+    for ( int i = 0; i < 50; ++i )
+    {
+        source.push_back( "G1 X" + std::to_string( i ) + " Y" + std::to_string( i % 7 ) + " F" + std::to_string( 300 + i ) );
+        source.push_back( "G2 X" + std::to_string( i + 1 ) + " Y" + std::to_string( i % 7 ) + " I0.5 J0" );
+        source.push_back( "(comment only)" );
+    }
+    source.push_back( "G91" );
+    source.push_back( "G0 Z5" );
+    source.push_back( "G28" );
+
+    GcodeProcessor whole;
+    whole.setGcodeSource( source );
+    const auto expected = whole.processSource();
+    ASSERT_EQ( expected.size(), source.size() );
+
+    auto checkBatch = [&]( size_t firstLine, const std::vector<GcodeProcessor::MoveAction> & actions )
+    {
+        EXPECT_LE( firstLine + actions.size(), expected.size() );
+        for ( size_t i = 0; i < actions.size() && firstLine + i < expected.size(); ++i )
+        {
+            const auto & a = actions[i];
+            const auto & b = expected[firstLine + i];
+            EXPECT_EQ( a.action.path, b.action.path );
+            EXPECT_EQ( a.toolDirection, b.toolDirection );
+            EXPECT_EQ( a.idle, b.idle );
+            EXPECT_EQ( a.action.warning, b.action.warning );
+        }
+    };
+
+    // small chunks in memory
+    GcodeProcessor chunked;
+    chunked.setGcodeSource( source );
+    size_t numProcessed = 0;
+    EXPECT_TRUE( chunked.processSource( [&]( size_t firstLine, std::vector<GcodeProcessor::MoveAction> & actions )
+    {
+        EXPECT_EQ( firstLine, numProcessed );
+        checkBatch( firstLine, actions );
+        numProcessed += actions.size();
+        return true;
+    }, 7 ) );
+    EXPECT_EQ( numProcessed, source.size() );
+
+    // from stream with empty lines
+    std::stringstream ss;
+    for ( const auto & line : source )
+        ss << line << "\n\n";
+    GcodeProcessor streamed;
+    numProcessed = 0;
+    EXPECT_TRUE( streamed.processStream( ss, [&]( size_t firstLine, std::vector<GcodeProcessor::MoveAction> & actions )
+    {
+        EXPECT_EQ( firstLine, numProcessed );
+        checkBatch( firstLine, actions );
+        numProcessed += actions.size();
+        return true;
+    }, 16 ) );
+    EXPECT_EQ( numProcessed, source.size() );
+    EXPECT_EQ( streamed.getMaxFeedrate(), whole.getMaxFeedrate() );
+
+    // stopping
+    GcodeProcessor stopped;
+    stopped.setGcodeSource( source );
+    int numBatches = 0;
+    EXPECT_FALSE( stopped.processSource( [&]( size_t, std::vector<GcodeProcessor::MoveAction> & )
+    {
+        return ++numBatches < 2;
+    }, 10 ) );
+    EXPECT_EQ( numBatches, 2 );
+}
+
+} //namespace MR
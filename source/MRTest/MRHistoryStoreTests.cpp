@@ -0,0 +1,87 @@
+#include <MRViewer/MRHistoryStore.h>
+#include <MRMesh/MRChangeMeshAction.h>
+#include <MRMesh/MRCombinedHistoryAction.h>
+#include <MRMesh/MRMakeSphereMesh.h>
+#include <MRMesh/MRObjectMesh.h>
+#include <gtest/gtest.h>
+
+namespace MR
+{
+
+TEST( MRViewer, HistoryStoreMemoryBudget )
+{
+    auto obj = std::make_shared<ObjectMesh>();
+    obj->setMesh( std::make_shared<Mesh>( makeUVSphere( 1.0f, 64, 64 ) ) );
+    const auto original = *obj->mesh();
+
+    HistoryStore store;
+    store.setMemoryBudget( HistoryMemoryBudget{ .ramLimit = 0, .numHotActions = 1 } );
+
+    // each edit moves a small part of points, so consecutive full copies are converted into differences
+    std::vector<VertCoords> states{ original.points };
+    for ( int i = 0; i < 4; ++i )
+    {
+        store.appendAction( std::make_shared<ChangeMeshPointsAction>( "move points", obj ) );
+        auto & points = obj->varMesh()->points;
+        for ( VertId v( i * 10 ); v < i * 10 + 10; ++v )
+            points[v] *= 1.1f;
+        obj->setDirtyFlags( DIRTY_POSITION );
+        states.push_back( points );
+    }
+    store.appendAction( std::make_shared<ChangeMeshAction>( "change mesh", obj ) );
+    obj->varMesh()->points[0_v] = Vector3f();
+    states.push_back( obj->mesh()->points );
+
+    // all actions except for the last one are offloaded with zero budget
+    EXPECT_EQ( store.numOffloadedActions(), 4 );
+
+    for ( int i = 4; i >= 0; --i )
+    {
+        EXPECT_TRUE( store.undo() );
+        EXPECT_EQ( obj->mesh()->points, states[i] );
+    }
+    EXPECT_EQ( obj->mesh()->topology, original.topology );
+    for ( int i = 1; i <= 5; ++i )
+    {
+        EXPECT_TRUE( store.redo() );
+        EXPECT_EQ( obj->mesh()->points, states[i] );
+    }
+
+    // disabling the budget restores all actions
+    store.setMemoryBudget( {} );
+    EXPECT_EQ( store.numOffloadedActions(), 0 );
+    store.clear();
+}
+
+TEST( MRViewer, CombinedHistoryActionConvertToDiff )
+{
+    auto obj = std::make_shared<ObjectMesh>();
+    obj->setMesh( std::make_shared<Mesh>( makeUVSphere( 1.0f, 64, 64 ) ) );
+
+    std::vector<VertCoords> states{ obj->mesh()->points };
+    std::vector<std::shared_ptr<HistoryAction>> actions;
+    for ( int i = 0; i < 2; ++i )
+    {
+        actions.push_back( std::make_shared<ChangeMeshAction>( "change mesh", obj ) );
+        obj->varMesh()->points[VertId( i )] = Vector3f();
+        states.push_back( obj->mesh()->points );
+    }
+    CombinedHistoryAction combined( "combined", actions );
+    const ChangeMeshAction next( "next", obj );
+
+    // both inner actions are converted: the first one against the second one, and the second one against the next action
+    EXPECT_TRUE( combined.convertToDiff( next ) );
+    for ( const auto & a : actions )
+        EXPECT_LT( a->heapBytes(), obj->mesh()->heapBytes() );
+
+    // the mesh shared with somebody else shall not be modified by undo
+    const std::shared_ptr<const Mesh> shared = obj->mesh();
+    combined.action( HistoryAction::Type::Undo );
+    EXPECT_EQ( obj->mesh()->points, states[0] );
+    EXPECT_EQ( shared->points, states[2] );
+
+    combined.action( HistoryAction::Type::Redo );
+    EXPECT_EQ( obj->mesh()->points, states[2] );
+}
+
+} //namespace MR
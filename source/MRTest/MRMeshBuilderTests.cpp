@@ -3,7 +3,10 @@
 #include <MRMesh/MRMeshBuilderTypes.h>
 #include <MRMesh/MRMeshLoad.h>
 #include <MRMesh/MRMeshComponents.h>
+#include <MRMesh/MRMakeSphereMesh.h>
+#include <MRMesh/MRMesh.h>
 #include <gtest/gtest.h>
+#include <random>
 
 namespace MR
 {
@@ -477,6 +480,71 @@ TEST( MRMesh, computeTrianglesRepetitions )
     EXPECT_EQ( reps[2], 1 ); // {0,1,2}
 }
 
+TEST( MRMesh, fromTrianglesParallel )
+{
+    const auto sphere = makeSphere( { .numMeshVertices = 20000 } );
+    auto tris = sphere.topology.getAllTriVerts();
+    std::shuffle( tris.begin(), tris.end(), std::mt19937( 7 ) );
+    Triangulation t;
+    for ( const auto & tri : tris )
+        t.push_back( tri );
+    ASSERT_GT( t.size(), 32768 ); // to use parallel building
+    const auto numSphereTris = t.size();
+
+    // two separate open fans touching at a vertex
+    const VertId n( sphere.points.size() );
+    t.push_back( { n, n + 1, n + 2 } );
+    t.push_back( { n, n + 2, n + 3 } );
+    t.push_back( { n, n + 4, n + 5 } );
+    // open fan touching the closed sphere at vertex 0
+    t.push_back( { 0_v, n + 6, n + 7 } );
+    // degenerate triangle
+    t.push_back( { n + 8, n + 8, n + 9 } );
+
+    int skippedFaceCount = 0;
+    FaceBitSet region( t.size(), true );
+    const auto topology = fromTriangles( t, { .region = &region, .skippedFaceCount = &skippedFaceCount } );
+    EXPECT_TRUE( topology.checkValidity() );
+    EXPECT_EQ( topology.numValidFaces() + skippedFaceCount, t.size() );
+    EXPECT_EQ( region.count(), skippedFaceCount );
+    EXPECT_TRUE( region.test( FaceId( t.size() - 1 ) ) );
+    // the degenerate triangle and the fan at vertex 0 cannot be added
+    EXPECT_EQ( skippedFaceCount, 2 );
+    EXPECT_TRUE( region.test( FaceId( t.size() - 2 ) ) );
+
+    for ( auto f : topology.getValidFaces() )
+        EXPECT_EQ( topology.getTriVerts( f ), t[f] );
+    for ( FaceId f( numSphereTris ); f < numSphereTris + 3; ++f )
+        EXPECT_TRUE( topology.hasFace( f ) );
+}
+
+TEST( MRMesh, fromTrianglesParallelShiftFaceId )
+{
+    const auto sphere = makeSphere( { .numMeshVertices = 20000 } );
+    Triangulation t;
+    for ( const auto & tri : sphere.topology.getAllTriVerts() )
+        t.push_back( tri );
+    ASSERT_GT( t.size(), 32768 ); // to use parallel building
+
+    const int shiftFaceId = 5;
+    const auto topology = fromTriangles( t, { .shiftFaceId = shiftFaceId } );
+    MeshTopology seqTopology;
+    addTriangles( seqTopology, t, { .shiftFaceId = shiftFaceId } );
+    EXPECT_TRUE( topology.checkValidity() );
+    EXPECT_TRUE( seqTopology.checkValidity() );
+    EXPECT_EQ( topology.numValidFaces(), t.size() );
+    EXPECT_EQ( topology.getValidFaces(), seqTopology.getValidFaces() );
+    EXPECT_EQ( topology.undirectedEdgeSize(), seqTopology.undirectedEdgeSize() );
+
+    for ( FaceId f( 0 ); f < t.size(); ++f )
+    {
+        const FaceId shifted = f + shiftFaceId;
+        EXPECT_EQ( topology.getTriVerts( shifted ), t[f] );
+        EXPECT_EQ( topology.getTriVerts( shifted ), seqTopology.getTriVerts( shifted ) );
+        EXPECT_EQ( topology.left( topology.edgeWithLeft( shifted ) ), shifted );
+    }
+}
+
 } //namespace MeshBuilder
 
 } //namespace MR
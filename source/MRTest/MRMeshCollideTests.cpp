@@ -1,5 +1,9 @@
 #include <MRMesh/MRMeshCollide.h>
 #include <MRMesh/MRMesh.h>
+#include <MRMesh/MRTorus.h>
+#include <MRMesh/MRAffineXf3.h>
+#include <MRMesh/MRCollisionTriangle.h>
+#include <MRMesh/MRBuffer.h>
 #include <gtest/gtest.h>
 
 namespace MR
@@ -45,4 +49,52 @@ TEST( MRMesh, findSelfCollidingTriangles )
     EXPECT_TRUE( *maybeColl );
 }
 
+TEST( MRMesh, CollisionTriangles )
+{
+    auto selfColliding = makeTorusWithSelfIntersections( 1.0f, 0.2f, 32, 16 );
+    auto expected = findSelfCollidingTriangles( selfColliding );
+    ASSERT_TRUE( expected.has_value() );
+    EXPECT_FALSE( expected->empty() );
+
+    (void)selfColliding.getCollisionTriangles();
+    auto cached = findSelfCollidingTriangles( selfColliding );
+    ASSERT_TRUE( cached.has_value() );
+    EXPECT_EQ( *expected, *cached );
+
+    Mesh a = makeTorus( 1.0f, 0.2f, 32, 16 );
+    Mesh b = makeTorus( 1.0f, 0.2f, 32, 16 );
+    const auto b2a = AffineXf3f::xfAround( Matrix3f::rotation( Vector3f::plusX(), 1.0f ), Vector3f( 1.0f, 0.0f, 0.0f ) );
+    const auto expectedPairs = findCollidingTriangles( a, b, &b2a );
+    EXPECT_FALSE( expectedPairs.empty() );
+
+    (void)a.getCollisionTriangles();
+    (void)b.getCollisionTriangles();
+    EXPECT_EQ( expectedPairs, findCollidingTriangles( a, b, &b2a ) );
+    EXPECT_EQ( expectedPairs.size() > 0, findCollidingTriangles( a, b, &b2a, true ).size() == 1 );
+
+    // the triangle is certainly separated from a parallel one far enough
+    const auto t = makeCollisionTriangle( Vector3f( 0, 0, 0 ), Vector3f( 1, 0, 0 ), Vector3f( 0, 1, 0 ) );
+    const auto up = makeCollisionTriangle( Vector3f( 0, 0, 1 ), Vector3f( 1, 0, 1 ), Vector3f( 0, 1, 1 ) );
+    EXPECT_FALSE( mayTrianglesCollide( t, up ) );
+    const auto touching = makeCollisionTriangle( Vector3f( 0, 0, 0 ), Vector3f( 1, 0, 1 ), Vector3f( 0, 1, 1 ) );
+    EXPECT_TRUE( mayTrianglesCollide( t, touching ) );
+
+    // changing points invalidates the cache
+    a.invalidateCaches();
+    EXPECT_EQ( a.getCollisionTrianglesNotCreate(), nullptr );
+
+    // faces renumbering invalidates the cache
+    for ( bool preserveAABBTree : { false, true } )
+    {
+        auto packed = selfColliding;
+        (void)packed.getCollisionTriangles();
+        packed.packOptimally( preserveAABBTree );
+        EXPECT_EQ( packed.getCollisionTrianglesNotCreate(), nullptr );
+        (void)packed.getCollisionTriangles();
+        auto afterPack = findSelfCollidingTriangles( packed );
+        ASSERT_TRUE( afterPack.has_value() );
+        EXPECT_EQ( afterPack->size(), expected->size() );
+    }
+}
+
 } //namespace MR
@@ -0,0 +1,51 @@
+#include <MRMesh/MRMeshCollisionScene.h>
+#include <MRMesh/MRMesh.h>
+#include <MRMesh/MRMakeSphereMesh.h>
+#include <gtest/gtest.h>
+
+namespace MR
+{
+
+TEST( MRMesh, MeshCollisionScene )
+{
+    const Mesh sphere = makeUVSphere( 1.0f, 16, 16 );
+
+    // a row of 10 spheres with the distance 2.5 between centers
+    MeshCollisionScene scene;
+    std::vector<ObjId> ids;
+    for ( int i = 0; i < 10; ++i )
+        ids.push_back( scene.add( sphere, AffineXf3f::translation( { 2.5f * i, 0, 0 } ) ) );
+    EXPECT_EQ( scene.size(), 10 );
+    EXPECT_TRUE( scene.findPotentiallyCollidingPairs().empty() );
+
+    auto res = scene.findCollisions();
+    ASSERT_TRUE( res.has_value() );
+    EXPECT_TRUE( res->empty() );
+
+    // too close objects are found with minDistance
+    res = scene.findCollisions( { .minDistance = 0.6f, .firstFacePairOnly = true } );
+    ASSERT_TRUE( res.has_value() );
+    EXPECT_EQ( res->size(), 9 );
+
+    // move two objects to collide with their neighbours
+    scene.setXf( ids[3], AffineXf3f::translation( { 2.5f * 2 + 1.5f, 0, 0 } ) );
+    scene.setXf( ids[9], AffineXf3f::translation( { 0, 1.0f, 0 } ) );
+    res = scene.findCollisions();
+    ASSERT_TRUE( res.has_value() );
+    ASSERT_EQ( res->size(), 2 );
+    EXPECT_EQ( (*res)[0].a, ids[0] );
+    EXPECT_EQ( (*res)[0].b, ids[9] );
+    EXPECT_EQ( (*res)[1].a, ids[2] );
+    EXPECT_EQ( (*res)[1].b, ids[3] );
+    for ( const auto & c : *res )
+        EXPECT_FALSE( c.facePairs.empty() );
+
+    // a colliding object is removed
+    scene.remove( ids[3] );
+    res = scene.findCollisions();
+    ASSERT_TRUE( res.has_value() );
+    ASSERT_EQ( res->size(), 1 );
+    EXPECT_EQ( (*res)[0].b, ids[9] );
+}
+
+} //namespace MR
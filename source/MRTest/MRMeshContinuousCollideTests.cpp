@@ -0,0 +1,41 @@
+#include <MRMesh/MRMeshContinuousCollide.h>
+#include <MRMesh/MRMesh.h>
+#include <MRMesh/MRCube.h>
+#include <MRMesh/MRMakeSphereMesh.h>
+#include <gtest/gtest.h>
+
+namespace MR
+{
+
+TEST( MRMesh, findContinuousCollision )
+{
+    const Mesh a = makeUVSphere( 1.0f, 32, 32 );
+    const Mesh b = makeUVSphere( 1.0f, 32, 32 );
+
+    // B moves along X-axis through A: first contact is near x = -2
+    std::vector<AffineXf3f> poses{ AffineXf3f::translation( { -5.0f, 0, 0 } ), AffineXf3f::translation( { 5.0f, 0, 0 } ) };
+    auto res = findContinuousCollision( a, b, poses );
+    ASSERT_TRUE( res.has_value() );
+    ASSERT_TRUE( res->collided() );
+    EXPECT_NEAR( res->timeOfImpact, 0.3, 0.01 );
+    EXPECT_FALSE( res->contactPairs.empty() );
+    EXPECT_LE( res->b2aAtImpact.b.x, -1.9f );
+
+    // B passes by A
+    poses = { AffineXf3f::translation( { -5.0f, 2.5f, 0 } ), AffineXf3f::translation( { 5.0f, 2.5f, 0 } ), AffineXf3f::translation( { 5.0f, 5.0f, 0 } ) };
+    res = findContinuousCollision( a, b, poses );
+    ASSERT_TRUE( res.has_value() );
+    EXPECT_FALSE( res->collided() );
+
+    // thin plate is hit in the middle of the second segment, while all poses are free of collisions
+    const Mesh plate = makeCube( { 0.01f, 4.0f, 4.0f }, { -0.005f, -2.0f, -2.0f } );
+    poses = { AffineXf3f::translation( { -5.0f, 0, 0 } ), AffineXf3f::translation( { -3.0f, 0, 0 } ), AffineXf3f::translation( { 3.0f, 0, 0 } ) };
+    res = findContinuousCollision( plate, b, poses );
+    ASSERT_TRUE( res.has_value() );
+    ASSERT_TRUE( res->collided() );
+    EXPECT_GT( res->timeOfImpact, 1.0 );
+    EXPECT_LT( res->timeOfImpact, 2.0 );
+    EXPECT_NEAR( interpolateRigidMotion( poses, res->timeOfImpact, {} ).b.x, -1.005f, 0.01f );
+}
+
+} //namespace MR
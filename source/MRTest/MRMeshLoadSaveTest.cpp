@@ -5,6 +5,9 @@
 #include <MRMesh/MRTriMesh.h>
 #include <MRMesh/MRBox.h>
 #include <MRMesh/MRColor.h>
+#include <MRMesh/MRTorus.h>
+#include <MRMesh/MRBitSet.h>
+#include <MRMesh/MRRingIterator.h>
 #include <gtest/gtest.h>
 #include <filesystem>
 #include <fstream>
@@ -115,6 +118,53 @@ TEST(MRMesh, TriMeshSavePly)
     EXPECT_EQ( loadRes->topology.numValidFaces(), 6 );
 }
 
+TEST(MRMesh, SaveLargeBinaryStlAndPly)
+{
+    // the mesh is large enough to be saved by several parallel chunks
+    auto mesh = makeTorus( 1.f, 0.1f, 300, 200 );
+    FaceBitSet del( mesh.topology.faceSize() );
+    for ( FaceId f{ 0 }; f < del.size(); f += 7 )
+        del.set( f );
+    // and vertex #0 becomes invalid
+    for ( auto e : orgRing( mesh.topology, 0_v ) )
+        if ( auto f = mesh.topology.left( e ) )
+            del.set( f );
+    mesh.topology.deleteFaces( del );
+    ASSERT_FALSE( mesh.topology.hasVert( 0_v ) );
+
+    // reference binary STL written triangle by triangle
+    std::ostringstream expected;
+    {
+        MeshSave::BinaryStlSaver saver( expected );
+        for ( auto f : mesh.topology.getValidFaces() )
+            saver.writeTri( mesh.getTriPoints( f ) );
+    }
+    std::ostringstream stl;
+    EXPECT_TRUE( MeshSave::toBinaryStl( mesh, stl ).has_value() );
+    EXPECT_EQ( expected.str(), stl.str() );
+
+    // the same bytes must be saved in PLY for Mesh and for equivalent TriMesh
+    std::ostringstream plyMesh;
+    EXPECT_TRUE( MeshSave::toPly( mesh, plyMesh, { .onlyValidPoints = false, .packPrimitives = false } ).has_value() );
+    TriMesh triMesh;
+    triMesh.points = mesh.points;
+    triMesh.tris.resize( mesh.topology.lastValidFace() + 1, { 0_v, 0_v, 0_v } );
+    for ( auto f : mesh.topology.getValidFaces() )
+        triMesh.tris[f] = mesh.topology.getTriVerts( f );
+    std::ostringstream plyTriMesh;
+    EXPECT_TRUE( MeshSave::toPly( triMesh, plyTriMesh ).has_value() );
+    EXPECT_EQ( plyMesh.str(), plyTriMesh.str() );
+
+    // packed PLY
+    std::ostringstream ply;
+    EXPECT_TRUE( MeshSave::toPly( mesh, ply ).has_value() );
+    std::istringstream in( ply.str() );
+    auto loadRes = MeshLoad::fromPly( in );
+    ASSERT_TRUE( loadRes.has_value() );
+    EXPECT_EQ( loadRes->topology.numValidVerts(), mesh.topology.numValidVerts() );
+    EXPECT_EQ( loadRes->topology.numValidFaces(), mesh.topology.numValidFaces() );
+}
+
 TEST(MRMesh, LoadPlyDuplicatingNonManifoldVertices)
 {
     // two closed triangle fans sharing only the central vertex #0
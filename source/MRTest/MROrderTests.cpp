@@ -0,0 +1,155 @@
+#include <MRMesh/MROrder.h>
+#include <MRMesh/MRMesh.h>
+#include <MRMesh/MRMeshBuilder.h>
+#include <MRMesh/MRMakeSphereMesh.h>
+#include <MRMesh/MRBitSet.h>
+#include <MRMesh/MRMeshLoad.h>
+#include <MRMesh/MRMeshLoadSettings.h>
+#include <MRMesh/MRColor.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <sstream>
+
+namespace MR
+{
+
+namespace
+{
+
+// sphere with randomly ordered vertices and faces as after loading of a scan
+Mesh makeShuffledSphere()
+{
+    const auto sphere = makeSphere( { .numMeshVertices = 5000 } );
+    std::mt19937 rnd( 42 );
+
+    std::vector<VertId> newVert( sphere.points.size() );
+    std::iota( newVert.begin(), newVert.end(), 0_v );
+    std::shuffle( newVert.begin(), newVert.end(), rnd );
+    VertCoords points( sphere.points.size() );
+    for ( auto v = 0_v; v < sphere.points.size(); ++v )
+        points[newVert[v]] = sphere.points[v];
+
+    auto tris = sphere.topology.getAllTriVerts();
+    std::shuffle( tris.begin(), tris.end(), rnd );
+    Triangulation t;
+    for ( const auto & tri : tris )
+        t.push_back( { newVert[tri[0]], newVert[tri[1]], newVert[tri[2]] } );
+    return Mesh::fromTriangles( std::move( points ), t );
+}
+
+template <typename I>
+bool isPermutation( const BMap<I, I> & map )
+{
+    std::vector<bool> used( map.tsize, false );
+    for ( I i( 0 ); i < map.b.size(); ++i )
+    {
+        const auto n = map.b[i];
+        if ( !n )
+            continue;
+        if ( n >= map.tsize || used[n] )
+            return false;
+        used[n] = true;
+    }
+    return std::all_of( used.begin(), used.end(), [] ( bool b ) { return b; } );
+}
+
+} // anonymous namespace
+
+TEST( MRMesh, SpaceCurveOrdering )
+{
+    const auto mesh = makeShuffledSphere();
+    for ( auto curve : { SpaceCurve::Morton, SpaceCurve::Hilbert } )
+    {
+        const auto fmap = getFaceOrderingAlongCurve( mesh, curve );
+        EXPECT_EQ( fmap.tsize, mesh.topology.numValidFaces() );
+        EXPECT_TRUE( isPermutation( fmap ) );
+
+        const auto vmap = getVertexOrderingAlongCurve( mesh.points, mesh.topology.getValidVerts(), curve );
+        EXPECT_EQ( vmap.tsize, mesh.topology.numValidVerts() );
+        EXPECT_TRUE( isPermutation( vmap ) );
+    }
+
+    const auto fmap = getVertexCacheOptimalFaceOrdering( mesh.topology );
+    EXPECT_EQ( fmap.tsize, mesh.topology.numValidFaces() );
+    EXPECT_TRUE( isPermutation( fmap ) );
+}
+
+TEST( MRMesh, OptimizeLocality )
+{
+    const auto shuffled = makeShuffledSphere();
+    const auto before = computeLocalityStats( shuffled.topology );
+    const auto area = shuffled.area();
+
+    for ( auto order : { LocalityOrder::AABBTree, LocalityOrder::Morton, LocalityOrder::Hilbert } )
+    {
+        for ( bool optimizeVertexCache : { false, true } )
+        {
+            auto mesh = shuffled;
+            auto map = optimizeLocality( mesh, { .order = order, .optimizeVertexCache = optimizeVertexCache } );
+            ASSERT_TRUE( map.has_value() );
+            EXPECT_EQ( mesh.topology.numValidFaces(), shuffled.topology.numValidFaces() );
+            EXPECT_EQ( mesh.topology.numValidVerts(), shuffled.topology.numValidVerts() );
+            EXPECT_TRUE( mesh.topology.checkValidity() );
+            EXPECT_NEAR( mesh.area(), area, 1e-3f * area );
+
+            const auto after = computeLocalityStats( mesh.topology );
+            EXPECT_LT( after.avgVertIndexDistance, 0.2 * before.avgVertIndexDistance );
+            EXPECT_LT( after.avgNeighborFaceDistance, 0.2 * before.avgNeighborFaceDistance );
+            EXPECT_LT( after.acmr, before.acmr );
+            if ( optimizeVertexCache )
+            {
+                EXPECT_LT( after.acmr, 0.9 );
+            }
+        }
+    }
+}
+
+TEST( MRMesh, OptimizeLocalityAfterLoading )
+{
+    const auto shuffled = makeShuffledSphere();
+
+    // PLY with per-vertex colors encoding vertex index, and the edges along the first edge of each triangle
+    std::ostringstream ply;
+    const auto tris = shuffled.topology.getAllTriVerts();
+    ply << "ply\nformat ascii 1.0\n"
+        << "element vertex " << shuffled.points.size() << "\nproperty float x\nproperty float y\nproperty float z\n"
+        << "property uchar red\nproperty uchar green\nproperty uchar blue\n"
+        << "element face " << tris.size() << "\nproperty list uchar int vertex_indices\n"
+        << "element edge " << tris.size() << "\nproperty int vertex1\nproperty int vertex2\n"
+        << "end_header\n";
+    auto colorOf = [] ( VertId v ) { return Color( int( v ) % 256, int( v ) / 256 % 256, 0 ); };
+    for ( auto v = 0_v; v < shuffled.points.size(); ++v )
+    {
+        const auto & p = shuffled.points[v];
+        const auto c = colorOf( v );
+        ply << p.x << ' ' << p.y << ' ' << p.z << ' ' << int( c.r ) << ' ' << int( c.g ) << ' ' << int( c.b ) << '\n';
+    }
+    for ( const auto & t : tris )
+        ply << "3 " << int( t[0] ) << ' ' << int( t[1] ) << ' ' << int( t[2] ) << '\n';
+    for ( const auto & t : tris )
+        ply << int( t[0] ) << ' ' << int( t[1] ) << '\n';
+
+    VertColors colors;
+    std::optional<Edges> edges;
+    std::istringstream in( ply.str() );
+    auto mesh = MeshLoad::fromAnySupportedFormat( in, "*.ply", { .edges = &edges, .colors = &colors, .optimizeLocality = true } );
+    ASSERT_TRUE( mesh.has_value() );
+    ASSERT_TRUE( edges.has_value() );
+    ASSERT_EQ( edges->size(), tris.size() );
+    ASSERT_EQ( colors.size(), mesh->points.size() );
+
+    // the colors and the ends of edges follow renumbered vertices
+    for ( auto ue = 0_ue; ue < edges->size(); ++ue )
+    {
+        const auto & t = tris[size_t( ue )];
+        const auto & e = ( *edges )[ue];
+        ASSERT_TRUE( e[0] && e[1] );
+        EXPECT_EQ( colors[e[0]], colorOf( t[0] ) );
+        EXPECT_EQ( colors[e[1]], colorOf( t[1] ) );
+        EXPECT_TRUE( mesh->topology.findEdge( e[0], e[1] ).valid() );
+    }
+}
+
+} //namespace MR
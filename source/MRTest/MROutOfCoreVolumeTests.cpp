@@ -0,0 +1,75 @@
+#ifndef MESHLIB_NO_VOXELS
+
+#include "MRVoxels/MROutOfCoreVolume.h"
+#include "MRVoxels/MRVoxelsVolume.h"
+#include "MRVoxels/MRMarchingCubes.h"
+#include "MRVoxels/MRVoxelFilter.h"
+#include "MRMesh/MRMesh.h"
+#include "MRMesh/MRUniqueTemporaryFolder.h"
+#include "MRMesh/MRVolumeIndexer.h"
+#include <gtest/gtest.h>
+
+namespace MR
+{
+
+TEST( MRMesh, OutOfCoreVolume )
+{
+    SimpleVolume vol
+    {
+        .dims = { 31, 33, 29 },
+        .voxelSize = { 0.1f, 0.1f, 0.1f }
+    };
+    const VolumeIndexer indexer( vol.dims );
+    vol.data.resize( indexer.size() );
+    for ( auto v = 0_vox; v < indexer.endId(); ++v )
+    {
+        const auto pos = indexer.toPos( v );
+        vol.data[v] = ( Vector3f( pos ) - Vector3f( 15, 16, 14 ) ).length() - 9;
+    }
+
+    UniqueTemporaryFolder tmpFolder;
+    auto ooc = OutOfCoreVolume::create( tmpFolder / "in.raw", vol.dims, vol.voxelSize );
+    ASSERT_TRUE( ooc.has_value() );
+    ASSERT_TRUE( ooc->writeSlab( 0, vol ).has_value() );
+
+    // small slabs of 4 Z-slices to test the stitching
+    const size_t slabMemory = 4 * indexer.sizeXY() * sizeof( float );
+    EXPECT_EQ( ooc->slabLayers( slabMemory ), 4 );
+
+    auto slab = ooc->readSlab( 10, 14 );
+    ASSERT_TRUE( slab.has_value() );
+    EXPECT_TRUE( std::equal( slab->data.vec_.begin(), slab->data.vec_.end(), vol.data.vec_.begin() + 10 * indexer.sizeXY() ) );
+
+    MarchingCubesParams params;
+    params.lessInside = true;
+    auto meshA = marchingCubes( vol, params );
+    auto meshB = marchingCubes( *ooc, params, slabMemory );
+    ASSERT_TRUE( meshA.has_value() );
+    ASSERT_TRUE( meshB.has_value() );
+    EXPECT_GT( meshA->topology.numValidFaces(), 0 );
+    EXPECT_EQ( *meshA, *meshB );
+
+    auto filteredA = voxelFilter( vol, VoxelFilterType::Mean, 3 );
+    auto filteredB = OutOfCoreVolume::create( tmpFolder / "out.raw", vol.dims, vol.voxelSize );
+    ASSERT_TRUE( filteredA.has_value() );
+    ASSERT_TRUE( filteredB.has_value() );
+    ASSERT_TRUE( voxelFilter( *ooc, *filteredB, VoxelFilterType::Mean, 3, {}, slabMemory ).has_value() );
+    EXPECT_FALSE( voxelFilter( *ooc, *ooc, VoxelFilterType::Mean, 3, {}, slabMemory ).has_value() );
+    auto filteredBData = filteredB->readSlab( 0, vol.dims.z );
+    ASSERT_TRUE( filteredBData.has_value() );
+    EXPECT_EQ( filteredA->data, filteredBData->data );
+
+    auto inside = selectVoxelsInRange( *ooc, MinMaxf( -100.0f, 0.0f ), {}, slabMemory );
+    ASSERT_TRUE( inside.has_value() );
+    for ( auto v = 0_vox; v < indexer.endId(); ++v )
+        EXPECT_EQ( inside->test( v ), vol.data[v] <= 0.0f );
+
+    auto maskMesh = meshFromVoxelsMask( *ooc, *inside, {}, slabMemory );
+    ASSERT_TRUE( maskMesh.has_value() );
+    EXPECT_GT( maskMesh->topology.numValidFaces(), 0 );
+    EXPECT_TRUE( maskMesh->topology.isClosed() );
+}
+
+} //namespace MR
+
+#endif //!MESHLIB_NO_VOXELS
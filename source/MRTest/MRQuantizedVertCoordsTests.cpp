@@ -0,0 +1,78 @@
+#include <MRMesh/MRQuantizedVertCoords.h>
+#include <MRMesh/MRMesh.h>
+#include <MRMesh/MRMakeSphereMesh.h>
+#include <MRMesh/MRBitSet.h>
+#include <MRMesh/MRExtractIsolines.h>
+#include <MRMesh/MRPlane3.h>
+#include <MRMesh/MREdgePoint.h>
+#include <gtest/gtest.h>
+
+namespace MR
+{
+
+TEST( MRMesh, QuantizedVertCoords )
+{
+    const Mesh sphere = makeUVSphere( 10.0f, 64, 64 );
+    const auto & points = sphere.points;
+
+    for ( auto precision : { QuantizedVertCoords::Precision::Bits16, QuantizedVertCoords::Precision::Bits21 } )
+    {
+        const QuantizedVertCoords q( points, precision );
+        EXPECT_EQ( q.size(), points.size() );
+        EXPECT_LT( q.heapBytes(), points.heapBytes() );
+
+        // small margin for float rounding in decoding
+        const auto maxErr = q.maxError() + Vector3f::diagonal( 1e-5f );
+        const auto decoded = q.toVertCoords();
+        ASSERT_EQ( decoded.size(), points.size() );
+        for ( auto v = 0_v; v < points.size(); ++v )
+        {
+            const auto d = decoded[v] - points[v];
+            EXPECT_LE( std::abs( d.x ), maxErr.x );
+            EXPECT_LE( std::abs( d.y ), maxErr.y );
+            EXPECT_LE( std::abs( d.z ), maxErr.z );
+            EXPECT_EQ( decoded[v], q[v] );
+        }
+    }
+
+    // 21-bit precision is much better than 16-bit one
+    const QuantizedVertCoords q16( points, QuantizedVertCoords::Precision::Bits16 );
+    const QuantizedVertCoords q21( points, QuantizedVertCoords::Precision::Bits21 );
+    EXPECT_LT( 16 * q21.maxError().x, q16.maxError().x );
+    EXPECT_EQ( q16.heapBytes(), 6 * points.size() );
+    EXPECT_EQ( q21.heapBytes(), 8 * points.size() );
+
+    // quantization of a part of points
+    VertBitSet region( points.size() );
+    for ( auto v = 0_v; v < points.size(); ++v )
+        if ( points[v].z > 5 )
+            region.set( v );
+    const QuantizedVertCoords qPart( points, QuantizedVertCoords::Precision::Bits16, &region );
+    EXPECT_GE( qPart.box().min.z, 5 );
+    VertCoords decodedPart( points.size() );
+    qPart.decode( decodedPart, &region );
+    for ( auto v : region )
+        EXPECT_LE( ( decodedPart[v] - points[v] ).length(), qPart.maxError().length() + 1e-5f );
+}
+
+TEST( MRMesh, QuantizedVertCoordsPlaneSections )
+{
+    const Mesh sphere = makeUVSphere( 10.0f, 64, 64 );
+    const QuantizedVertCoords q( sphere.points, QuantizedVertCoords::Precision::Bits16 );
+
+    // the plane is far from vertex rings, so the same edges are crossed as with original coordinates
+    const auto plane = Plane3f( Vector3f::plusZ(), 1.234f );
+    const auto expected = extractPlaneSections( sphere, plane, UseAABBTree::No );
+    const auto sections = extractPlaneSections( sphere.topology, q, plane );
+    ASSERT_EQ( sections.size(), 1 );
+    ASSERT_EQ( sections.size(), expected.size() );
+    ASSERT_EQ( sections[0].size(), expected[0].size() );
+    for ( size_t i = 0; i < sections[0].size(); ++i )
+    {
+        EXPECT_EQ( sections[0][i].e, expected[0][i].e );
+        // the error of a point on the edge is amplified by the ratio of edge length and the difference of distances to the plane in its ends
+        EXPECT_LE( ( sphere.edgePoint( sections[0][i] ) - sphere.edgePoint( expected[0][i] ) ).length(), 10 * q.maxError().length() );
+    }
+}
+
+} //namespace MR
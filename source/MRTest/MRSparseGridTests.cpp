@@ -0,0 +1,89 @@
+#ifndef MESHLIB_NO_VOXELS
+
+#include "MRVoxels/MRSparseGrid.h"
+#include "MRVoxels/MRVoxelsVolume.h"
+#include "MRVoxels/MRMarchingCubes.h"
+#include "MRVoxels/MRMeshToDistanceVolume.h"
+#include "MRMesh/MRMesh.h"
+#include "MRMesh/MRMakeSphereMesh.h"
+#include "MRMesh/MRVolumeIndexer.h"
+#include <gtest/gtest.h>
+#include <cmath>
+
+namespace MR
+{
+
+TEST( MRMesh, SparseGrid )
+{
+    // the volume of clamped distances to a sphere has constant values far from the sphere
+    SimpleVolume vol
+    {
+        .dims = { 61, 64, 57 },
+        .voxelSize = { 0.1f, 0.1f, 0.1f }
+    };
+    const VolumeIndexer indexer( vol.dims );
+    vol.data.resize( indexer.size() );
+    for ( auto v = 0_vox; v < indexer.endId(); ++v )
+    {
+        const auto pos = indexer.toPos( v );
+        const auto dist = ( Vector3f( pos ) - Vector3f( 30, 30, 28 ) ).length() - 12;
+        vol.data[v] = std::clamp( dist, -2.0f, 2.0f );
+    }
+
+    auto sparse = simpleVolumeToSparseVolume( vol );
+    ASSERT_TRUE( sparse.has_value() );
+    EXPECT_EQ( sparse->data.dims(), vol.dims );
+    EXPECT_EQ( sparse->data.numBricks(), Vector3i( 8, 8, 8 ) );
+    EXPECT_EQ( sparse->min, -2.0f );
+    EXPECT_EQ( sparse->max, 2.0f );
+    const auto numDense = sparse->data.numDenseBricks();
+    EXPECT_GT( numDense, 0 );
+    EXPECT_LT( numDense, sparse->data.brickCount() );
+    EXPECT_LT( sparse->heapBytes(), vol.heapBytes() );
+
+    auto dense = sparseVolumeToSimpleVolume( *sparse );
+    ASSERT_TRUE( dense.has_value() );
+    EXPECT_EQ( dense->data, vol.data );
+
+    MarchingCubesParams params;
+    params.lessInside = true;
+    auto meshA = marchingCubes( vol, params );
+    auto meshB = marchingCubes( *sparse, params );
+    ASSERT_TRUE( meshA.has_value() );
+    ASSERT_TRUE( meshB.has_value() );
+    EXPECT_GT( meshA->topology.numValidFaces(), 0 );
+    EXPECT_EQ( *meshA, *meshB );
+}
+
+TEST( MRMesh, MeshToSparseDistanceVolume )
+{
+    auto sphere = makeSphere( { .radius = 1.0f, .numMeshVertices = 1000 } );
+
+    MeshToDistanceVolumeParams params;
+    params.vol.origin = Vector3f::diagonal( -1.5f );
+    params.vol.voxelSize = Vector3f::diagonal( 0.05f );
+    params.vol.dimensions = Vector3i::diagonal( 60 );
+    params.dist.maxDistSq = sqr( 0.15f );
+    params.dist.signMode = SignDetectionMode::ProjectionNormal;
+
+    auto dense = meshToDistanceVolume( sphere, params );
+    auto sparse = meshToSparseDistanceVolume( sphere, params );
+    ASSERT_TRUE( dense.has_value() );
+    ASSERT_TRUE( sparse.has_value() );
+    EXPECT_LT( sparse->data.numDenseBricks(), sparse->data.brickCount() );
+
+    const VolumeIndexer indexer( dense->dims );
+    for ( auto v = 0_vox; v < indexer.endId(); ++v )
+    {
+        const auto a = dense->data[v];
+        const auto b = sparse->data.value( indexer.toPos( v ) );
+        if ( std::isnan( a ) )
+            EXPECT_TRUE( std::isnan( b ) );
+        else
+            EXPECT_EQ( a, b );
+    }
+}
+
+} //namespace MR
+
+#endif //!MESHLIB_NO_VOXELS
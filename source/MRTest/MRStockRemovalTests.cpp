@@ -0,0 +1,52 @@
+#ifndef MESHLIB_NO_VOXELS
+
+#include <MRMesh/MRMesh.h>
+#include <MRMesh/MRBitSet.h>
+#include <MRVoxels/MRStockRemoval.h>
+#include <gtest/gtest.h>
+
+namespace MR
+{
+
+TEST( MRMesh, StockRemoval )
+{
+    const Box3f stock( Vector3f( 0, 0, 0 ), Vector3f( 10, 10, 10 ) );
+    const EndMillTool tool{ .length = 20.f, .diameter = 2.f };
+    StockRemovalSimulator sim( stock, tool, 0.1f );
+
+    // slot of width 2 and depth 2 through the whole stock
+    const auto slot = sim.move( Vector3f( -2, 5, 8 ), Vector3f( 12, 5, 8 ) );
+    EXPECT_NEAR( slot.length, 14.f, 1e-5f );
+    EXPECT_NEAR( slot.removedVolume, 40.f, 2.f );
+    EXPECT_NEAR( slot.removalRate( 100.f ), slot.removedVolume * 100.f / 14.f, 1e-3f );
+    EXPECT_NEAR( sim.removedVolume(), slot.removedVolume, 1e-3f );
+
+    // the same movement removes nothing
+    const auto again = sim.move( Vector3f( -2, 5, 8 ), Vector3f( 12, 5, 8 ) );
+    EXPECT_NEAR( again.removedVolume, 0.f, 1e-3f );
+
+    // only blocks near the surface keep voxel data
+    const int numBlocks = int( sim.dirtyBlocks().size() );
+    EXPECT_LT( sim.numDenseBlocks(), numBlocks );
+
+    auto mesh = sim.getMesh();
+    ASSERT_TRUE( mesh.has_value() );
+    EXPECT_TRUE( sim.dirtyBlocks().none() );
+    EXPECT_TRUE( mesh->topology.isClosed() );
+    EXPECT_NEAR( mesh->volume(), 1000.f - slot.removedVolume, 5.f );
+
+    // plunge in the corner changes only a few blocks
+    const auto plunge = sim.move( Vector3f( 2, 2, 12 ), Vector3f( 2, 2, 9 ) );
+    EXPECT_NEAR( plunge.removedVolume, PI_F, 0.3f );
+    EXPECT_GT( sim.dirtyBlocks().count(), 0 );
+    auto updated = sim.updateMesh();
+    ASSERT_TRUE( updated.has_value() );
+    EXPECT_LT( int( updated->count() ), numBlocks / 4 );
+    mesh = sim.getMesh();
+    ASSERT_TRUE( mesh.has_value() );
+    EXPECT_NEAR( mesh->volume(), 1000.f - sim.removedVolume(), 5.f );
+}
+
+} //namespace MR
+
+#endif //!MESHLIB_NO_VOXELS
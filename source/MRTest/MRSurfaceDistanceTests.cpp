@@ -0,0 +1,161 @@
+#include <MRMesh/MRSurfaceDistance.h>
+#include <MRMesh/MRHeatGeodesics.h>
+#include <MRMesh/MRMesh.h>
+#include <MRMesh/MRMakeSphereMesh.h>
+#include <MRMesh/MRBitSet.h>
+#include <MRMesh/MRExpected.h>
+#include <MRMesh/MRBuffer.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+
+namespace MR
+{
+
+namespace
+{
+
+// returns maximal difference of two distance maps in the vertices, where both are below maxDist
+float maxDifference( const VertScalars & a, const VertScalars & b, float maxDist = FLT_MAX )
+{
+    EXPECT_EQ( a.size(), b.size() );
+    float res = 0;
+    for ( auto v = 0_v; v < a.size() && v < b.size(); ++v )
+    {
+        if ( a[v] >= maxDist && b[v] >= maxDist )
+            continue;
+        res = std::max( res, std::abs( a[v] - b[v] ) );
+    }
+    return res;
+}
+
+} // anonymous namespace
+
+TEST( MRMesh, SurfaceDistancesParallel )
+{
+    const auto sphere = makeSphere( { .numMeshVertices = 20000 } );
+    VertBitSet start( sphere.points.size() );
+    start.set( 0_v );
+
+    // geodesic distances on unit sphere do not exceed PI, and both methods must agree well
+    const auto seq = computeSurfaceDistances( sphere, start );
+    const auto par = computeSurfaceDistancesParallel( sphere, start );
+    EXPECT_LT( maxDifference( seq, par ), 0.01f );
+    for ( auto v : sphere.topology.getValidVerts() )
+    {
+        EXPECT_LT( par[v], 3.2f );
+        EXPECT_GE( par[v], 0.0f );
+    }
+
+    // very small buckets make it similar to sequential Dijkstra, very large buckets - to parallel Bellman-Ford
+    EXPECT_LT( maxDifference( seq, computeSurfaceDistancesParallel( sphere, start, FLT_MAX, nullptr, 1e-4f ) ), 0.01f );
+    EXPECT_LT( maxDifference( seq, computeSurfaceDistancesParallel( sphere, start, FLT_MAX, nullptr, 10.0f ) ), 0.01f );
+
+    // limited distance
+    const float maxDist = 1.0f;
+    const auto seqLim = computeSurfaceDistances( sphere, start, maxDist );
+    const auto parLim = computeSurfaceDistancesParallel( sphere, start, maxDist );
+    EXPECT_LT( maxDifference( seqLim, parLim, maxDist ), 0.01f );
+
+    // region
+    VertBitSet region( sphere.points.size() );
+    for ( auto v : sphere.topology.getValidVerts() )
+        if ( sphere.points[v].z > -0.5f )
+            region.set( v );
+    EXPECT_LT( maxDifference( computeSurfaceDistances( sphere, start, FLT_MAX, &region ),
+        computeSurfaceDistancesParallel( sphere, start, FLT_MAX, &region ) ), 0.01f );
+}
+
+TEST( MRMesh, SurfaceDistancesBatch )
+{
+    const auto sphere = makeSphere( { .numMeshVertices = 5000 } );
+    std::vector<VertBitSet> starts;
+    for ( int i = 0; i < 3; ++i )
+    {
+        starts.emplace_back( sphere.points.size() );
+        starts.back().set( VertId( 1000 * i ) );
+    }
+    // many sources at once
+    for ( int i = 3; i < 64; ++i )
+        starts.push_back( starts[i % 3] );
+
+    const auto few = computeSurfaceDistancesBatch( sphere, { starts.begin(), starts.begin() + 3 } );
+    ASSERT_TRUE( few.has_value() );
+    const auto many = computeSurfaceDistancesBatch( sphere, starts );
+    ASSERT_TRUE( many.has_value() );
+    ASSERT_EQ( few->size(), 3 );
+    ASSERT_EQ( many->size(), starts.size() );
+    for ( size_t i = 0; i < starts.size(); ++i )
+    {
+        const auto seq = computeSurfaceDistances( sphere, starts[i] );
+        EXPECT_LT( maxDifference( seq, ( *many )[i] ), 0.01f );
+        if ( i < 3 )
+        {
+            EXPECT_LT( maxDifference( seq, ( *few )[i] ), 0.01f );
+        }
+    }
+}
+
+TEST( MRMesh, HeatGeodesics )
+{
+    const auto sphere = makeSphere( { .numMeshVertices = 10000 } );
+    VertBitSet start( sphere.points.size() );
+    start.set( 0_v );
+
+    EXPECT_EQ( sphere.getHeatGeodesicsNotCreate(), nullptr );
+    const auto heat = computeHeatGeodesics( sphere, start );
+    EXPECT_NE( sphere.getHeatGeodesicsNotCreate(), nullptr );
+
+    // exact geodesic distance on unit sphere is the angle between the radius-vectors
+    const auto p0 = sphere.points[0_v].normalized();
+    double sumErr = 0;
+    for ( auto v : sphere.topology.getValidVerts() )
+    {
+        const float exact = std::acos( std::clamp( dot( p0, sphere.points[v].normalized() ), -1.0f, 1.0f ) );
+        EXPECT_NEAR( heat[v], exact, 0.15f );
+        sumErr += std::abs( heat[v] - exact );
+    }
+    EXPECT_LT( sumErr / sphere.topology.numValidVerts(), 0.05 );
+    EXPECT_EQ( heat[0_v], 0.0f );
+
+    // next queries reuse the operators cached in the mesh
+    const auto * ops = sphere.getHeatGeodesicsNotCreate();
+    std::vector<VertBitSet> starts( 4, VertBitSet( sphere.points.size() ) );
+    for ( int i = 0; i < 4; ++i )
+        starts[i].set( VertId( 2000 * i ) );
+    const auto batch = computeHeatGeodesics( sphere, starts );
+    ASSERT_TRUE( batch.has_value() );
+    ASSERT_EQ( batch->size(), starts.size() );
+    EXPECT_EQ( sphere.getHeatGeodesicsNotCreate(), ops );
+    for ( size_t i = 0; i < starts.size(); ++i )
+        EXPECT_LT( maxDifference( ( *batch )[i], computeSurfaceDistances( sphere, starts[i] ) ), 0.2f );
+
+    // no sources
+    const auto none = computeHeatGeodesics( sphere, VertBitSet( sphere.points.size() ) );
+    EXPECT_EQ( none[0_v], FLT_MAX );
+}
+
+TEST( MRMesh, HeatGeodesicsAfterPack )
+{
+    for ( bool preserveAABBTree : { false, true } )
+    {
+        auto sphere = makeSphere( { .numMeshVertices = 2000 } );
+        VertBitSet start( sphere.points.size() );
+        start.set( 0_v );
+        (void)computeHeatGeodesics( sphere, start );
+        EXPECT_NE( sphere.getHeatGeodesicsNotCreate(), nullptr );
+
+        // vertices renumbering invalidates cached operators
+        const auto map = sphere.packOptimally( preserveAABBTree );
+        EXPECT_EQ( sphere.getHeatGeodesicsNotCreate(), nullptr );
+
+        VertBitSet newStart( sphere.points.size() );
+        newStart.set( map.v.b[0_v] );
+        const auto heat = computeHeatGeodesics( sphere, newStart );
+        ASSERT_EQ( heat.size(), sphere.points.size() );
+        EXPECT_EQ( heat[map.v.b[0_v]], 0.0f );
+        EXPECT_LT( maxDifference( heat, computeSurfaceDistances( sphere, newStart ) ), 0.2f );
+    }
+}
+
+} //namespace MR
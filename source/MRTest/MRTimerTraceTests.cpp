@@ -0,0 +1,78 @@
+#include <MRMesh/MRTimer.h>
+#include <MRMesh/MRTimerTrace.h>
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <thread>
+
+namespace MR
+{
+
+TEST( MRMesh, TimerTrace )
+{
+    clearTimerTrace();
+    setTimerTracing( true );
+    {
+        Timer outer( "outer" );
+        {
+            Timer inner( "inner" );
+            inner.addCounter( "items", 10 );
+            inner.addCounter( "items", 5 );
+        }
+        std::thread worker( []
+        {
+            Timer t( "worker" );
+            t.addCounter( "bytes", 1024 );
+        } );
+        worker.join();
+    }
+    setTimerTracing( false );
+    {
+        Timer ignored( "ignored" );
+    }
+
+    const auto trace = getTimerTrace();
+    const TimerSpan * outer = nullptr;
+    const TimerSpan * inner = nullptr;
+    const TimerSpan * worker = nullptr;
+    int numSpans = 0;
+    for ( const auto & thread : trace )
+    {
+        for ( const auto & span : thread.spans )
+        {
+            ++numSpans;
+            if ( span.name == "outer" )
+                outer = &span;
+            else if ( span.name == "inner" )
+                inner = &span;
+            else if ( span.name == "worker" )
+                worker = &span;
+        }
+    }
+    EXPECT_EQ( numSpans, 3 );
+    ASSERT_TRUE( outer && inner && worker );
+
+    EXPECT_EQ( outer->parent, -1 );
+    EXPECT_EQ( inner->thread, outer->thread );
+    EXPECT_EQ( &trace[inner->thread].spans[inner->parent], outer );
+    EXPECT_NE( worker->thread, outer->thread );
+    EXPECT_LE( outer->start, inner->start );
+    EXPECT_GE( outer->duration, inner->duration );
+
+    ASSERT_EQ( inner->counters.size(), 1 );
+    EXPECT_EQ( inner->counters[0].first, "items" );
+    EXPECT_EQ( inner->counters[0].second, 15 );
+    ASSERT_EQ( worker->counters.size(), 1 );
+    EXPECT_EQ( worker->counters[0].second, 1024 );
+
+    std::ostringstream json;
+    EXPECT_TRUE( saveTimerTraceJson( json ).has_value() );
+    EXPECT_NE( json.str().find( "\"name\":\"inner\"" ), std::string::npos );
+    EXPECT_NE( json.str().find( "\"items\":15" ), std::string::npos );
+
+    clearTimerTrace();
+    for ( const auto & thread : getTimerTrace() )
+        EXPECT_TRUE( thread.spans.empty() );
+}
+
+} //namespace MR
@@ -0,0 +1,110 @@
+#ifndef MESHLIB_NO_VOXELS
+
+#include "MRVoxels/MRToolPath.h"
+#include "MRMesh/MRMakeSphereMesh.h"
+#include "MRMesh/MRBitSet.h"
+#include "MRPch/MRTBB.h"
+#include <gtest/gtest.h>
+#include <cmath>
+
+namespace MR
+{
+
+namespace
+{
+
+bool sameValue( float a, float b )
+{
+    return a == b || ( std::isnan( a ) && std::isnan( b ) );
+}
+
+bool sameCommands( const std::vector<GCommand> & a, const std::vector<GCommand> & b )
+{
+    if ( a.size() != b.size() )
+        return false;
+    for ( size_t i = 0; i < a.size(); ++i )
+    {
+        const auto & ca = a[i];
+        const auto & cb = b[i];
+        if ( ca.type != cb.type || ca.arcPlane != cb.arcPlane || !sameValue( ca.feed, cb.feed )
+            || !sameValue( ca.x, cb.x ) || !sameValue( ca.y, cb.y ) || !sameValue( ca.z, cb.z )
+            || !sameValue( ca.arcCenter.x, cb.arcCenter.x ) || !sameValue( ca.arcCenter.y, cb.arcCenter.y ) || !sameValue( ca.arcCenter.z, cb.arcCenter.z ) )
+            return false;
+    }
+    return true;
+}
+
+// layers of tool paths are prepared in parallel and linked sequentially,
+// so the commands computed in many threads must be the same as computed in one thread
+template<typename F>
+void checkToolPathMatchesSequential( F && computeToolPath )
+{
+    const auto mesh = makeSphere( { .radius = 1.0f, .numMeshVertices = 2000 } );
+    FaceBitSet upper( mesh.topology.faceSize() );
+    for ( auto f : mesh.topology.getValidFaces() )
+        if ( mesh.triCenter( f ).z > 0.3f )
+            upper.set( f );
+
+    for ( const FaceBitSet * region : { (const FaceBitSet *)nullptr, (const FaceBitSet *)&upper } )
+    {
+        for ( bool flatTool : { false, true } )
+        {
+            ConstantCuspParams params;
+            params.millRadius = 0.1f;
+            params.voxelSize = 0.04f;
+            params.sectionStep = 0.1f;
+            params.critTransitionLength = 0.3f;
+            params.plungeLength = 0.1f;
+            params.retractLength = 0.1f;
+            params.plungeFeed = 100.0f;
+            params.retractFeed = 100.0f;
+            params.baseFeed = 500.0f;
+            params.safeZ = 2.0f;
+            params.flatTool = flatTool;
+            const MeshPart mp( mesh, region );
+
+            std::vector<GCommand> seqCommands;
+            {
+                tbb::global_control control( tbb::global_control::max_allowed_parallelism, 1 );
+                auto seqRes = computeToolPath( mp, params );
+                ASSERT_TRUE( seqRes.has_value() ) << seqRes.error();
+                seqCommands = std::move( seqRes->commands );
+            }
+            EXPECT_FALSE( seqCommands.empty() );
+
+            auto res = computeToolPath( mp, params );
+            ASSERT_TRUE( res.has_value() ) << res.error();
+            EXPECT_TRUE( sameCommands( res->commands, seqCommands ) ) << "region: " << bool( region ) << ", flat tool: " << flatTool;
+        }
+    }
+}
+
+} //anonymous namespace
+
+TEST( MRMesh, LacingToolPath )
+{
+    checkToolPathMatchesSequential( [] ( const MeshPart & mp, const ConstantCuspParams & params )
+    {
+        return lacingToolPath( mp, params, Axis::X );
+    } );
+}
+
+TEST( MRMesh, ConstantZToolPath )
+{
+    checkToolPathMatchesSequential( [] ( const MeshPart & mp, const ConstantCuspParams & params )
+    {
+        return constantZToolPath( mp, params );
+    } );
+}
+
+TEST( MRMesh, ConstantCuspToolPath )
+{
+    checkToolPathMatchesSequential( [] ( const MeshPart & mp, const ConstantCuspParams & params )
+    {
+        return constantCuspToolPath( mp, params );
+    } );
+}
+
+} //namespace MR
+
+#endif //!MESHLIB_NO_VOXELS
@@ -9,6 +9,8 @@
 #include "MRMesh/MRVolumeIndexer.h"
 #include "MRMesh/MRParallelFor.h"
 #include "MRMesh/MRTriMesh.h"
+#include "MRMesh/MRMeshSave.h"
+#include <sstream>
 
 namespace MR
 {
@@ -158,6 +160,56 @@ TEST( MRMesh, volumeToMeshByParts )
     EXPECT_NEAR( expectedVolume, mesh.volume(), 0.001f );
 }
 
+TEST( MRMesh, marchingCubesToBinaryStl )
+{
+    const Vector3i dimensions { 64, 64, 64 };
+    constexpr float radius = 25.f;
+    constexpr Vector3f center { 31.5f, 31.5f, 31.5f };
+
+    SimpleVolume volume
+    {
+        .dims = dimensions,
+        .voxelSize = Vector3f::diagonal( 0.1f )
+    };
+    VolumeIndexer indexer( volume.dims );
+    volume.data.resize( indexer.size() );
+    ParallelFor( 0, dimensions.z, [&] ( int z )
+    {
+        for ( auto y = 0; y < dimensions.y; ++y )
+            for ( auto x = 0; x < dimensions.x; ++x )
+                volume.data[indexer.toVoxelId( { x, y, z } )] = ( center - Vector3f( (float)x, (float)y, (float)z ) ).length() - radius;
+    } );
+
+    const MarchingCubesParams params{ .iso = 0.f, .lessInside = true };
+    auto mesh = marchingCubes( volume, params );
+    ASSERT_TRUE( mesh.has_value() );
+    std::ostringstream expected;
+    EXPECT_TRUE( MeshSave::toBinaryStl( *mesh, expected ).has_value() );
+
+    // streaming output must be the same as saving of the mesh
+    std::ostringstream streamed;
+    EXPECT_TRUE( marchingCubesToBinaryStl( volume, streamed, params ).has_value() );
+    EXPECT_EQ( expected.str(), streamed.str() );
+
+    // triangles in the sink come in the order of TriMesh
+    auto triMesh = marchingCubesAsTriMesh( volume, params );
+    ASSERT_TRUE( triMesh.has_value() );
+    FaceId f( 0 );
+    bool sameTris = true;
+    EXPECT_TRUE( marchingCubes( volume, [&]( const std::vector<Triangle3f>& tris )
+    {
+        for ( const auto & t : tris )
+        {
+            const auto & vs = triMesh->tris[f++];
+            for ( int i = 0; i < 3; ++i )
+                sameTris = sameTris && t[i] == triMesh->points[vs[i]];
+        }
+        return true;
+    }, params ).has_value() );
+    EXPECT_EQ( f, triMesh->tris.size() );
+    EXPECT_TRUE( sameTris );
+}
+
 } //namespace MR
 
 #endif //!MESHLIB_NO_VOXELS
@@ -0,0 +1,86 @@
+#ifndef MESHLIB_NO_VOXELS
+
+#include "MRVoxels/MRVoxelFilter.h"
+#include "MRVoxels/MRVoxelsVolume.h"
+#include "MRMesh/MRVolumeIndexer.h"
+#include <gtest/gtest.h>
+
+namespace MR
+{
+
+TEST( MRMesh, VoxelFilterDense )
+{
+    SimpleVolumeU16 vol
+    {
+        .dims = { 23, 19, 37 },
+    };
+    const VolumeIndexer indexer( vol.dims );
+    vol.data.resize( indexer.size() );
+    unsigned seed = 1;
+    for ( auto & v : vol.data )
+    {
+        seed = seed * 1103515245u + 12345u;
+        v = std::uint16_t( ( seed >> 16 ) & 1023 );
+    }
+    SimpleVolume fltVol{ .dims = vol.dims };
+    fltVol.data.resize( indexer.size() );
+    for ( auto v = 0_vox; v < indexer.endId(); ++v )
+        fltVol.data[v] = vol.data[v];
+
+    auto value = [&]( Vector3i p )
+    {
+        p = Vector3i( std::clamp( p.x, 0, vol.dims.x - 1 ), std::clamp( p.y, 0, vol.dims.y - 1 ), std::clamp( p.z, 0, vol.dims.z - 1 ) );
+        return vol.data[indexer.toVoxelId( p )];
+    };
+
+    // compare with brute force computation in cubic window
+    auto maxRes = voxelFilter( vol, VoxelFilterType::Maximum, 5 );
+    auto minRes = voxelFilter( vol, VoxelFilterType::Minimum, 3 );
+    auto medRes = voxelFilter( vol, VoxelFilterType::Median, 3 );
+    auto fltMedRes = voxelFilter( fltVol, VoxelFilterType::Median, 3 );
+    auto meanRes = voxelFilter( fltVol, VoxelFilterType::Mean, 3 );
+    ASSERT_TRUE( maxRes && minRes && medRes && fltMedRes && meanRes );
+    for ( auto v = 0_vox; v < indexer.endId(); ++v )
+    {
+        const auto pos = indexer.toPos( v );
+        std::uint16_t maxVal = 0, minVal = 0xFFFF;
+        float sum = 0;
+        for ( int dz = -2; dz <= 2; ++dz )
+            for ( int dy = -2; dy <= 2; ++dy )
+                for ( int dx = -2; dx <= 2; ++dx )
+                {
+                    const auto val = value( pos + Vector3i( dx, dy, dz ) );
+                    maxVal = std::max( maxVal, val );
+                    if ( std::abs( dx ) <= 1 && std::abs( dy ) <= 1 && std::abs( dz ) <= 1 )
+                    {
+                        minVal = std::min( minVal, val );
+                        sum += val;
+                    }
+                }
+        EXPECT_EQ( maxRes->data[v], maxVal );
+        EXPECT_EQ( minRes->data[v], minVal );
+        EXPECT_EQ( float( medRes->data[v] ), fltMedRes->data[v] );
+        EXPECT_NEAR( meanRes->data[v], sum / 27, 1e-3f );
+    }
+
+    // median filter removes a spike in constant volume, gaussian filter keeps the sum of values
+    SimpleVolume spike{ .dims = { 9, 9, 9 } };
+    spike.data.resize( 9 * 9 * 9, 1.0f );
+    spike.data[VolumeIndexer( spike.dims ).toVoxelId( { 4, 4, 4 } )] = 100.0f;
+    auto spikeMed = voxelFilter( spike, VoxelFilterType::Median, 3 );
+    ASSERT_TRUE( spikeMed );
+    EXPECT_EQ( spikeMed->min, 1.0f );
+    EXPECT_EQ( spikeMed->max, 1.0f );
+    auto spikeGauss = voxelFilter( spike, VoxelFilterType::Gaussian, 5 );
+    ASSERT_TRUE( spikeGauss );
+    double sum = 0;
+    for ( auto v : spikeGauss->data )
+        sum += v;
+    EXPECT_NEAR( sum, 9 * 9 * 9 + 99, 1e-2 );
+
+    EXPECT_FALSE( voxelFilter( spike, VoxelFilterType::Mean, 2 ) );
+}
+
+} //namespace MR
+
+#endif //!MESHLIB_NO_VOXELS
@@ -0,0 +1,47 @@
+#ifndef MESHLIB_NO_VOXELS
+
+#include "MRVoxels/MRVoxelGraphCut.h"
+#include "MRVoxels/MRVoxelsVolume.h"
+#include "MRMesh/MRBitSet.h"
+#include "MRMesh/MRVolumeIndexer.h"
+#include <gtest/gtest.h>
+#include <cmath>
+
+namespace MR
+{
+
+TEST( MRMesh, VoxelGraphCutMultiLevel )
+{
+    // noisy density of a ball with a source seed in its center and sink seeds on the boundary of the volume
+    SimpleVolume vol
+    {
+        .dims = { 50, 48, 46 },
+        .voxelSize = { 0.1f, 0.1f, 0.1f }
+    };
+    const VolumeIndexer indexer( vol.dims );
+    vol.data.resize( indexer.size() );
+    VoxelBitSet sourceSeeds( indexer.size() ), sinkSeeds( indexer.size() );
+    for ( auto v = 0_vox; v < indexer.endId(); ++v )
+    {
+        const auto pos = indexer.toPos( v );
+        const auto dist = ( Vector3f( pos ) - Vector3f( 25, 24, 23 ) ).length();
+        if ( dist < 3 )
+            sourceSeeds.set( v );
+        else if ( indexer.isBdVoxel( pos ) )
+            sinkSeeds.set( v );
+        const auto noise = 0.3f * std::abs( std::sin( 12.9898f * pos.x + 78.233f * pos.y + 37.719f * pos.z ) );
+        vol.data[v] = ( dist < 15 + 2 * std::sin( 0.3f * pos.x ) ? 1.0f : 0.0f ) + noise;
+    }
+
+    auto full = segmentVolumeByGraphCut( vol, 10.0f, sourceSeeds, sinkSeeds );
+    ASSERT_TRUE( full.has_value() );
+    EXPECT_GT( full->count(), 10000 );
+
+    auto multi = segmentVolumeByGraphCutMultiLevel( vol, 10.0f, sourceSeeds, sinkSeeds, { .levels = 1, .minCoarseDim = 8 } );
+    ASSERT_TRUE( multi.has_value() );
+    EXPECT_EQ( *full, *multi );
+}
+
+} //namespace MR
+
+#endif //!MESHLIB_NO_VOXELS
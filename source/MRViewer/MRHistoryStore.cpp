@@ -2,8 +2,14 @@
 #include "MRViewer.h"
 #include "MRMesh/MRCombinedHistoryAction.h"
 #include "MRMesh/MRFinally.h"
+#include "MRMesh/MRStringConvert.h"
+#include "MRMesh/MRTimer.h"
+#include "MRMesh/MRZlib.h"
+#include "MRPch/MRFmt.h"
 #include "MRPch/MRSpdlog.h"
 #include <cassert>
+#include <fstream>
+#include <sstream>
 
 namespace MR
 {
@@ -38,10 +44,20 @@ void HistoryStore::appendAction( std::shared_ptr<HistoryAction> action )
     stack_.resize( firstRedoIndex_ + 1 );
     stack_[firstRedoIndex_] = std::move( action );
     ++firstRedoIndex_;
+    if ( budget_ )
+        dropMissingOffloaded_(); // some redo actions could be removed
 
     changedSignal( *this, ChangeType::PostAppendAction, stack_.back() );
 
+    if ( budget_ && budget_->convertToDiffs && firstRedoIndex_ >= 2 )
+    {
+        const auto & prev = stack_[firstRedoIndex_ - 2];
+        if ( prev && !offloaded_.contains( prev.get() ) && prev->convertToDiff( *stack_[firstRedoIndex_ - 1] ) )
+            spdlog::info( "History action converted to difference: \"{}\"", prev->name() );
+    }
+
     filterByMemoryLimit_();
+    applyMemoryBudget_();
 }
 
 void HistoryStore::clear()
@@ -53,6 +69,7 @@ void HistoryStore::clear()
         return;
     spdlog::info( "History store clear" );
     stack_.clear();
+    dropAllOffloaded_();
     firstRedoIndex_ = 0;
     changedSignal( *this, ChangeType::Clear, {} );
 }
@@ -64,6 +81,7 @@ void HistoryStore::filterStack( HistoryStackFilter filteringCondition, bool deep
         return;
     const auto [needSignal, redoDecrease] = filterHistoryActionsVector( stack_, filteringCondition, firstRedoIndex_, deepFiltering );
     firstRedoIndex_ -= redoDecrease;
+    dropMissingOffloaded_();
     if ( needSignal )
         changedSignal( *this, ChangeType::Filter, {} );
 }
@@ -79,6 +97,8 @@ bool HistoryStore::undo()
     undoRedoInProgress_ = true;
     MR_FINALLY { undoRedoInProgress_ = false; };
     assert( stack_.size() >= firstRedoIndex_ );
+    if ( !restore_( stack_[firstRedoIndex_ - 1] ) )
+        return false;
     if ( stack_[firstRedoIndex_ - 1] )
     {
         spdlog::info( "History action undo: \"{}\"", stack_[firstRedoIndex_ - 1]->name() );
@@ -100,6 +120,8 @@ bool HistoryStore::redo()
 
     undoRedoInProgress_ = true;
     MR_FINALLY { undoRedoInProgress_ = false; };
+    if ( !restore_( stack_[firstRedoIndex_] ) )
+        return false;
     if ( stack_[firstRedoIndex_] )
     {
         spdlog::info( "History action redo: \"{}\"", stack_[firstRedoIndex_]->name() );
@@ -176,6 +198,183 @@ void HistoryStore::filterByMemoryLimit_()
         --savedSceneIndex_;
         changedSignal( *this, ChangeType::PopAction, nullptr );
     }
+    if ( numActionsToDelete > 0 )
+        dropMissingOffloaded_();
+}
+
+void HistoryStore::setMemoryBudget( std::optional<HistoryMemoryBudget> budget )
+{
+    budget_ = std::move( budget );
+    if ( budget_ )
+    {
+        applyMemoryBudget_();
+        return;
+    }
+    for ( const auto & action : stack_ )
+        restore_( action );
+    dropAllOffloaded_();
+}
+
+size_t HistoryStore::calcOffloadedMemory() const
+{
+    size_t res = 0;
+    for ( const auto & [action, data] : offloaded_ )
+        res += data.compressed.capacity();
+    return res;
+}
+
+void HistoryStore::applyMemoryBudget_()
+{
+    if ( !budget_ )
+        return;
+
+    size_t used = calcUsedMemory() + calcOffloadedMemory();
+    if ( used <= budget_->ramLimit )
+        return;
+    MR_TIMER;
+
+    // offload oldest actions except for hot ones
+    const size_t hotBegin = firstRedoIndex_ > budget_->numHotActions ? firstRedoIndex_ - budget_->numHotActions : 0;
+    for ( size_t i = 0; i < hotBegin && used > budget_->ramLimit; ++i )
+    {
+        const auto & action = stack_[i];
+        if ( !action || offloaded_.contains( action.get() ) )
+            continue;
+        const auto before = action->heapBytes();
+        if ( !offload_( action ) )
+            continue;
+        used = used + offloaded_[action.get()].compressed.capacity() + action->heapBytes() - before;
+    }
+
+    if ( !budget_->allowSpillOnDisk )
+        return;
+
+    // spill on disk compressed data of oldest actions
+    for ( size_t i = 0; i < hotBegin && used > budget_->ramLimit; ++i )
+    {
+        const auto it = stack_[i] ? offloaded_.find( stack_[i].get() ) : offloaded_.end();
+        if ( it == offloaded_.end() || it->second.compressed.empty() )
+            continue;
+        const auto size = it->second.compressed.capacity();
+        if ( !spill_( it->second ) )
+            break;
+        used -= size;
+    }
+}
+
+bool HistoryStore::offload_( const std::shared_ptr<HistoryAction>& action )
+{
+    MR_TIMER;
+    std::stringstream raw;
+    if ( !action->offloadData( raw ) )
+        return false;
+
+    std::ostringstream compressed;
+    if ( auto res = zlibCompressStream( raw, compressed, budget_ ? budget_->compressionLevel : 1 ); !res )
+    {
+        spdlog::warn( "History action \"{}\" cannot be compressed: {}", action->name(), res.error() );
+        raw.clear();
+        raw.seekg( 0 );
+        if ( auto restored = action->restoreData( raw ); !restored )
+            spdlog::error( "History action \"{}\" cannot be restored: {}", action->name(), restored.error() );
+        return false;
+    }
+
+    offloaded_[action.get()].compressed = std::move( compressed ).str();
+    spdlog::info( "History action offloaded: \"{}\"", action->name() );
+    return true;
+}
+
+bool HistoryStore::spill_( OffloadedAction& data )
+{
+    if ( !spillFolder_ )
+        spillFolder_ = std::make_unique<UniqueTemporaryFolder>();
+    if ( !*spillFolder_ )
+        return false;
+
+    auto file = *spillFolder_ / fmt::format( "action{}.bin", numSpilledFiles_++ );
+    std::ofstream out( file, std::ofstream::binary );
+    if ( !out || !out.write( data.compressed.data(), data.compressed.size() ) )
+    {
+        spdlog::warn( "Cannot spill history action in file {}", utf8string( file ) );
+        return false;
+    }
+    data.file = std::move( file );
+    data.compressed = {};
+    return true;
+}
+
+bool HistoryStore::restore_( const std::shared_ptr<HistoryAction>& action )
+{
+    if ( !action )
+        return true;
+    const auto it = offloaded_.find( action.get() );
+    if ( it == offloaded_.end() )
+        return true;
+    MR_TIMER;
+
+    auto & data = it->second;
+    if ( !data.file.empty() )
+    {
+        std::ifstream in( data.file, std::ifstream::binary );
+        std::ostringstream buf;
+        buf << in.rdbuf();
+        if ( !in )
+        {
+            spdlog::error( "Cannot read spilled history action from file {}", utf8string( data.file ) );
+            return false;
+        }
+        data.compressed = std::move( buf ).str();
+    }
+
+    std::istringstream in( std::move( data.compressed ) );
+    std::stringstream raw;
+    auto res = zlibDecompressStream( in, raw );
+    if ( res )
+        res = action->restoreData( raw );
+    if ( !res )
+    {
+        spdlog::error( "History action \"{}\" cannot be restored: {}", action->name(), res.error() );
+        return false;
+    }
+
+    if ( !data.file.empty() )
+    {
+        std::error_code ec;
+        std::filesystem::remove( data.file, ec );
+    }
+    offloaded_.erase( it );
+    spdlog::info( "History action restored: \"{}\"", action->name() );
+    return true;
+}
+
+void HistoryStore::dropMissingOffloaded_()
+{
+    if ( offloaded_.empty() )
+        return;
+    HashSet<const HistoryAction*> present;
+    for ( const auto & action : stack_ )
+        present.insert( action.get() );
+    for ( auto it = offloaded_.begin(); it != offloaded_.end(); )
+    {
+        if ( present.contains( it->first ) )
+        {
+            ++it;
+            continue;
+        }
+        if ( !it->second.file.empty() )
+        {
+            std::error_code ec;
+            std::filesystem::remove( it->second.file, ec );
+        }
+        it = offloaded_.erase( it );
+    }
+}
+
+void HistoryStore::dropAllOffloaded_()
+{
+    offloaded_.clear();
+    spillFolder_.reset();
 }
 
 } //namespace MR
@@ -3,7 +3,11 @@
 #include "MRViewerFwd.h"
 #include "MRMesh/MRHistoryAction.h"
 #include "MRMesh/MRSignal.h"
+#include "MRMesh/MRphmap.h"
+#include "MRMesh/MRUniqueTemporaryFolder.h"
+#include <filesystem>
 #include <memory>
+#include <optional>
 
 namespace MR
 {
@@ -11,6 +15,27 @@ namespace MR
 /// \addtogroup HistoryGroup
 /// \{
 
+/// settings of memory-budgeted history mode, where old actions are kept in compact forms instead of full copies in memory
+struct HistoryMemoryBudget
+{
+    /// if true then after appending new action, the previous one is asked to replace full copy of object's data
+    /// with the difference from the state stored in new action (see HistoryAction::convertToDiff)
+    bool convertToDiffs = true;
+
+    /// if undo actions (including compressed offloaded data kept in memory) occupy more than this amount of bytes,
+    /// then the oldest actions are offloaded and compressed, and if it is not enough then the oldest compressed data are spilled on disk
+    size_t ramLimit = size_t( 1 ) << 30;
+
+    /// the number of the most recent undo actions, which are never offloaded to keep their undo fast
+    size_t numHotActions = 1;
+
+    /// if false then compressed data of offloaded actions always stay in memory
+    bool allowSpillOnDisk = true;
+
+    /// zlib compression level of offloaded actions: 0 = no compression, 1 = the fastest, 9 = the smallest
+    int compressionLevel = 1;
+};
+
 /// This class stores history stack for undo/redo
 class MRVIEWER_CLASS HistoryStore
 {
@@ -49,6 +74,20 @@ public:
     /// Compute amount of memory occupied by all actions in this store
     [[nodiscard]] MRVIEWER_API size_t calcUsedMemory() const;
 
+    /// Enables (or disables if nullopt) memory-budgeted mode, where old actions are converted into differences,
+    /// compressed and spilled on disk instead of being kept as is; offloaded actions are restored transparently on undo/redo by this store;
+    /// disabling the mode restores all offloaded actions in memory
+    MRVIEWER_API void setMemoryBudget( std::optional<HistoryMemoryBudget> budget );
+
+    /// Returns current settings of memory-budgeted mode (nullopt if it is disabled)
+    [[nodiscard]] const std::optional<HistoryMemoryBudget>& getMemoryBudget() const { return budget_; }
+
+    /// Returns the number of actions with offloaded data (in compressed form in memory or on disk)
+    [[nodiscard]] size_t numOffloadedActions() const { return offloaded_.size(); }
+
+    /// Returns the amount of memory occupied by compressed data of offloaded actions not spilled on disk
+    [[nodiscard]] MRVIEWER_API size_t calcOffloadedMemory() const;
+
     /// Returns full history stack
     [[nodiscard]] const HistoryActionsVector& getHistoryStack() const { return stack_; }
 
@@ -116,6 +155,39 @@ private:
 
     /// removes all undo actions from the beginning of the stack that exceed memory limit
     void filterByMemoryLimit_();
+
+    /// settings of memory-budgeted mode
+    std::optional<HistoryMemoryBudget> budget_;
+
+    /// data of an offloaded action
+    struct OffloadedAction
+    {
+        std::string compressed; ///< compressed data in memory, empty if spilled on disk
+        std::filesystem::path file; ///< file with compressed data if spilled on disk
+    };
+    HashMap<const HistoryAction*, OffloadedAction> offloaded_;
+
+    /// temporary folder for spilled data, created on first need
+    std::unique_ptr<UniqueTemporaryFolder> spillFolder_;
+    size_t numSpilledFiles_{ 0 };
+
+    /// offloads and spills oldest actions to satisfy memory budget
+    void applyMemoryBudget_();
+
+    /// offloads the data of given action and compresses them in memory
+    bool offload_( const std::shared_ptr<HistoryAction>& action );
+
+    /// writes compressed data of offloaded action in temporary file
+    bool spill_( OffloadedAction& data );
+
+    /// restores offloaded data of given action if necessary
+    bool restore_( const std::shared_ptr<HistoryAction>& action );
+
+    /// forgets offloaded data of the actions that are not in the stack anymore
+    void dropMissingOffloaded_();
+
+    /// forgets offloaded data of all actions
+    void dropAllOffloaded_();
 };
 
 /// \}
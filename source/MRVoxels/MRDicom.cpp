@@ -99,39 +99,27 @@ struct DCMFileLoadResult
     AffineXf3f xf;
 };
 
-template <typename T>
-DCMFileLoadResult loadSingleFile( const std::filesystem::path& path, T& data, size_t offset )
+std::string readSeriesDescription( const gdcm::DataSet& ds )
 {
-    MR_TIMER;
-    DCMFileLoadResult res;
-
-    std::ifstream fstr( path, std::ifstream::binary );
-    gdcm::ImageReader ir;
-    ir.SetStream( fstr );
-
-    if ( !ir.Read() )
-    {
-        spdlog::error( "Cannot read image from DICOM file {}", utf8string( path ) );
-        return res;
-    }
-
-    const gdcm::DataSet& ds = ir.GetFile().GetDataSet();
-    if( ds.FindDataElement( gdcm::Keywords::SeriesDescription::GetTag() ) )
-    {
-        const gdcm::DataElement& de = ds.GetDataElement( gdcm::Keywords::SeriesDescription::GetTag() );
-        gdcm::Keywords::SeriesDescription desc;
-        desc.SetFromDataElement( de );
-        auto descVal = desc.GetValue();
-        res.seriesDescription = descVal;
-    }
+    if( !ds.FindDataElement( gdcm::Keywords::SeriesDescription::GetTag() ) )
+        return {};
+    const gdcm::DataElement& de = ds.GetDataElement( gdcm::Keywords::SeriesDescription::GetTag() );
+    gdcm::Keywords::SeriesDescription desc;
+    desc.SetFromDataElement( de );
+    return desc.GetValue();
+}
 
+/// returns the transformation from image to patient coordinates
+AffineXf3f readPatientXf( const gdcm::DataSet& ds )
+{
+    AffineXf3f xf;
     if( ds.FindDataElement( gdcm::Keywords::ImagePositionPatient::GetTag() ) )
     {
         gdcm::DataElement dePosition = ds.GetDataElement( gdcm::Keywords::ImagePositionPatient::GetTag() );
         gdcm::Keywords::ImagePositionPatient atPos;
         atPos.SetFromDataElement( dePosition );
         for (int i = 0; i < 3; ++i) {
-            res.xf.b[i] = float( atPos.GetValue( i ) );
+            xf.b[i] = float( atPos.GetValue( i ) );
         }
     }
 
@@ -141,15 +129,95 @@ DCMFileLoadResult loadSingleFile( const std::filesystem::path& path, T& data, si
         gdcm::Keywords::ImageOrientationPatient atOri;
         atOri.SetFromDataElement( deOri );
         for (int i = 0; i < 3; ++i)
-            res.xf.A.x[i] = float( atOri.GetValue( i ) );
+            xf.A.x[i] = float( atOri.GetValue( i ) );
         for (int i = 0; i < 3; ++i)
-            res.xf.A.y[i] = float( atOri.GetValue( 3 + i ) );
+            xf.A.y[i] = float( atOri.GetValue( 3 + i ) );
+    }
+
+    xf.A.x = xf.A.x.normalized();
+    xf.A.y = xf.A.y.normalized();
+    xf.A.z = cross( xf.A.x, xf.A.y );
+    xf.A = xf.A.transposed();
+    return xf;
+}
+
+/// fills zero components of voxel size (in meters) from the file header, \p spacing is the image spacing in millimeters;
+/// returns true if the frames of 3D image are stored in inverted Z order
+bool readVoxelSize( const gdcm::File& file, unsigned dimsNum, const double* spacing, Vector3f& voxelSize )
+{
+    bool needInvertZ = false;
+    if ( voxelSize[0] != 0.0f )
+        return needInvertZ;
+
+    const gdcm::DataSet& ds = file.GetDataSet();
+    // use "spacingVec.empty()" instead of "spacing == (1,1,1)" to handle case when spacing is actually (1,1,1)
+    auto spacingVec = gdcm::ImageHelper::GetSpacingValue( file );
+    if ( spacingVec.empty() && ds.FindDataElement( gdcm::Keywords::PixelSpacing::GetTag() ) )
+    {
+        // gdcm was unable to find the spacing, so find it by ourselves
+        const gdcm::DataElement& de = ds.GetDataElement( gdcm::Keywords::PixelSpacing::GetTag() );
+        gdcm::Keywords::PixelSpacing desc;
+        desc.SetFromDataElement( de );
+        voxelSize.x = float( desc.GetValue( 0 ) / 1000 );
+        voxelSize.y = float( desc.GetValue( 1 ) / 1000 );
+    }
+    else
+    {
+        voxelSize.x = float( spacing[0] / 1000 );
+        voxelSize.y = float( spacing[1] / 1000 );
+    }
+    if ( voxelSize.z == 0.0f )
+    {
+        if ( dimsNum == 3 )
+        {
+            float spacingZ = 0.0f;
+            if ( ds.FindDataElement( gdcm::Keywords::SpacingBetweenSlices::GetTag() ) )
+            {
+                const gdcm::DataElement& de = ds.GetDataElement( gdcm::Keywords::SpacingBetweenSlices::GetTag() );
+                gdcm::Keywords::SpacingBetweenSlices desc;
+                desc.SetFromDataElement( de );
+                spacingZ = float( desc.GetValue() );
+                // looks like if this tag is set image stored inverted by Z
+                // no other tags was found to determine orientation (compared with cases without this tag)
+                needInvertZ = spacingZ > 0.0f;
+            }
+            else
+            {
+                spacingZ = float( spacing[2] );
+                needInvertZ = spacingZ < 0.0f;
+            }
+            voxelSize.z = std::abs( spacingZ ) * 1e-3f;
+        }
+        else
+            voxelSize.z = voxelSize.x;
+    }
+    return needInvertZ;
+}
+
+bool isMonochrome( const gdcm::PhotometricInterpretation& pi )
+{
+    return pi == gdcm::PhotometricInterpretation::MONOCHROME2 || pi == gdcm::PhotometricInterpretation::MONOCHROME1;
+}
+
+template <typename T>
+DCMFileLoadResult loadSingleFile( const std::filesystem::path& path, T& data, size_t offset )
+{
+    MR_TIMER;
+    DCMFileLoadResult res;
+
+    std::ifstream fstr( path, std::ifstream::binary );
+    gdcm::ImageReader ir;
+    ir.SetStream( fstr );
+
+    if ( !ir.Read() )
+    {
+        spdlog::error( "Cannot read image from DICOM file {}", utf8string( path ) );
+        return res;
     }
 
-    res.xf.A.x = res.xf.A.x.normalized();
-    res.xf.A.y = res.xf.A.y.normalized();
-    res.xf.A.z = cross( res.xf.A.x, res.xf.A.y );
-    res.xf.A = res.xf.A.transposed();
+    const gdcm::DataSet& ds = ir.GetFile().GetDataSet();
+    res.seriesDescription = readSeriesDescription( ds );
+    res.xf = readPatientXf( ds );
 
     const auto& gimage = ir.GetImage();
     auto dimsNum = gimage.GetNumberOfDimensions();
@@ -167,56 +235,14 @@ DCMFileLoadResult loadSingleFile( const std::filesystem::path& path, T& data, si
     }
     if ( data.voxelSize[0] == 0.0f )
     {
-        // use "spacingVec.empty()" instead of "spacing == (1,1,1)" to handle case when spacing is actually (1,1,1)
-        auto spacingVec = gdcm::ImageHelper::GetSpacingValue( ir.GetFile() );
-        const double* spacing = gimage.GetSpacing();
-        if ( spacingVec.empty() && ds.FindDataElement( gdcm::Keywords::PixelSpacing::GetTag() ) )
-        {
-            // gdcm was unable to find the spacing, so find it by ourselves
-            const gdcm::DataElement& de = ds.GetDataElement( gdcm::Keywords::PixelSpacing::GetTag() );
-            gdcm::Keywords::PixelSpacing desc;
-            desc.SetFromDataElement( de );
-            data.voxelSize.x = float( desc.GetValue( 0 ) / 1000 );
-            data.voxelSize.y = float( desc.GetValue( 1 ) / 1000 );
-        }
-        else
-        {
-            data.voxelSize.x = float( spacing[0] / 1000 );
-            data.voxelSize.y = float( spacing[1] / 1000 );
-        }
-        if ( data.voxelSize.z == 0.0f )
-        {
-            if ( dimsNum == 3 )
-            {
-                float spacingZ = 0.0f;
-                if ( ds.FindDataElement( gdcm::Keywords::SpacingBetweenSlices::GetTag() ) )
-                {
-                    const gdcm::DataElement& de = ds.GetDataElement( gdcm::Keywords::SpacingBetweenSlices::GetTag() );
-                    gdcm::Keywords::SpacingBetweenSlices desc;
-                    desc.SetFromDataElement( de );
-                    spacingZ = float( desc.GetValue() );
-                    // looks like if this tag is set image stored inverted by Z
-                    // no other tags was found to determine orientation (compared with cases without this tag)
-                    needInvertZ = spacingZ > 0.0f;
-                }
-                else
-                {
-                    spacingZ = float( spacing[2] );
-                    needInvertZ = spacingZ < 0.0f;
-                }
-                data.voxelSize.z = std::abs( spacingZ ) * 1e-3f;
-            }
-            else
-                data.voxelSize.z = data.voxelSize.x;
-        }
+        needInvertZ = readVoxelSize( ir.GetFile(), dimsNum, gimage.GetSpacing(), data.voxelSize );
     }
     else if ( data.dims.x != (int) dims[0] || data.dims.y != (int) dims[1] )
     {
         spdlog::error( "loadSingle: dimensions are inconsistent with other files, file: {}", utf8string( path ) );
         return res;
     }
-    if ( gimage.GetPhotometricInterpretation() != gdcm::PhotometricInterpretation::MONOCHROME2 &&
-         gimage.GetPhotometricInterpretation() != gdcm::PhotometricInterpretation::MONOCHROME1 )
+    if ( !isMonochrome( gimage.GetPhotometricInterpretation() ) )
     {
         spdlog::error( "loadSingle: unexpected PhotometricInterpretation, file: {}", utf8string( path ) );
         spdlog::error( "PhotometricInterpretation: {}", (int)gimage.GetPhotometricInterpretation() );
@@ -738,6 +764,440 @@ Expected<DicomVolumeT<T>> loadDicomFolder( const std::filesystem::path& path, un
     return loadSingleDicomFolder<T>( seriesMap->begin()->second, maxNumThreads, subprogress( cb, 0.3f, 1.0f ) );
 }
 
+/// the information about DICOM series read from the headers of its files without decoding of pixel data
+struct SeriesHeader
+{
+    Vector3i dims;              ///< dimensions of the series in voxels
+    Vector3f voxelSize;
+    int framesPerFile = 1;      ///< greater than 1 only for the series of single 3D file
+    bool needInvertZ = false;   ///< the frames of 3D file are stored in decreasing Z order
+    ScalarType scalarType = ScalarType::Unknown;
+    int pixelSize = 0;          ///< in bytes
+    double slope = 1;
+    double intercept = 0;
+    std::string seriesDescription;
+    AffineXf3f xf;
+    std::vector<int> sliceFiles; ///< the index of file for each slice of multi-file series, or -1 for missed slices
+};
+
+Expected<SeriesHeader> readSeriesHeader( std::vector<std::filesystem::path>& files, unsigned maxNumThreads )
+{
+    MR_TIMER;
+    if ( files.empty() )
+        return unexpected( "loadDicomFolder: there is no dcm file" );
+
+    SeriesInfo seriesInfo;
+    if ( files.size() > 1 )
+        seriesInfo = sortDICOMFiles( files, maxNumThreads );
+
+    std::ifstream ifs( files.front(), std::ios_base::binary );
+    gdcm::ImageReader ir;
+    ir.SetStream( ifs );
+    if ( !ir.ReadUpToTag( gdcm::Tag( 0x7FE0, 0x0010 ) ) ) // pixel data
+        return unexpected( "loadDicomFolder: cannot read header of file " + utf8string( files.front() ) );
+    const gdcm::File& file = ir.GetFile();
+
+    SeriesHeader res;
+    res.seriesDescription = readSeriesDescription( file.GetDataSet() );
+    res.xf = readPatientXf( file.GetDataSet() );
+
+    if ( !isMonochrome( gdcm::ImageHelper::GetPhotometricInterpretationValue( file ) ) )
+        return unexpected( "loadDicomFolder: unexpected PhotometricInterpretation, file: " + utf8string( files.front() ) );
+
+    const auto dims = gdcm::ImageHelper::GetDimensionsValue( file );
+    if ( dims.size() != 3 || dims[0] == 0 || dims[1] == 0 || dims[2] == 0 )
+        return unexpected( "loadDicomFolder: unsupported dimensions, file: " + utf8string( files.front() ) );
+    res.framesPerFile = int( dims[2] );
+    if ( files.size() > 1 && res.framesPerFile != 1 )
+        return unexpected( "loadDicomFolder: series of multi-frame files is not supported" );
+
+    const auto pixelFormat = gdcm::ImageHelper::GetPixelFormatValue( file );
+    res.scalarType = convertToScalarType( pixelFormat );
+    res.pixelSize = int( pixelFormat.GetPixelSize() );
+    if ( res.scalarType == ScalarType::Unknown )
+        return unexpected( "loadDicomFolder: unsupported pixel format, file: " + utf8string( files.front() ) );
+
+    const auto interceptSlope = gdcm::ImageHelper::GetRescaleInterceptSlopeValue( file );
+    if ( interceptSlope.size() == 2 )
+    {
+        res.intercept = interceptSlope[0];
+        res.slope = interceptSlope[1];
+    }
+
+    res.voxelSize = Vector3f();
+    if ( seriesInfo.sliceSize != 0.0f )
+        res.voxelSize.z = seriesInfo.sliceSize;
+    auto spacing = gdcm::ImageHelper::GetSpacingValue( file );
+    spacing.resize( 3, 1.0 );
+    res.needInvertZ = readVoxelSize( file, res.framesPerFile > 1 ? 3 : 2, spacing.data(), res.voxelSize );
+
+    res.dims = Vector3i( int( dims[0] ), int( dims[1] ), res.framesPerFile );
+    if ( files.size() > 1 )
+    {
+        auto presentSlices = seriesInfo.missedSlices;
+        presentSlices.resize( std::max( seriesInfo.numSlices, int( files.size() ) ) );
+        presentSlices.flip();
+        if ( seriesInfo.numSlices == 0 || presentSlices.count() != files.size() )
+        {
+            // no consistent instance numbers, so every file is a slice
+            presentSlices.clear();
+            presentSlices.resize( files.size(), true );
+        }
+        res.dims.z = int( presentSlices.size() );
+        res.sliceFiles.resize( presentSlices.size(), -1 );
+        int fileIndex = 0;
+        for ( auto slice : presentSlices )
+            res.sliceFiles[slice] = fileIndex++;
+    }
+    return res;
+}
+
+/// decodes pixel data of given DICOM file directly in the memory of expected size, and checks the consistency of the file with the series header;
+/// returns the rescale slope and intercept of the file
+bool decodeFile( const std::filesystem::path& path, const SeriesHeader& header, char* dst, size_t numBytes, double& slope, double& intercept )
+{
+    std::ifstream fstr( path, std::ifstream::binary );
+    gdcm::ImageReader ir;
+    ir.SetStream( fstr );
+    if ( !ir.Read() )
+    {
+        spdlog::error( "Cannot read image from DICOM file {}", utf8string( path ) );
+        return false;
+    }
+
+    const auto& gimage = ir.GetImage();
+    const unsigned* dims = gimage.GetDimensions();
+    if ( header.dims.x != (int)dims[0] || header.dims.y != (int)dims[1] )
+    {
+        spdlog::error( "loadDicomFolder: dimensions are inconsistent with other files, file: {}", utf8string( path ) );
+        return false;
+    }
+    if ( convertToScalarType( gimage.GetPixelFormat() ) != header.scalarType || gimage.GetBufferLength() != numBytes )
+    {
+        spdlog::error( "loadDicomFolder: pixel format is inconsistent with other files, file: {}", utf8string( path ) );
+        return false;
+    }
+    if ( !gimage.GetBuffer( dst ) )
+    {
+        spdlog::error( "loadDicomFolder: cannot load data from file: {}", utf8string( path ) );
+        return false;
+    }
+    slope = gimage.GetSlope();
+    intercept = gimage.GetIntercept();
+    return true;
+}
+
+/// the shift making the values of signed 8- and 16-bit pixels nonnegative
+float unsignedShift( ScalarType scalarType )
+{
+    return scalarType == ScalarType::Int8 || scalarType == ScalarType::Int16 ? 32768.f : 0.f;
+}
+
+/// calls f( pixels ) with the pointer to the pixels converted in given scalar type, returns false for unknown type
+template <typename F>
+bool visitPixels( ScalarType scalarType, const char* pixels, F&& f )
+{
+    return visitScalarType( [&] ( auto v )
+    {
+        f( reinterpret_cast<const decltype( v )*>( pixels ) );
+        return true;
+    }, scalarType, pixels );
+}
+
+/// decodes the slices of the series in parallel in preallocated volume with values ( k * pixel + b ),
+/// where k and b are the rescale parameters of each file for float volume, and 1 and the shift of signed pixels for 16-bit volume
+template <typename T>
+Expected<VoxelsVolumeMinMax<Vector<T, VoxelId>>> loadDenseSeries( const std::vector<std::filesystem::path>& files, const SeriesHeader& header,
+    const DicomFolderLoadSettings& settings, const ProgressCallback& cb )
+{
+    MR_TIMER;
+    constexpr bool isU16 = std::is_same_v<T, uint16_t>;
+    const float shift = unsignedShift( header.scalarType );
+    if constexpr ( isU16 )
+    {
+        if ( header.pixelSize > 2 )
+            return unexpected( "loadDicomFolder: only 8- and 16-bit pixels can be loaded in 16-bit volume" );
+    }
+    if ( settings.downsample < 1 )
+        return unexpected( "loadDicomFolder: downsample factor must be positive" );
+
+    const int d = settings.downsample;
+    const Vector3i& dims = header.dims;
+    VoxelsVolumeMinMax<Vector<T, VoxelId>> res;
+    res.dims = Vector3i( ( dims.x + d - 1 ) / d, ( dims.y + d - 1 ) / d, ( dims.z + d - 1 ) / d );
+    res.voxelSize = header.voxelSize * float( d );
+    const size_t inXY = size_t( dims.x ) * dims.y;
+    const size_t outXY = size_t( res.dims.x ) * res.dims.y;
+    const size_t frameBytes = inXY * header.pixelSize;
+    res.data.resize( outXY * res.dims.z );
+
+    // 16-bit pixels are decoded directly in their places in the volume
+    const bool direct = isU16 && d == 1 && header.pixelSize == 2;
+
+    // single file with all frames is decoded at once: directly in the volume if possible, otherwise in the buffer of all raw frames
+    std::vector<char> fileBuffer;
+    double fileSlope = header.slope, fileIntercept = header.intercept;
+    if ( header.sliceFiles.empty() )
+    {
+        char* dst = nullptr;
+        if ( direct && !header.needInvertZ )
+            dst = reinterpret_cast<char*>( res.data.data() );
+        else
+        {
+            fileBuffer.resize( frameBytes * dims.z );
+            dst = fileBuffer.data();
+        }
+        if ( !decodeFile( files.front(), header, dst, frameBytes * dims.z, fileSlope, fileIntercept ) )
+            return unexpected( "loadDicomFolder: error loading file \"" + utf8string( files.front() ) + "\"" );
+        if ( isU16 && ( fileSlope != header.slope || fileIntercept != header.intercept ) )
+            return unexpected( "loadDicomFolder: inconsistent rescale parameters in file \"" + utf8string( files.front() ) + "\"" );
+    }
+    if ( !reportProgress( cb, 0.1f ) )
+        return unexpectedOperationCanceled();
+
+    struct Buffers
+    {
+        std::vector<char> pixels;
+        std::vector<float> sum;
+    };
+    // the range of values in each output slice, invalid for missed slices
+    std::vector<MinMaxf> sliceMinMax( res.dims.z );
+    std::atomic<int> failedFile = -1;
+
+    // returns pixels of given slice in the buffer, or nullptr for missed slice or error
+    auto getFrame = [&] ( int z, Buffers& buf, float& k, float& b ) -> const char*
+    {
+        const char* frame = nullptr;
+        double slope = fileSlope, intercept = fileIntercept;
+        if ( header.sliceFiles.empty() )
+        {
+            frame = fileBuffer.data() + frameBytes * ( header.needInvertZ ? dims.z - 1 - z : z );
+        }
+        else
+        {
+            const int fileIndex = header.sliceFiles[z];
+            if ( fileIndex < 0 )
+                return nullptr;
+            buf.pixels.resize( frameBytes );
+            if ( !decodeFile( files[fileIndex], header, buf.pixels.data(), frameBytes, slope, intercept ) )
+            {
+                failedFile = fileIndex;
+                return nullptr;
+            }
+            if ( isU16 && ( slope != header.slope || intercept != header.intercept ) )
+            {
+                spdlog::error( "loadDicomFolder: rescale parameters are inconsistent with other files, file: {}", utf8string( files[fileIndex] ) );
+                failedFile = fileIndex;
+                return nullptr;
+            }
+            frame = buf.pixels.data();
+        }
+        if constexpr ( isU16 )
+        {
+            k = 1.f;
+            b = shift;
+        }
+        else
+        {
+            k = float( slope );
+            b = float( intercept );
+        }
+        return frame;
+    };
+
+    tbb::task_arena limitedArena( settings.maxNumThreads );
+    tbb::enumerable_thread_specific<Buffers> tls;
+    bool cancelCalled = false;
+    limitedArena.execute( [&]
+    {
+        cancelCalled = !ParallelFor( 0, res.dims.z, tls, [&] ( int zo, Buffers& buf )
+        {
+            if ( failedFile >= 0 )
+                return;
+            T* dst = res.data.data() + zo * outXY;
+            bool decodedInPlace = false;
+            if ( direct && !header.sliceFiles.empty() )
+            {
+                const int fileIndex = header.sliceFiles[zo];
+                if ( fileIndex < 0 )
+                    return;
+                double slope = 0, intercept = 0;
+                if ( !decodeFile( files[fileIndex], header, reinterpret_cast<char*>( dst ), frameBytes, slope, intercept ) )
+                {
+                    failedFile = fileIndex;
+                    return;
+                }
+                if ( slope != header.slope || intercept != header.intercept )
+                {
+                    spdlog::error( "loadDicomFolder: rescale parameters are inconsistent with other files, file: {}", utf8string( files[fileIndex] ) );
+                    failedFile = fileIndex;
+                    return;
+                }
+                decodedInPlace = true;
+            }
+            else if ( direct && !header.needInvertZ )
+            {
+                // the whole file is already decoded in the volume
+                decodedInPlace = true;
+            }
+            else if ( d == 1 )
+            {
+                float k = 1, b = 0;
+                const char* frame = getFrame( zo, buf, k, b );
+                if ( !frame )
+                    return;
+                visitPixels( header.scalarType, frame, [&] ( auto pixels )
+                {
+                    for ( size_t i = 0; i < inXY; ++i )
+                        dst[i] = T( k * float( pixels[i] ) + b );
+                } );
+            }
+            else
+            {
+                buf.sum.assign( outXY, 0.f );
+                int numFrames = 0;
+                for ( int z = zo * d; z < std::min( zo * d + d, dims.z ); ++z )
+                {
+                    float k = 1, b = 0;
+                    const char* frame = getFrame( z, buf, k, b );
+                    if ( !frame )
+                    {
+                        if ( failedFile >= 0 )
+                            return;
+                        continue;
+                    }
+                    ++numFrames;
+                    visitPixels( header.scalarType, frame, [&] ( auto pixels )
+                    {
+                        for ( int y = 0; y < dims.y; ++y )
+                        {
+                            float* sumRow = buf.sum.data() + size_t( y / d ) * res.dims.x;
+                            const auto* row = pixels + size_t( y ) * dims.x;
+                            for ( int xo = 0, x = 0; xo < res.dims.x; ++xo )
+                                for ( const int xEnd = std::min( x + d, dims.x ); x < xEnd; ++x )
+                                    sumRow[xo] += k * float( row[x] ) + b;
+                        }
+                    } );
+                }
+                if ( numFrames == 0 )
+                    return;
+                for ( int yo = 0; yo < res.dims.y; ++yo )
+                {
+                    const int ny = std::min( d, dims.y - yo * d );
+                    for ( int xo = 0; xo < res.dims.x; ++xo )
+                    {
+                        const int nx = std::min( d, dims.x - xo * d );
+                        const size_t i = size_t( yo ) * res.dims.x + xo;
+                        const float avg = buf.sum[i] / float( nx * ny * numFrames );
+                        if constexpr ( isU16 )
+                            dst[i] = T( avg + 0.5f );
+                        else
+                            dst[i] = avg;
+                    }
+                }
+            }
+
+            if constexpr ( isU16 )
+            {
+                // shift signed pixels decoded in place to unsigned range
+                if ( decodedInPlace && header.scalarType == ScalarType::Int16 )
+                    for ( size_t i = 0; i < outXY; ++i )
+                        dst[i] ^= T( 0x8000 );
+            }
+            auto& mm = sliceMinMax[zo];
+            for ( size_t i = 0; i < outXY; ++i )
+            {
+                mm.min = std::min( mm.min, float( dst[i] ) );
+                mm.max = std::max( mm.max, float( dst[i] ) );
+            }
+        }, subprogress( cb, 0.1f, 0.9f ), 1 );
+    } );
+    if ( cancelCalled )
+        return unexpectedOperationCanceled();
+    if ( failedFile >= 0 )
+        return unexpected( "loadDicomFolder: error loading file \"" + utf8string( files[failedFile] ) + "\"" );
+    BitSet missedSlices( res.dims.z );
+    for ( int z = 0; z < res.dims.z; ++z )
+        missedSlices.set( z, !sliceMinMax[z].valid() );
+    if ( missedSlices.count() == missedSlices.size() )
+        return unexpected( "loadDicomFolder: no slice could be loaded" );
+
+    // fill missed slices by linear interpolation of the closest present slices
+    if ( missedSlices.any() )
+    {
+        cancelCalled = !ParallelFor( 0, res.dims.z, [&] ( int z )
+        {
+            if ( !missedSlices.test( z ) )
+                return;
+            int below = z, above = z;
+            while ( below >= 0 && missedSlices.test( below ) )
+                --below;
+            while ( above < res.dims.z && missedSlices.test( above ) )
+                ++above;
+            if ( below < 0 )
+                below = above;
+            if ( above == res.dims.z )
+                above = below;
+            const float ratio = above == below ? 0.f : float( z - below ) / float( above - below );
+            const T* botSlice = res.data.data() + below * outXY;
+            const T* topSlice = res.data.data() + above * outXY;
+            T* dst = res.data.data() + z * outXY;
+            for ( size_t i = 0; i < outXY; ++i )
+            {
+                const float v = float( botSlice[i] ) * ( 1.0f - ratio ) + float( topSlice[i] ) * ratio;
+                if constexpr ( isU16 )
+                    dst[i] = T( v + 0.5f );
+                else
+                    dst[i] = v;
+            }
+        }, subprogress( cb, 0.9f, 1.0f ) );
+        if ( cancelCalled )
+            return unexpectedOperationCanceled();
+    }
+
+    MinMaxf mm;
+    for ( const auto& sliceMm : sliceMinMax )
+        mm.include( sliceMm );
+    res.min = T( mm.min );
+    res.max = T( mm.max );
+    return res;
+}
+
+template <typename T>
+Expected<DicomVolumeT<VoxelsVolumeMinMax<Vector<T, VoxelId>>>> loadDicomFolderDense( const std::filesystem::path& path,
+    const DicomFolderLoadSettings& settings, SeriesHeader* outHeader )
+{
+    MR_TIMER;
+    auto seriesMap = extractDCMSeries( path, subprogress( settings.cb, 0.0f, 0.3f ) );
+    if ( !seriesMap.has_value() )
+        return unexpected( std::move( seriesMap.error() ) );
+
+    auto& files = seriesMap->begin()->second;
+    auto header = readSeriesHeader( files, settings.maxNumThreads );
+    if ( !header )
+        return unexpected( std::move( header.error() ) );
+    if ( !reportProgress( settings.cb, 0.35f ) )
+        return unexpectedOperationCanceled();
+
+    auto vol = loadDenseSeries<T>( files, *header, settings, subprogress( settings.cb, 0.35f, 1.0f ) );
+    if ( !vol )
+        return unexpected( std::move( vol.error() ) );
+
+    DicomVolumeT<VoxelsVolumeMinMax<Vector<T, VoxelId>>> res;
+    res.vol = std::move( *vol );
+    if ( header->seriesDescription.empty() )
+         res.name = utf8string( files.front().parent_path().stem() );
+    else
+         res.name = header->seriesDescription;
+    res.xf = header->xf;
+    if ( outHeader )
+        *outHeader = std::move( *header );
+
+    TelemetrySignal( fmt::format( "Open DICOM folder {}x{}x{}", res.vol.dims.x, res.vol.dims.y, res.vol.dims.z ) );
+
+    return res;
+}
+
 } // anonymous namespace
 
 DicomStatus isDicomFile( const std::filesystem::path& path, std::string* seriesUid, Vector3i* outDims )
@@ -933,6 +1393,26 @@ Expected<DicomVolumeAsVdb> loadDicomFolderAsVdb( const std::filesystem::path& pa
     return loadDicomFolder<VdbVolume>( path, maxNumThreads, cb );
 }
 
+Expected<DicomVolume> loadDicomFolderDense( const std::filesystem::path& path, const DicomFolderLoadSettings& settings )
+{
+    return loadDicomFolderDense<float>( path, settings, nullptr );
+}
+
+Expected<DicomVolumeU16> loadDicomFolderDenseU16( const std::filesystem::path& path, const DicomFolderLoadSettings& settings )
+{
+    SeriesHeader header;
+    auto loaded = loadDicomFolderDense<uint16_t>( path, settings, &header );
+    if ( !loaded )
+        return unexpected( std::move( loaded.error() ) );
+
+    DicomVolumeU16 res;
+    static_cast<DicomVolumeT<SimpleVolumeMinMaxU16>&>( res ) = std::move( *loaded );
+    const float shift = unsignedShift( header.scalarType );
+    res.sourceScale.min = float( header.slope * ( 0 - shift ) + header.intercept );
+    res.sourceScale.max = float( header.slope * ( 65535 - shift ) + header.intercept );
+    return res;
+}
+
 Expected<DicomVolume> loadDicomFile( const std::filesystem::path& file, const ProgressCallback& cb )
 {
     return loadDicomFile<SimpleVolumeMinMax>( file, cb );
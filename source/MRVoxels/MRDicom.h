@@ -74,6 +74,38 @@ MRVOXELS_API Expected<DicomVolume> loadDicomFolder( const std::filesystem::path&
 /// Loads one volume from DICOM files located in given folder as VdbVolume
 MRVOXELS_API Expected<DicomVolumeAsVdb> loadDicomFolderAsVdb( const std::filesystem::path& path, unsigned maxNumThreads, const ProgressCallback& cb = {} );
 
+/// DICOM volume with the stored 16-bit pixel values
+struct DicomVolumeU16 : DicomVolumeT<SimpleVolumeMinMaxU16>
+{
+    /// the physical values (e.g. in Hounsfield units) corresponding to voxel values 0 and 65535, the mapping between them is linear;
+    /// it can be passed in VoxelsSave::toDicom to save the volume back
+    MinMaxf sourceScale;
+};
+
+struct DicomFolderLoadSettings
+{
+    /// maximal number of threads decoding the slices in parallel
+    unsigned maxNumThreads = 4;
+
+    /// if greater than 1, then each block of downsample x downsample x downsample voxels is averaged in one voxel of the result during decoding,
+    /// the blocks on the upper boundaries of the volume can be incomplete
+    int downsample = 1;
+
+    ProgressCallback cb;
+};
+
+/// Loads one volume from DICOM files located in given folder as SimpleVolumeMinMax without intermediate volumes:
+/// first the headers of the files are read to find the dimensions, and the final volume is allocated once,
+/// then the slices are decoded in parallel each in its place of the volume reusing one pixel buffer per thread;
+/// a single multi-frame file is decoded at once, so its raw pixels are kept in one more buffer of the whole series size during conversion
+MRVOXELS_API Expected<DicomVolume> loadDicomFolderDense( const std::filesystem::path& path, const DicomFolderLoadSettings& settings = {} );
+
+/// Loads one volume from DICOM files located in given folder as SimpleVolumeMinMaxU16 keeping the stored pixel values
+/// (shifted by 32768 for signed formats), only 8- and 16-bit pixel formats with the same rescale parameters in all files are supported;
+/// the 16-bit pixels are decoded directly in the memory of the final volume if no downsampling is requested
+/// (except for a single multi-frame file with inverted Z order, which needs one more buffer of the whole series size as in loadDicomFolderDense)
+MRVOXELS_API Expected<DicomVolumeU16> loadDicomFolderDenseU16( const std::filesystem::path& path, const DicomFolderLoadSettings& settings = {} );
+
 /// Loads all volumes from DICOM files located in given folder as a number of SimpleVolumeMinMax
 MRVOXELS_API std::vector<Expected<DicomVolume>> loadDicomsFolder( const std::filesystem::path& path, unsigned maxNumThreads, const ProgressCallback& cb = {} );
 
@@ -10,6 +10,7 @@
 #include "MRMesh/MRTimer.h"
 #include "MRMesh/MRParallelFor.h"
 #include "MRMesh/MRTriMesh.h"
+#include "MRMesh/MRMeshSave.h"
 
 #include <thread>
 
@@ -333,6 +334,10 @@ public:
     template<typename V>
     static Expected<TriMesh> run( const V& volume, const MarchingCubesParams& params, int layersPerBlock = 0 );
 
+    /// performs everything inside to convert volume into triangles passed to the sink block by block
+    template<typename V>
+    static Expected<void> run( const V& volume, const MarchingCubesParams& params, const TrianglesSink& sink, int layersPerBlock = 0 );
+
 public: // custom interface
     /// prepares convention for given volume dimensions and given parameters
     /// \param layersPerBlock all z-slices of the volume will be partitioned on blocks of given size to process in parallel (0 means auto-select layersPerBlock)
@@ -345,6 +350,9 @@ public: // custom interface
     /// finishes processing and outputs produced trimesh
     Expected<TriMesh> finalize();
 
+    /// finishes processing and passes produced triangles to the sink block by block
+    Expected<void> finalize( const TrianglesSink& sink );
+
     int layersPerBlock() const { return layersPerBlock_; }
     int nextZ() const { return nextZ_; }
 
@@ -364,6 +372,10 @@ private:
     template<typename V>
     void addPartBlock_( const V& volume, const BlockInfo& blockInfo );
     void addBinaryPartBlock_( const SimpleBinaryVolume& volume, const BlockInfo& blockInfo );
+    /// makes triangles in every block, returns the total number of vertices;
+    /// if \param onBlockTriangulated is given, then the blocks are triangulated by batches,
+    /// and after each batch it is called for every block of the batch in increasing order, returning false to stop the operation
+    Expected<int> triangulate_( const std::function<bool( int blockIndex )> & onBlockTriangulated = {} );
 
 private:
     VolumeIndexer indexer_;
@@ -397,6 +409,24 @@ Expected<TriMesh> VolumeMesher::run( const V& volume, const MarchingCubesParams&
     } );
 }
 
+template<typename V>
+Expected<void> VolumeMesher::run( const V& volume, const MarchingCubesParams& params, const TrianglesSink& sink, int layersPerBlock )
+{
+    if ( volume.dims.x <= 0 || volume.dims.y <= 0 || volume.dims.z <= 0 )
+        return {};
+    MR_TIMER;
+
+    VolumeMesher mesher( volume.dims, params, layersPerBlock );
+    return mesher.addPart( volume ).and_then( [&]
+    {
+        // free input volume, since it will not be used below any more
+        if ( params.freeVolume )
+            params.freeVolume();
+
+        return mesher.finalize( sink );
+    } );
+}
+
 VolumeMesher::VolumeMesher( const Vector3i & dims, const MarchingCubesParams& params, int layersPerBlock ) : indexer_( dims ), params_( params )
 {
     int threadCount = (int)tbb::global_control::active_value( tbb::global_control::max_allowed_parallelism );
@@ -809,7 +839,7 @@ MinMax<size_t> prepareLayerBounds(
     return positionBounds;
 }
 
-Expected<TriMesh> VolumeMesher::finalize()
+Expected<int> VolumeMesher::triangulate_( const std::function<bool( int blockIndex )> & onBlockTriangulated )
 {
     MR_TIMER;
     if ( nextZ_ + 1 != indexer_.dims().z )
@@ -852,8 +882,8 @@ Expected<TriMesh> VolumeMesher::finalize()
     static_assert( sizeof(S) == hardware_destructive_interference_size );
 
     const int layerCount = indexer_.dims().z;
-    auto currentSubprogress = subprogress( params_.cb, 0.5f, 0.85f );
-    ParallelFor( 0, blockCount_, [&] ( int blockIndex )
+    auto currentSubprogress = subprogress( params_.cb, 0.5f, onBlockTriangulated ? 1.0f : 0.85f );
+    auto triangulateBlock = [&] ( int blockIndex )
     {
         auto & block = sepStorage_.getBlock( blockIndex );
         const bool report = currentSubprogress && std::this_thread::get_id() == callingThreadId;
@@ -1075,7 +1105,25 @@ Expected<TriMesh> VolumeMesher::finalize()
                 return;
             }
         }
-    } );
+    };
+
+    if ( !onBlockTriangulated )
+        ParallelFor( 0, blockCount_, triangulateBlock );
+    else
+    {
+        // one block per thread in a batch, so only the triangles of one batch are kept in memory at a time
+        const int batchSize = std::max( 1, (int)tbb::global_control::active_value( tbb::global_control::max_allowed_parallelism ) );
+        for ( int batchBegin = 0; batchBegin < blockCount_; batchBegin += batchSize )
+        {
+            const int batchEnd = std::min( batchBegin + batchSize, blockCount_ );
+            ParallelFor( batchBegin, batchEnd, triangulateBlock );
+            if ( params_.cb && !keepGoing )
+                return unexpectedOperationCanceled();
+            for ( int blockIndex = batchBegin; blockIndex < batchEnd; ++blockIndex )
+                if ( !onBlockTriangulated( blockIndex ) )
+                    return unexpectedOperationCanceled();
+        }
+    }
 
     if ( params_.cb && !keepGoing )
         return unexpectedOperationCanceled();
@@ -1084,6 +1132,16 @@ Expected<TriMesh> VolumeMesher::finalize()
     invalids_ = {};
     lowerIso_ = {};
 
+    return totalVertices;
+}
+
+Expected<TriMesh> VolumeMesher::finalize()
+{
+    MR_TIMER;
+    auto totalVertices = triangulate_();
+    if ( !totalVertices )
+        return unexpected( std::move( totalVertices.error() ) );
+
     // create result triangulation
     TriMesh result;
     result.tris = sepStorage_.getTriangulation( params_.outVoxelPerFaceMap );
@@ -1092,7 +1150,7 @@ Expected<TriMesh> VolumeMesher::finalize()
         return unexpectedOperationCanceled();
 
     // some points may be not referenced by any triangle due to NaNs
-    result.points.resize( totalVertices );
+    result.points.resize( *totalVertices );
     sepStorage_.getPoints( result.points );
 
     if ( params_.cb && !params_.cb( 1.0f ) )
@@ -1101,6 +1159,30 @@ Expected<TriMesh> VolumeMesher::finalize()
     return result;
 }
 
+Expected<void> VolumeMesher::finalize( const TrianglesSink& sink )
+{
+    MR_TIMER;
+    // triangles of each block are passed in the same order as in finalize() result as soon as its batch is triangulated,
+    // and freed right after that; the coordinates of vertices are taken directly from separation points storage
+    std::vector<Triangle3f> tris;
+    auto totalVertices = triangulate_( [&] ( int blockIndex )
+    {
+        auto & block = sepStorage_.getBlock( blockIndex );
+        tris.resize( block.tris.size() );
+        ParallelFor( tris, [&]( size_t i )
+        {
+            const auto & vs = block.tris[FaceId( i )];
+            tris[i] = { sepStorage_.getPoint( vs[0] ), sepStorage_.getPoint( vs[1] ), sepStorage_.getPoint( vs[2] ) };
+        } );
+        block.tris = {};
+        block.faceMap = {};
+        return tris.empty() || sink( tris );
+    } );
+    if ( !totalVertices )
+        return unexpected( std::move( totalVertices.error() ) );
+    return {};
+}
+
 } // anonymous namespace
 
 Expected<TriMesh> marchingCubesAsTriMesh( const SimpleVolume& volume, const MarchingCubesParams& params /*= {} */ )
@@ -1137,6 +1219,11 @@ Expected<Mesh> marchingCubes( const SimpleVolumeMinMax& volume, const MarchingCu
     } );
 }
 
+Expected<void> marchingCubes( const SimpleVolume& volume, const TrianglesSink& sink, const MarchingCubesParams& params )
+{
+    return VolumeMesher::run( volume, params, sink );
+}
+
 Expected<TriMesh> marchingCubesAsTriMesh( const VdbVolume& volume, const MarchingCubesParams& params /*= {} */ )
 {
     if ( !volume.data )
@@ -1157,6 +1244,40 @@ Expected<Mesh> marchingCubes( const VdbVolume& volume, const MarchingCubesParams
     } );
 }
 
+Expected<void> marchingCubes( const VdbVolume& volume, const TrianglesSink& sink, const MarchingCubesParams& params )
+{
+    if ( !volume.data )
+        return unexpected( "No volume data." );
+    if ( params.iso <= volume.min || params.iso >= volume.max )
+        return {};
+    return VolumeMesher::run( volume, params, sink );
+}
+
+Expected<TriMesh> marchingCubesAsTriMesh( const SparseVolume& volume, const MarchingCubesParams& params )
+{
+    if ( params.iso <= volume.min || params.iso >= volume.max )
+        return TriMesh{};
+    return VolumeMesher::run( volume, params );
+}
+
+Expected<Mesh> marchingCubes( const SparseVolume& volume, const MarchingCubesParams& params )
+{
+    MR_TIMER;
+    auto p = params;
+    p.cb = subprogress( params.cb, 0.0f, 0.9f );
+    return marchingCubesAsTriMesh( volume, p ).and_then( [&params]( TriMesh && tm ) -> Expected<Mesh>
+    {
+        return Mesh::fromTriMesh( std::move( tm ), {}, subprogress( params.cb, 0.9f, 1.0f ) );
+    } );
+}
+
+Expected<void> marchingCubes( const SparseVolume& volume, const TrianglesSink& sink, const MarchingCubesParams& params )
+{
+    if ( params.iso <= volume.min || params.iso >= volume.max )
+        return {};
+    return VolumeMesher::run( volume, params, sink );
+}
+
 Expected<TriMesh> marchingCubesAsTriMesh( const FunctionVolume& volume, const MarchingCubesParams& params )
 {
     if ( !volume.data )
@@ -1193,6 +1314,41 @@ Expected<Mesh> marchingCubes( const SimpleBinaryVolume& volume, const MarchingCu
     } );
 }
 
+template<typename V>
+static Expected<void> marchingCubesToBinaryStlT( const V& volume, std::ostream& out, const MarchingCubesParams& params )
+{
+    MR_TIMER;
+    MeshSave::BinaryStlSaver saver( out );
+    std::vector<Triangle3f> notDegenTris;
+    auto res = marchingCubes( volume, [&]( const std::vector<Triangle3f>& tris )
+    {
+        // skip degenerate triangles as MeshSave::toBinaryStl does
+        notDegenTris.clear();
+        for ( const auto & t : tris )
+            if ( t[0] != t[1] && t[1] != t[2] && t[2] != t[0] )
+                notDegenTris.push_back( t );
+        return saver.writeTris( notDegenTris );
+    }, params );
+    if ( !out || !saver.updateHeadCounter() )
+        return unexpected( std::string( "Error saving in binary STL-format" ) );
+    return res;
+}
+
+Expected<void> marchingCubesToBinaryStl( const SimpleVolume& volume, std::ostream& out, const MarchingCubesParams& params )
+{
+    return marchingCubesToBinaryStlT( volume, out, params );
+}
+
+Expected<void> marchingCubesToBinaryStl( const VdbVolume& volume, std::ostream& out, const MarchingCubesParams& params )
+{
+    return marchingCubesToBinaryStlT( volume, out, params );
+}
+
+Expected<void> marchingCubesToBinaryStl( const SparseVolume& volume, std::ostream& out, const MarchingCubesParams& params )
+{
+    return marchingCubesToBinaryStlT( volume, out, params );
+}
+
 struct MarchingCubesByParts::Impl
 {
     VolumeMesher mesher;
@@ -1227,4 +1383,9 @@ Expected<TriMesh> MarchingCubesByParts::finalize()
     return impl_->mesher.finalize();
 }
 
+Expected<void> MarchingCubesByParts::finalize( const TrianglesSink& sink )
+{
+    return impl_->mesher.finalize( sink );
+}
+
 } //namespace MR
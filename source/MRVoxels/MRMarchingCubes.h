@@ -7,6 +7,7 @@
 #include "MRMesh/MRSignDetectionMode.h"
 #include "MRMesh/MRExpected.h"
 #include <climits>
+#include <iosfwd>
 
 namespace MR
 {
@@ -15,6 +16,10 @@ namespace MR
 // args: position0, position1, value0, value1, iso
 using VoxelPointPositioner = std::function<Vector3f( const Vector3f&, const Vector3f&, float, float, float )>;
 
+/// receives next portion of triangles produced by Marching Cubes (with the coordinates of their vertices),
+/// returns false to stop the operation
+using TrianglesSink = std::function<bool( const std::vector<Triangle3f>& tris )>;
+
 struct MarchingCubesParams
 {
     /// origin point of voxels box in 3D space with output mesh
@@ -77,6 +82,10 @@ MRVOXELS_API Expected<TriMesh> marchingCubesAsTriMesh( const SimpleVolumeMinMax&
 MRVOXELS_API Expected<Mesh> marchingCubes( const VdbVolume& volume, const MarchingCubesParams& params = {} );
 MRVOXELS_API Expected<TriMesh> marchingCubesAsTriMesh( const VdbVolume& volume, const MarchingCubesParams& params = {} );
 
+// makes Mesh from SparseVolume with given settings using Marching Cubes algorithm
+MRVOXELS_API Expected<Mesh> marchingCubes( const SparseVolume& volume, const MarchingCubesParams& params = {} );
+MRVOXELS_API Expected<TriMesh> marchingCubesAsTriMesh( const SparseVolume& volume, const MarchingCubesParams& params = {} );
+
 // makes Mesh from FunctionVolume with given settings using Marching Cubes algorithm
 MRVOXELS_API Expected<Mesh> marchingCubes( const FunctionVolume& volume, const MarchingCubesParams& params = {} );
 MRVOXELS_API Expected<TriMesh> marchingCubesAsTriMesh( const FunctionVolume& volume, const MarchingCubesParams& params = {} );
@@ -85,6 +94,21 @@ MRVOXELS_API Expected<TriMesh> marchingCubesAsTriMesh( const FunctionVolume& vol
 MRVOXELS_API Expected<Mesh> marchingCubes( const SimpleBinaryVolume& volume, const MarchingCubesParams& params = {} );
 MRVOXELS_API Expected<TriMesh> marchingCubesAsTriMesh( const SimpleBinaryVolume& volume, const MarchingCubesParams& params = {} );
 
+/// makes triangles from SimpleVolume, VdbVolume or SparseVolume with given settings using Marching Cubes algorithm
+/// and passes them to the sink by portions without assembling whole mesh in memory:
+/// the blocks of z-layers are triangulated by batches of one block per thread, and the triangles of each block are freed after passing,
+/// so only the coordinates of all vertices and the triangles of one batch are kept at a time;
+/// the triangles come in the same order as in marchingCubesAsTriMesh result
+MRVOXELS_API Expected<void> marchingCubes( const SimpleVolume& volume, const TrianglesSink& sink, const MarchingCubesParams& params = {} );
+MRVOXELS_API Expected<void> marchingCubes( const VdbVolume& volume, const TrianglesSink& sink, const MarchingCubesParams& params = {} );
+MRVOXELS_API Expected<void> marchingCubes( const SparseVolume& volume, const TrianglesSink& sink, const MarchingCubesParams& params = {} );
+
+/// makes triangles from SimpleVolume, VdbVolume or SparseVolume using Marching Cubes algorithm and writes them in binary STL stream as they are produced;
+/// the output is the same as of MeshSave::toBinaryStl( *marchingCubes( volume, params ), out ) but neither Mesh nor TriMesh is created
+MRVOXELS_API Expected<void> marchingCubesToBinaryStl( const SimpleVolume& volume, std::ostream& out, const MarchingCubesParams& params = {} );
+MRVOXELS_API Expected<void> marchingCubesToBinaryStl( const VdbVolume& volume, std::ostream& out, const MarchingCubesParams& params = {} );
+MRVOXELS_API Expected<void> marchingCubesToBinaryStl( const SparseVolume& volume, std::ostream& out, const MarchingCubesParams& params = {} );
+
 /// converts volume split on parts by planes z=const into mesh,
 /// last z-layer of previous part must be repeated as first z-layer of next part
 /// usage:
@@ -116,6 +140,9 @@ public:
     /// finishes processing and outputs produced trimesh
     MRVOXELS_API Expected<TriMesh> finalize();
 
+    /// finishes processing and passes produced triangles to the sink by portions as soon as they are made, without assembling whole mesh in memory
+    MRVOXELS_API Expected<void> finalize( const TrianglesSink& sink );
+
 private:
     struct Impl;
     std::unique_ptr<Impl> impl_;
@@ -9,6 +9,7 @@
 #include "MRMesh/MRBitSetParallelFor.h"
 #include "MRMesh/MRAABBTree.h"
 #include "MRMesh/MRPointsToMeshProjector.h"
+#include "MRMesh/MRMeshProject.h"
 #include <tuple>
 
 namespace MR
@@ -66,6 +67,36 @@ Expected<SimpleVolumeMinMax> meshToDistanceVolume( const MeshPart& mp, const Mes
 
 }
 
+Expected<SparseVolume> meshToSparseDistanceVolume( const MeshPart& mp, const MeshToDistanceVolumeParams& params )
+{
+    MR_TIMER;
+    if ( params.dist.signMode == SignDetectionMode::OpenVDB )
+        return unexpected( "OpenVDB sign detection mode is not supported for sparse volume" );
+
+    const auto func = meshToDistanceFunctionVolume( mp, params );
+    BrickValueGetter brickValue;
+    if ( params.dist.nullOutsideMinMax )
+    {
+        const float minDist = std::sqrt( params.dist.minDistSq );
+        const float maxDist = params.dist.maxDistSq < FLT_MAX ? std::sqrt( params.dist.maxDistSq ) : FLT_MAX;
+        brickValue = [&, minDist, maxDist] ( const Box3i& brickVoxels ) -> std::optional<float>
+        {
+            // the centers of all voxels in the brick are within the distance (halfDiag) from brick center
+            const auto halfSize = mult( params.vol.voxelSize, Vector3f( brickVoxels.size() - Vector3i::diagonal( 1 ) ) ) * 0.5f;
+            const auto center = params.vol.origin + mult( params.vol.voxelSize, Vector3f( brickVoxels.min ) + Vector3f::diagonal( 0.5f ) ) + halfSize;
+            const auto halfDiag = halfSize.length();
+            const auto upDistLimitSq = maxDist < FLT_MAX ? sqr( maxDist + halfDiag ) : FLT_MAX;
+            const auto prj = findProjection( center, mp, upDistLimitSq );
+            if ( !prj )
+                return cQuietNan; // all voxels are not closer than maxDist
+            if ( std::sqrt( prj.distSq ) + halfDiag < minDist )
+                return cQuietNan; // all voxels are closer than minDist
+            return {};
+        };
+    }
+    return functionVolumeToSparseVolume( func, brickValue, params.vol.cb );
+}
+
 FunctionVolume meshToDistanceFunctionVolume( const MeshPart& mp, const MeshToDistanceVolumeParams& params )
 {
     MR_TIMER;
@@ -21,6 +21,12 @@ struct MeshToDistanceVolumeParams
 /// makes SimpleVolume filled with (signed or unsigned) distances from Mesh with given settings
 MRVOXELS_API Expected<SimpleVolumeMinMax> meshToDistanceVolume( const MeshPart& mp, const MeshToDistanceVolumeParams& params );
 
+/// makes SparseVolume filled with (signed or unsigned) distances from Mesh with given settings;
+/// if params.dist.nullOutsideMinMax then the bricks located completely further than maxDist or closer than minDist from the mesh
+/// become NaN constant tiles without computation of distances in their voxels, so both time and memory are proportional to the surface area;
+/// SignDetectionMode::OpenVDB is not supported
+MRVOXELS_API Expected<SparseVolume> meshToSparseDistanceVolume( const MeshPart& mp, const MeshToDistanceVolumeParams& params );
+
 /// makes FunctionVolume representing (signed or unsigned) distances from Mesh with given settings
 MRVOXELS_API FunctionVolume meshToDistanceFunctionVolume( const MeshPart& mp, const MeshToDistanceVolumeParams& params );
 
@@ -234,6 +234,20 @@ Expected<Mesh> mcOffsetMesh( const MeshPart& mp, float offset,
         return marchingCubes( meshToDistanceFunctionVolume( mp, msParams ), vmParams );
     }
 
+    if ( !isHoleWindingRule )
+    {
+        // voxels far from the surface get NaNs, so sparse volume avoids both their computation and storage
+        return meshToSparseDistanceVolume( mp, msParams ).and_then( [&vmParams] ( SparseVolume&& volume )
+        {
+            vmParams.freeVolume = [&volume]
+            {
+                Timer t( "~SparseVolume" );
+                volume = {};
+            };
+            return marchingCubes( volume, vmParams );
+        } );
+    }
+
     return meshToDistanceVolume( mp, msParams ).and_then( [&vmParams] ( SimpleVolumeMinMax&& volume )
     {
         vmParams.freeVolume = [&volume]
@@ -54,7 +54,8 @@ struct OffsetParameters : BaseShellParameters
     /// this setting is ignored (as if memoryEfficient == false) if
     ///  a) signDetectionMode = SignDetectionMode::OpenVDB, or
     ///  b) \ref fwn is provided (CUDA computations require full memory storage)
-    /// used only by \ref mcOffsetMesh and \ref sharpOffsetMesh methods
+    /// used only by \ref mcOffsetMesh and \ref sharpOffsetMesh methods;
+    /// if false then SparseVolume is used for voxel grid representation in all sign detection modes except HoleWindingRule
     bool memoryEfficient = true;
 };
 
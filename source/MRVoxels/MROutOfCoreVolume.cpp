@@ -0,0 +1,463 @@
+#include "MROutOfCoreVolume.h"
+#include "MRVoxelsLoad.h"
+#include "MRVoxelsVolume.h"
+#include "MRMesh/MRBitSetParallelFor.h"
+#include "MRMesh/MRMesh.h"
+#include "MRMesh/MRParallelFor.h"
+#include "MRMesh/MRStringConvert.h"
+#include "MRMesh/MRTimer.h"
+#include "MRMesh/MRTriMesh.h"
+#include "MRMesh/MRVolumeIndexer.h"
+
+#include <array>
+#include <fstream>
+#include <limits>
+
+namespace MR
+{
+
+namespace
+{
+
+/// the size in bytes of a value of given type, and the range of integer values as in VoxelsLoad::fromRaw
+struct RawTypeInfo
+{
+    size_t size = 0;
+    int64_t min = 0;
+    uint64_t max = 0;
+};
+
+template <typename T>
+RawTypeInfo rawTypeInfo()
+{
+    if constexpr ( std::is_integral_v<T> )
+        return { sizeof( T ), int64_t( std::numeric_limits<T>::lowest() ), uint64_t( std::numeric_limits<T>::max() ) };
+    else
+        return { sizeof( T ) };
+}
+
+RawTypeInfo getRawTypeInfo( ScalarType scalarType )
+{
+    switch ( scalarType )
+    {
+    case ScalarType::UInt8:
+        return rawTypeInfo<uint8_t>();
+    case ScalarType::Int8:
+        return rawTypeInfo<int8_t>();
+    case ScalarType::UInt16:
+        return rawTypeInfo<uint16_t>();
+    case ScalarType::Int16:
+        return rawTypeInfo<int16_t>();
+    case ScalarType::UInt32:
+        return rawTypeInfo<uint32_t>();
+    case ScalarType::Int32:
+        return rawTypeInfo<int32_t>();
+    case ScalarType::UInt64:
+        return rawTypeInfo<uint64_t>();
+    case ScalarType::Int64:
+        return rawTypeInfo<int64_t>();
+    case ScalarType::Float32:
+        return rawTypeInfo<float>();
+    case ScalarType::Float64:
+        return rawTypeInfo<double>();
+    default:
+        return {};
+    }
+}
+
+/// reads the slabs of given volume overlapping on one Z-slice and passes them in the mesher
+Expected<void> addSlabs( const OutOfCoreVolume& volume, MarchingCubesByParts& mesher, size_t maxSlabMemory, const ProgressCallback& cb )
+{
+    const int dimsZ = volume.dims().z;
+    const int layers = volume.slabLayers( maxSlabMemory );
+    do
+    {
+        const int zBegin = mesher.nextZ();
+        const int zEnd = std::min( zBegin + layers, dimsZ );
+        auto slab = volume.readSlab( zBegin, zEnd );
+        if ( !slab )
+            return unexpected( std::move( slab.error() ) );
+        if ( auto res = mesher.addPart( *slab ); !res )
+            return res;
+        if ( !reportProgress( cb, float( zEnd ) / float( dimsZ ) ) )
+            return unexpectedOperationCanceled();
+    } while ( mesher.nextZ() + 1 < dimsZ );
+    return {};
+}
+
+/// returns Z-slices [zBegin, zEnd) of the volume cropped in XY by given box
+Expected<SimpleVolume> readCroppedSlab( const OutOfCoreVolume& volume, const Box3i& box, int zBegin, int zEnd )
+{
+    auto slab = volume.readSlab( zBegin, zEnd );
+    if ( !slab )
+        return slab;
+    if ( box.min.x == 0 && box.min.y == 0 && box.max.x + 1 == slab->dims.x && box.max.y + 1 == slab->dims.y )
+        return slab;
+
+    SimpleVolume res;
+    res.dims = { box.max.x - box.min.x + 1, box.max.y - box.min.y + 1, slab->dims.z };
+    res.voxelSize = slab->voxelSize;
+    res.data.resize( size_t( res.dims.x ) * res.dims.y * res.dims.z );
+    ParallelFor( 0, res.dims.y * res.dims.z, [&] ( int yz )
+    {
+        const int y = yz % res.dims.y;
+        const int z = yz / res.dims.y;
+        const auto src = slab->data.data() + ( size_t( z ) * slab->dims.y + y + box.min.y ) * slab->dims.x + box.min.x;
+        std::copy_n( src, res.dims.x, res.data.data() + size_t( yz ) * res.dims.x );
+    } );
+    return res;
+}
+
+} // anonymous namespace
+
+Expected<OutOfCoreVolume> OutOfCoreVolume::open( const std::filesystem::path& file, const VoxelsLoad::RawParameters& params )
+{
+    const auto typeInfo = getRawTypeInfo( params.scalarType );
+    if ( typeInfo.size == 0 )
+        return unexpected( "Unsupported scalar type of out-of-core volume" );
+    if ( params.dimensions.x <= 0 || params.dimensions.y <= 0 || params.dimensions.z <= 0 )
+        return unexpected( "Invalid dimensions of out-of-core volume" );
+
+    std::error_code ec;
+    const auto fileSize = std::filesystem::file_size( file, ec );
+    if ( ec )
+        return unexpected( "Cannot open file for reading " + utf8string( file ) );
+    if ( fileSize < size_t( params.dimensions.x ) * params.dimensions.y * params.dimensions.z * typeInfo.size )
+        return unexpected( "File is too small for given volume dimensions " + utf8string( file ) );
+
+    OutOfCoreVolume res;
+    res.file_ = file;
+    res.dims_ = params.dimensions;
+    res.voxelSize_ = params.voxelSize;
+    res.scalarType_ = params.scalarType;
+    return res;
+}
+
+Expected<OutOfCoreVolume> OutOfCoreVolume::create( const std::filesystem::path& file, const Vector3i& dims, const Vector3f& voxelSize )
+{
+    if ( dims.x <= 0 || dims.y <= 0 || dims.z <= 0 )
+        return unexpected( "Invalid dimensions of out-of-core volume" );
+    {
+        std::ofstream out( file, std::ios::binary );
+        if ( !out )
+            return unexpected( "Cannot open file for writing " + utf8string( file ) );
+    }
+    std::error_code ec;
+    std::filesystem::resize_file( file, size_t( dims.x ) * dims.y * dims.z * sizeof( float ), ec );
+    if ( ec )
+        return unexpected( "Cannot allocate file " + utf8string( file ) + ": " + systemToUtf8( ec.message() ) );
+
+    OutOfCoreVolume res;
+    res.file_ = file;
+    res.dims_ = dims;
+    res.voxelSize_ = voxelSize;
+    res.scalarType_ = ScalarType::Float32;
+    return res;
+}
+
+int OutOfCoreVolume::slabLayers( size_t maxSlabMemory, int minLayers ) const
+{
+    const size_t sliceBytes = size_t( dims_.x ) * dims_.y * sizeof( float );
+    return int( std::clamp( maxSlabMemory / sliceBytes, size_t( minLayers ), size_t( std::max( dims_.z, minLayers ) ) ) );
+}
+
+Expected<SimpleVolume> OutOfCoreVolume::readSlab( int zBegin, int zEnd ) const
+{
+    MR_TIMER;
+    if ( zBegin < 0 || zEnd > dims_.z || zBegin >= zEnd )
+        return unexpected( "Invalid range of Z-slices" );
+
+    SimpleVolume res;
+    res.dims = { dims_.x, dims_.y, zEnd - zBegin };
+    res.voxelSize = voxelSize_;
+    const size_t sliceSize = size_t( dims_.x ) * dims_.y;
+    const size_t numVoxels = sliceSize * res.dims.z;
+    res.data.resize( numVoxels );
+
+    const auto typeInfo = getRawTypeInfo( scalarType_ );
+    std::ifstream in( file_, std::ios::binary );
+    if ( !in || !in.seekg( std::streamoff( sliceSize * zBegin * typeInfo.size ) ) )
+        return unexpected( "Cannot open file for reading " + utf8string( file_ ) );
+
+    if ( scalarType_ == ScalarType::Float32 )
+    {
+        if ( !in.read( reinterpret_cast<char*>( res.data.data() ), numVoxels * sizeof( float ) ) )
+            return unexpected( "Read error " + utf8string( file_ ) );
+        return res;
+    }
+
+    std::vector<char> buffer( numVoxels * typeInfo.size );
+    if ( !in.read( buffer.data(), buffer.size() ) )
+        return unexpected( "Read error " + utf8string( file_ ) );
+
+    if ( scalarType_ == ScalarType::Float64 )
+    {
+        const auto values = reinterpret_cast<const double*>( buffer.data() );
+        ParallelFor( res.data, [&] ( VoxelId v )
+        {
+            res.data[v] = float( values[size_t( v )] );
+        } );
+    }
+    else
+    {
+        const auto converter = getTypeConverter( scalarType_, typeInfo.max - typeInfo.min, typeInfo.min );
+        ParallelFor( res.data, [&] ( VoxelId v )
+        {
+            res.data[v] = converter( buffer.data() + size_t( v ) * typeInfo.size );
+        } );
+    }
+    return res;
+}
+
+Expected<void> OutOfCoreVolume::writeSlices( int zBegin, const SimpleVolume& slab, int sliceBegin, int sliceEnd )
+{
+    MR_TIMER;
+    if ( scalarType_ != ScalarType::Float32 )
+        return unexpected( "Only out-of-core volumes of float values can be written" );
+    if ( slab.dims.x != dims_.x || slab.dims.y != dims_.y )
+        return unexpected( "XY dimensions of a slab must be equal to XY dimensions of whole volume" );
+    if ( sliceBegin < 0 || sliceEnd > slab.dims.z || sliceBegin > sliceEnd || zBegin < 0 || zBegin + sliceEnd - sliceBegin > dims_.z )
+        return unexpected( "Invalid range of Z-slices" );
+
+    const size_t sliceSize = size_t( dims_.x ) * dims_.y;
+    std::fstream out( file_, std::ios::in | std::ios::out | std::ios::binary );
+    if ( !out || !out.seekp( std::streamoff( sliceSize * zBegin * sizeof( float ) ) ) )
+        return unexpected( "Cannot open file for writing " + utf8string( file_ ) );
+    if ( !out.write( reinterpret_cast<const char*>( slab.data.data() + sliceSize * sliceBegin ), sliceSize * ( sliceEnd - sliceBegin ) * sizeof( float ) ) )
+        return unexpected( "Write error " + utf8string( file_ ) );
+    return {};
+}
+
+Expected<void> marchingCubes( const OutOfCoreVolume& volume, const TrianglesSink& sink, const MarchingCubesParams& params, size_t maxSlabMemory )
+{
+    MR_TIMER;
+    auto mesherParams = params;
+    mesherParams.cb = {}; // the progress is reported here for all slabs
+    MarchingCubesByParts mesher( volume.dims(), mesherParams );
+    if ( auto res = addSlabs( volume, mesher, maxSlabMemory, subprogress( params.cb, 0.0f, 0.9f ) ); !res )
+        return res;
+    if ( auto res = mesher.finalize( sink ); !res )
+        return res;
+    if ( !reportProgress( params.cb, 1.0f ) )
+        return unexpectedOperationCanceled();
+    return {};
+}
+
+Expected<TriMesh> marchingCubesAsTriMesh( const OutOfCoreVolume& volume, const MarchingCubesParams& params, size_t maxSlabMemory )
+{
+    MR_TIMER;
+    auto mesherParams = params;
+    mesherParams.cb = {}; // the progress is reported here for all slabs
+    MarchingCubesByParts mesher( volume.dims(), mesherParams );
+    if ( auto res = addSlabs( volume, mesher, maxSlabMemory, subprogress( params.cb, 0.0f, 0.9f ) ); !res )
+        return unexpected( std::move( res.error() ) );
+    return mesher.finalize();
+}
+
+Expected<Mesh> marchingCubes( const OutOfCoreVolume& volume, const MarchingCubesParams& params, size_t maxSlabMemory )
+{
+    MR_TIMER;
+    auto tm = marchingCubesAsTriMesh( volume, params, maxSlabMemory );
+    if ( !tm )
+        return unexpected( std::move( tm.error() ) );
+    return Mesh::fromTriMesh( std::move( *tm ), {}, subprogress( params.cb, 0.9f, 1.0f ) );
+}
+
+Expected<void> voxelFilter( const OutOfCoreVolume& volume, OutOfCoreVolume& out, VoxelFilterType type, int width,
+    const ProgressCallback& cb, size_t maxSlabMemory )
+{
+    MR_TIMER;
+    if ( out.dims() != volume.dims() )
+        return unexpected( "Output volume must have the same dimensions as input volume" );
+    // the halo slices of next slab shall not be overwritten with filtered values before they are read
+    std::error_code ec;
+    if ( out.file() == volume.file() || std::filesystem::equivalent( out.file(), volume.file(), ec ) )
+        return unexpected( "Output volume must be stored in another file than input volume" );
+    if ( width <= 0 || width % 2 == 0 )
+        return unexpected( "Filter width must be an odd positive number" );
+
+    const int r = width / 2;
+    const int dimsZ = volume.dims().z;
+    // each slab is read with r more Z-slices on both sides to compute the filter in all its slices as in whole volume
+    const int layers = volume.slabLayers( maxSlabMemory, 2 * r + 1 );
+    const int step = layers >= dimsZ ? dimsZ : layers - 2 * r;
+    for ( int z = 0; z < dimsZ; z += step )
+    {
+        const int zEnd = std::min( z + step, dimsZ );
+        const int readBegin = std::max( 0, z - r );
+        const int readEnd = std::min( dimsZ, zEnd + r );
+        auto slab = volume.readSlab( readBegin, readEnd );
+        if ( !slab )
+            return unexpected( std::move( slab.error() ) );
+
+        const float slabProgress = float( zEnd - z ) / float( dimsZ );
+        auto filtered = voxelFilter( *slab, type, width, subprogress( cb, float( z ) / float( dimsZ ), float( z ) / float( dimsZ ) + 0.9f * slabProgress ) );
+        if ( !filtered )
+            return unexpected( std::move( filtered.error() ) );
+        slab = {}; // free memory before writing
+
+        if ( auto res = out.writeSlices( z, *filtered, z - readBegin, zEnd - readBegin ); !res )
+            return res;
+        if ( !reportProgress( cb, float( zEnd ) / float( dimsZ ) ) )
+            return unexpectedOperationCanceled();
+    }
+    return {};
+}
+
+Expected<VoxelBitSet> selectVoxelsInRange( const OutOfCoreVolume& volume, const MinMaxf& range, const ProgressCallback& cb, size_t maxSlabMemory )
+{
+    MR_TIMER;
+    const VolumeIndexer indexer( volume.dims() );
+    VoxelBitSet res( indexer.size() );
+    const int dimsZ = volume.dims().z;
+    const int layers = volume.slabLayers( maxSlabMemory, 1 );
+    for ( int z = 0; z < dimsZ; z += layers )
+    {
+        const int zEnd = std::min( z + layers, dimsZ );
+        auto slab = volume.readSlab( z, zEnd );
+        if ( !slab )
+            return unexpected( std::move( slab.error() ) );
+
+        // each thread sets the bits of its own blocks, the blocks on the boundaries of slabs are processed in different loops
+        const size_t beginBit = indexer.sizeXY() * z;
+        const size_t endBit = indexer.sizeXY() * zEnd;
+        constexpr size_t bitsPerBlock = VoxelBitSet::bits_per_block;
+        ParallelFor( beginBit / bitsPerBlock, ( endBit + bitsPerBlock - 1 ) / bitsPerBlock, [&] ( size_t block )
+        {
+            const size_t blockEnd = std::min( ( block + 1 ) * bitsPerBlock, endBit );
+            for ( size_t bit = std::max( block * bitsPerBlock, beginBit ); bit < blockEnd; ++bit )
+                if ( range.contains( slab->data[VoxelId( bit - beginBit )] ) )
+                    res.set( VoxelId( bit ) );
+        } );
+        if ( !reportProgress( cb, float( zEnd ) / float( dimsZ ) ) )
+            return unexpectedOperationCanceled();
+    }
+    return res;
+}
+
+Expected<Mesh> meshFromVoxelsMask( const OutOfCoreVolume& volume, const VoxelBitSet& mask, const ProgressCallback& cb, size_t maxSlabMemory )
+{
+    MR_TIMER;
+    if ( mask.none() )
+        return unexpected( "Cannot create mesh from empty mask." );
+    const VolumeIndexer indexer( volume.dims() );
+    if ( mask.find_last() >= indexer.size() )
+        return unexpected( "Mask exceeds the volume." );
+
+    // the same margins as in meshFromVoxelsMask for VdbVolume
+    constexpr int cExpansion = 25;
+    constexpr int cSmoothExpansion = 3;
+
+    tbb::enumerable_thread_specific<Box3i> threadBoxes;
+    BitSetParallelFor( mask, threadBoxes, [&] ( VoxelId v, Box3i& box )
+    {
+        box.include( indexer.toPos( v ) );
+    } );
+    Box3i box;
+    for ( const auto& threadBox : threadBoxes )
+        box.include( threadBox );
+    box = box.expanded( Vector3i::diagonal( cExpansion ) ).intersection( Box3i( Vector3i(), volume.dims() - Vector3i::diagonal( 1 ) ) );
+
+    const Vector3i partDims = box.size() + Vector3i::diagonal( 1 );
+    const size_t partXY = size_t( partDims.x ) * partDims.y;
+    const int layers = volume.slabLayers( maxSlabMemory, 2 + 2 * cSmoothExpansion );
+
+    // returns the mask in Z-slices [zBegin, zEnd) of the box
+    auto getSlabMask = [&] ( int zBegin, int zEnd )
+    {
+        VoxelBitSet slabMask( partXY * ( zEnd - zBegin ) );
+        BitSetParallelForAll( slabMask, [&] ( VoxelId v )
+        {
+            const auto z = int( size_t( v ) / partXY );
+            const auto xy = size_t( v ) % partXY;
+            const Vector3i pos( int( xy % partDims.x ), int( xy / partDims.x ), z + zBegin );
+            if ( mask.test( indexer.toVoxelId( pos + box.min ) ) )
+                slabMask.set( v );
+        } );
+        return slabMask;
+    };
+
+    // first pass: average values inside and outside the mask
+    std::array<double, 2> sums{ 0.0, 0.0 }; // outside, inside
+    for ( int z = 0; z < partDims.z; z += layers )
+    {
+        const int zEnd = std::min( z + layers, partDims.z );
+        auto slab = readCroppedSlab( volume, box, box.min.z + z, box.min.z + zEnd );
+        if ( !slab )
+            return unexpected( std::move( slab.error() ) );
+        const auto slabMask = getSlabMask( z, zEnd );
+        tbb::enumerable_thread_specific<std::array<double, 2>> threadSums( std::array<double, 2>{ 0.0, 0.0 } );
+        ParallelFor( 0, slab->dims.z, threadSums, [&] ( int sz, std::array<double, 2>& s )
+        {
+            for ( size_t i = partXY * sz; i < partXY * ( sz + 1 ); ++i )
+                s[slabMask.test( VoxelId( i ) )] += slab->data[VoxelId( i )];
+        } );
+        for ( const auto& s : threadSums )
+        {
+            sums[0] += s[0];
+            sums[1] += s[1];
+        }
+        if ( !reportProgress( cb, 0.3f * float( zEnd ) / float( partDims.z ) ) )
+            return unexpectedOperationCanceled();
+    }
+    const auto insideCount = mask.count();
+    const double insideAvg = sums[1] / double( insideCount );
+    const double outsideAvg = sums[0] / double( partXY * partDims.z - insideCount );
+    const auto range = float( insideAvg - outsideAvg );
+
+    // second pass: 1 deep inside, (density - outsideAvg)/(insideAvg - outsideAvg) on the edge, 0 - far outside, 0.5 iso
+    MarchingCubesByParts mesher( partDims, MarchingCubesParams{
+        .origin = mult( Vector3f( box.min ) - Vector3f::diagonal( 0.5f ), volume.voxelSize() ),
+        .iso = 0.5f
+    } );
+    const auto sb = subprogress( cb, 0.3f, 0.9f );
+    do
+    {
+        const int zBegin = mesher.nextZ();
+        const int zEnd = std::min( zBegin + layers - 2 * cSmoothExpansion, partDims.z );
+        // mask expansion and shrinkage need cSmoothExpansion more slices on both sides
+        const int readBegin = std::max( 0, zBegin - cSmoothExpansion );
+        const int readEnd = std::min( partDims.z, zEnd + cSmoothExpansion );
+        auto slab = readCroppedSlab( volume, box, box.min.z + readBegin, box.min.z + readEnd );
+        if ( !slab )
+            return unexpected( std::move( slab.error() ) );
+
+        const VolumeIndexer slabIndexer( slab->dims );
+        auto smallExpMask = getSlabMask( readBegin, readEnd );
+        auto smallShrMask = smallExpMask;
+        expandVoxelsMask( smallExpMask, slabIndexer, cSmoothExpansion );
+        shrinkVoxelsMask( smallShrMask, slabIndexer, cSmoothExpansion );
+
+        SimpleVolume part;
+        part.dims = { partDims.x, partDims.y, zEnd - zBegin };
+        part.voxelSize = volume.voxelSize();
+        part.data.resize( partXY * part.dims.z );
+        const size_t shift = partXY * ( zBegin - readBegin );
+        ParallelFor( part.data, [&] ( VoxelId v )
+        {
+            const auto i = VoxelId( size_t( v ) + shift );
+            if ( smallShrMask.test( i ) )
+                part.data[v] = 1.0f;
+            else if ( smallExpMask.test( i ) )
+                part.data[v] = std::clamp( float( slab->data[i] - outsideAvg ) / range, 0.0f, 1.0f );
+            else
+                part.data[v] = 0.0f;
+        } );
+        slab = {};
+
+        if ( auto res = mesher.addPart( part ); !res )
+            return unexpected( std::move( res.error() ) );
+        if ( !reportProgress( sb, float( zEnd ) / float( partDims.z ) ) )
+            return unexpectedOperationCanceled();
+    } while ( mesher.nextZ() + 1 < partDims.z );
+
+    auto tm = mesher.finalize();
+    if ( !tm )
+        return unexpected( std::move( tm.error() ) );
+    auto mesh = Mesh::fromTriMesh( std::move( *tm ), {}, subprogress( cb, 0.9f, 1.0f ) );
+    if ( mesh.topology.numValidFaces() == 0 )
+        return unexpected( "Failed to create mesh from mask" );
+    return mesh;
+}
+
+} // namespace MR
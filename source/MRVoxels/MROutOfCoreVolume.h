@@ -0,0 +1,93 @@
+#pragma once
+
+#include "MRVoxelsFwd.h"
+#include "MRScalarConvert.h"
+#include "MRVoxelFilter.h"
+#include "MRMarchingCubes.h"
+
+#include "MRMesh/MRVector3.h"
+#include "MRMesh/MRBox.h"
+#include "MRMesh/MRExpected.h"
+
+#include <filesystem>
+
+namespace MR
+{
+
+namespace VoxelsLoad
+{
+struct RawParameters;
+}
+
+/// \addtogroup VoxelGroup
+/// \{
+
+/// dense volume stored in raw file on disk (Z-slices one after another, X coordinate changing fastest),
+/// which is read and written by slabs of consecutive Z-slices, so the volume can be much larger than available memory;
+/// the operations below process the volume slab by slab keeping only one slab (and the output) in memory
+class MRVOXELS_CLASS OutOfCoreVolume
+{
+public:
+    /// opens existing raw file for reading, the values are converted in float as in VoxelsLoad::fromRaw
+    [[nodiscard]] MRVOXELS_API static Expected<OutOfCoreVolume> open( const std::filesystem::path& file, const VoxelsLoad::RawParameters& params );
+
+    /// creates new raw file of float values with given dimensions to be filled by writeSlab calls
+    [[nodiscard]] MRVOXELS_API static Expected<OutOfCoreVolume> create( const std::filesystem::path& file, const Vector3i& dims, const Vector3f& voxelSize );
+
+    [[nodiscard]] const std::filesystem::path& file() const { return file_; }
+    [[nodiscard]] const Vector3i& dims() const { return dims_; }
+    [[nodiscard]] const Vector3f& voxelSize() const { return voxelSize_; }
+    [[nodiscard]] ScalarType scalarType() const { return scalarType_; }
+
+    /// returns the number of Z-slices in a slab of float values occupying at most given memory amount, but not less than minLayers
+    [[nodiscard]] MRVOXELS_API int slabLayers( size_t maxSlabMemory, int minLayers = 2 ) const;
+
+    /// reads Z-slices [zBegin, zEnd) of the volume in memory
+    [[nodiscard]] MRVOXELS_API Expected<SimpleVolume> readSlab( int zBegin, int zEnd ) const;
+
+    /// writes Z-slices [sliceBegin, sliceEnd) of given slab in the volume starting from Z-slice zBegin, only for volumes of float values
+    MRVOXELS_API Expected<void> writeSlices( int zBegin, const SimpleVolume& slab, int sliceBegin, int sliceEnd );
+
+    /// writes all Z-slices of given slab in the volume starting from Z-slice zBegin, only for volumes of float values
+    Expected<void> writeSlab( int zBegin, const SimpleVolume& slab ) { return writeSlices( zBegin, slab, 0, slab.dims.z ); }
+
+private:
+    std::filesystem::path file_;
+    Vector3i dims_;
+    Vector3f voxelSize_;
+    ScalarType scalarType_ = ScalarType::Float32;
+};
+
+/// the default upper limit of memory amount used to store one slab of out-of-core volume
+inline constexpr size_t cOutOfCoreSlabMemory = size_t( 256 ) << 20; // 256 MiB
+
+/// makes triangles from out-of-core volume using Marching Cubes algorithm and passes them to the sink by portions,
+/// the volume is read by slabs overlapping on one Z-slice and passed in MarchingCubesByParts, the progress is reported in params.cb
+MRVOXELS_API Expected<void> marchingCubes( const OutOfCoreVolume& volume, const TrianglesSink& sink,
+    const MarchingCubesParams& params = {}, size_t maxSlabMemory = cOutOfCoreSlabMemory );
+
+/// makes mesh from out-of-core volume using Marching Cubes algorithm
+MRVOXELS_API Expected<TriMesh> marchingCubesAsTriMesh( const OutOfCoreVolume& volume, const MarchingCubesParams& params = {},
+    size_t maxSlabMemory = cOutOfCoreSlabMemory );
+MRVOXELS_API Expected<Mesh> marchingCubes( const OutOfCoreVolume& volume, const MarchingCubesParams& params = {},
+    size_t maxSlabMemory = cOutOfCoreSlabMemory );
+
+/// filters out-of-core volume and writes the result in another out-of-core volume of the same dimensions;
+/// the slabs are read with the margin of width/2 Z-slices, so the result is the same as of voxelFilter for dense volume;
+/// the output volume must be stored in another file than the input one
+MRVOXELS_API Expected<void> voxelFilter( const OutOfCoreVolume& volume, OutOfCoreVolume& out, VoxelFilterType type, int width,
+    const ProgressCallback& cb = {}, size_t maxSlabMemory = cOutOfCoreSlabMemory );
+
+/// returns the voxels of out-of-core volume with the values in given range (including both ends)
+MRVOXELS_API Expected<VoxelBitSet> selectVoxelsInRange( const OutOfCoreVolume& volume, const MinMaxf& range,
+    const ProgressCallback& cb = {}, size_t maxSlabMemory = cOutOfCoreSlabMemory );
+
+/// creates mesh from voxels mask in out-of-core volume as meshFromVoxelsMask does for VdbVolume:
+/// only the slabs within the bounding box of the mask (with the margin) are read, and the mesh is extracted by Marching Cubes;
+/// density inside mask is expected to be higher then outside
+MRVOXELS_API Expected<Mesh> meshFromVoxelsMask( const OutOfCoreVolume& volume, const VoxelBitSet& mask,
+    const ProgressCallback& cb = {}, size_t maxSlabMemory = cOutOfCoreSlabMemory );
+
+/// \}
+
+} // namespace MR
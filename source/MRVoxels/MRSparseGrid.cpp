@@ -0,0 +1,116 @@
+#include "MRSparseGrid.h"
+#include "MRMesh/MRIsNaN.h"
+#include "MRMesh/MRTimer.h"
+#include "MRPch/MRTBB.h"
+#include <cmath>
+
+namespace MR
+{
+
+SparseGrid::SparseGrid( const Vector3i& dims, float background )
+    : dims_( dims )
+{
+    assert( dims.x >= 0 && dims.y >= 0 && dims.z >= 0 );
+    constexpr int mask = cBrickSize - 1;
+    numBricks_ = { ( dims.x + mask ) >> cBrickLog, ( dims.y + mask ) >> cBrickLog, ( dims.z + mask ) >> cBrickLog };
+    bricks_.resize( size_t( numBricks_.x ) * numBricks_.y * numBricks_.z, Brick{ .min = background, .max = background } );
+}
+
+Vector3i SparseGrid::brickPos( size_t i ) const
+{
+    assert( i < bricks_.size() );
+    const auto sizeXY = size_t( numBricks_.x ) * numBricks_.y;
+    const int z = int( i / sizeXY );
+    const auto rest = i % sizeXY;
+    return { int( rest % numBricks_.x ), int( rest / numBricks_.x ), z };
+}
+
+Box3i SparseGrid::brickVoxels( size_t i ) const
+{
+    const auto min = brickPos( i ) * cBrickSize;
+    const auto max = min + Vector3i::diagonal( cBrickSize );
+    return { min, Vector3i( std::min( max.x, dims_.x ), std::min( max.y, dims_.y ), std::min( max.z, dims_.z ) ) };
+}
+
+void SparseGrid::setBrick( size_t i, float value )
+{
+    auto & b = bricks_[i];
+    b.min = b.max = value;
+    b.values = {};
+}
+
+void SparseGrid::setBrick( size_t i, std::vector<float> values )
+{
+    assert( values.size() == cBrickVoxels );
+    const auto box = brickVoxels( i );
+    const auto size = box.size();
+
+    MinMaxf minMax;
+    bool anyNan = false;
+    for ( int z = 0; z < size.z; ++z )
+    {
+        for ( int y = 0; y < size.y; ++y )
+        {
+            const auto * row = values.data() + ( ( y + ( z << cBrickLog ) ) << cBrickLog );
+            for ( int x = 0; x < size.x; ++x )
+            {
+                if ( std::isnan( row[x] ) )
+                    anyNan = true;
+                else
+                    minMax.include( row[x] );
+            }
+        }
+    }
+
+    auto & b = bricks_[i];
+    if ( !minMax.valid() )
+    {
+        // all voxels are NaNs
+        setBrick( i, cQuietNan );
+        return;
+    }
+    if ( !anyNan && minMax.min == minMax.max )
+    {
+        setBrick( i, minMax.min );
+        return;
+    }
+    b.min = minMax.min;
+    b.max = minMax.max;
+    b.values = std::move( values );
+}
+
+size_t SparseGrid::numDenseBricks() const
+{
+    return tbb::parallel_reduce( tbb::blocked_range<size_t>( 0, bricks_.size() ), size_t( 0 ),
+        [&] ( const tbb::blocked_range<size_t>& range, size_t curr )
+        {
+            for ( size_t i = range.begin(); i < range.end(); ++i )
+                if ( !bricks_[i].isConstant() )
+                    ++curr;
+            return curr;
+        }, std::plus<size_t>() );
+}
+
+MinMaxf SparseGrid::computeMinMax() const
+{
+    MR_TIMER;
+    MinMaxf res;
+    for ( const auto & b : bricks_ )
+    {
+        if ( std::isnan( b.min ) )
+            continue;
+        res.include( b.min );
+        res.include( b.max );
+    }
+    return res;
+}
+
+size_t SparseGrid::heapBytes() const
+{
+    size_t res = bricks_.capacity() * sizeof( Brick );
+    for ( const auto & b : bricks_ )
+        res += b.values.capacity() * sizeof( float );
+    return res;
+}
+
+} // namespace MR
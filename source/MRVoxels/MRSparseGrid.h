@@ -0,0 +1,114 @@
+#pragma once
+
+#include "MRVoxelsFwd.h"
+
+// this is a lightweight header without OpenVDB dependency
+
+#include "MRMesh/MRVector3.h"
+#include "MRMesh/MRBox.h"
+
+#include <cassert>
+#include <vector>
+
+namespace MR
+{
+
+/// \addtogroup BasicStructuresGroup
+/// \{
+
+/// sparse storage of float voxel values in cubic bricks of cBrickSize^3 voxels:
+/// each brick either keeps dense values of all its voxels or is a constant tile with single value (e.g. background or NaN far from the surface),
+/// so the memory is proportional to the number of non-constant bricks;
+/// the bricks are indexed by their integer position in the grid of bricks, and the values inside each brick are ordered with x fastest;
+/// different bricks can be modified from parallel threads simultaneously
+class MRVOXELS_CLASS SparseGrid
+{
+public:
+    /// log2 of the number of voxels along each side of a brick
+    static constexpr int cBrickLog = 3;
+    /// the number of voxels along each side of a brick
+    static constexpr int cBrickSize = 1 << cBrickLog;
+    /// the number of voxels in a brick
+    static constexpr int cBrickVoxels = cBrickSize * cBrickSize * cBrickSize;
+
+    struct Brick
+    {
+        /// minimal and maximal values among not-NaN voxels of the brick within grid dimensions;
+        /// for constant tile both are equal to the value of all voxels (possibly NaN)
+        float min = 0;
+        float max = 0;
+        /// dense values of all voxels of the brick, empty for constant tile
+        std::vector<float> values;
+
+        [[nodiscard]] bool isConstant() const { return values.empty(); }
+    };
+
+    SparseGrid() = default;
+
+    /// creates the grid of given dimensions with all bricks being constant tiles with given value
+    MRVOXELS_API explicit SparseGrid( const Vector3i& dims, float background = 0 );
+
+    /// the number of voxels along each axis
+    [[nodiscard]] const Vector3i& dims() const { return dims_; }
+
+    /// the number of bricks along each axis
+    [[nodiscard]] const Vector3i& numBricks() const { return numBricks_; }
+
+    /// the total number of bricks
+    [[nodiscard]] size_t brickCount() const { return bricks_.size(); }
+
+    /// the index of the brick containing given voxel
+    [[nodiscard]] size_t brickIndex( const Vector3i& voxel ) const
+    {
+        return toBrickIndex_( voxel.x >> cBrickLog, voxel.y >> cBrickLog, voxel.z >> cBrickLog );
+    }
+
+    /// integer position of given brick in the grid of bricks
+    [[nodiscard]] MRVOXELS_API Vector3i brickPos( size_t i ) const;
+
+    /// the voxels of given brick within grid dimensions: min including, max excluding
+    [[nodiscard]] MRVOXELS_API Box3i brickVoxels( size_t i ) const;
+
+    [[nodiscard]] const Brick& brick( size_t i ) const { return bricks_[i]; }
+
+    /// returns the value of given voxel
+    [[nodiscard]] float value( const Vector3i& voxel ) const
+    {
+        assert( voxel.x >= 0 && voxel.x < dims_.x && voxel.y >= 0 && voxel.y < dims_.y && voxel.z >= 0 && voxel.z < dims_.z );
+        const auto & b = bricks_[brickIndex( voxel )];
+        if ( b.values.empty() )
+            return b.min;
+        constexpr int mask = cBrickSize - 1;
+        return b.values[( voxel.x & mask ) + ( ( ( voxel.y & mask ) + ( ( voxel.z & mask ) << cBrickLog ) ) << cBrickLog )];
+    }
+
+    /// makes given brick a constant tile with given value
+    MRVOXELS_API void setBrick( size_t i, float value );
+
+    /// sets cBrickVoxels values of given brick (the values of the voxels outside grid dimensions are ignored);
+    /// if all voxels within grid dimensions have equal values (or all are NaNs) then the brick becomes a constant tile
+    MRVOXELS_API void setBrick( size_t i, std::vector<float> values );
+
+    /// the number of bricks with dense values
+    [[nodiscard]] MRVOXELS_API size_t numDenseBricks() const;
+
+    /// minimal and maximal values among not-NaN voxels of the grid
+    [[nodiscard]] MRVOXELS_API MinMaxf computeMinMax() const;
+
+    /// returns the amount of memory this object occupies on heap
+    [[nodiscard]] MRVOXELS_API size_t heapBytes() const;
+
+private:
+    [[nodiscard]] size_t toBrickIndex_( int x, int y, int z ) const { return x + size_t( numBricks_.x ) * ( y + size_t( numBricks_.y ) * z ); }
+
+    Vector3i dims_;
+    Vector3i numBricks_;
+    std::vector<Brick> bricks_;
+};
+
+/// returns the amount of heap memory occupied by grid
+[[nodiscard]] inline size_t heapBytes( const SparseGrid& grid ) { return grid.heapBytes(); }
+
+/// \}
+
+} // namespace MR
@@ -0,0 +1,386 @@
+#include "MRStockRemoval.h"
+#include "MRMarchingCubes.h"
+
+#include "MRMesh/MRBitSetParallelFor.h"
+#include "MRMesh/MRMesh.h"
+#include "MRMesh/MRMeshBuilder.h"
+#include "MRMesh/MRParallelFor.h"
+#include "MRMesh/MRPolyline.h"
+#include "MRMesh/MRTimer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <optional>
+
+namespace MR
+{
+
+namespace
+{
+
+constexpr int cBlockVoxels = StockRemovalSimulator::cBlockSize * StockRemovalSimulator::cBlockSize * StockRemovalSimulator::cBlockSize;
+
+/// the number of voxels outside the stock on each side of the grid
+constexpr int cVoxelPadding = 2;
+
+/// signed distance from a point to the box, negative inside
+float signedDistance( const Box3f& box, const Vector3f& p )
+{
+    float posSum = 0.f;
+    float maxNeg = -FLT_MAX;
+    for ( int i = 0; i < 3; ++i )
+    {
+        const auto dist = std::max( box.min[i] - p[i], p[i] - box.max[i] );
+        if ( dist > 0.f )
+            posSum += sqr( dist );
+        else
+            maxNeg = std::max( maxNeg, dist );
+    }
+    return posSum > 0.f ? std::sqrt( posSum ) : maxNeg;
+}
+
+} // anonymous namespace
+
+struct StockRemovalSimulator::Block
+{
+    enum class State : std::uint8_t
+    {
+        Outside, ///< no material in the block
+        Inside,  ///< the block is completely filled with material
+        Dense    ///< the values of all voxels are stored
+    } state = State::Outside;
+
+    /// cBlockSize^3 values with x changing fastest
+    std::unique_ptr<float[]> values;
+};
+
+StockRemovalSimulator::StockRemovalSimulator( const Box3f& stock, const EndMillTool& tool, float voxelSize )
+    : voxelSize_( voxelSize )
+    , band_( 2 * voxelSize )
+    , toolDistSq_( tool )
+{
+    MR_TIMER;
+    assert( voxelSize > 0 );
+    assert( stock.valid() );
+    origin_ = stock.min - Vector3f::diagonal( cVoxelPadding * voxelSize );
+    for ( int i = 0; i < 3; ++i )
+    {
+        dims_[i] = (int)std::ceil( stock.size()[i] / voxelSize ) + 1 + 2 * cVoxelPadding;
+        numBlocks_[i] = ( dims_[i] + cBlockSize - 1 ) / cBlockSize;
+    }
+
+    const auto numBlocks = size_t( numBlocks_.x ) * numBlocks_.y * numBlocks_.z;
+    blocks_.resize( numBlocks );
+    blockTriangles_.resize( numBlocks );
+    dirtyBlocks_.resize( numBlocks, true );
+
+    const auto innerStock = stock.expanded( Vector3f::diagonal( -band_ ) );
+    const auto outerStock = stock.expanded( Vector3f::diagonal( band_ ) );
+    ParallelFor( size_t( 0 ), numBlocks, [&]( size_t i )
+    {
+        auto & block = blocks_[i];
+        const auto b = blockPos_( int( i ) );
+        const Box3f blockBox( voxelCenter_( b * cBlockSize ), voxelCenter_( b * cBlockSize + Vector3i::diagonal( cBlockSize - 1 ) ) );
+        if ( innerStock.valid() && innerStock.contains( blockBox.min ) && innerStock.contains( blockBox.max ) )
+        {
+            block.state = Block::State::Inside;
+            return;
+        }
+        if ( !blockBox.intersects( outerStock ) )
+            return;
+
+        block.state = Block::State::Dense;
+        block.values.reset( new float[cBlockVoxels] );
+        int n = 0;
+        for ( int z = 0; z < cBlockSize; ++z )
+            for ( int y = 0; y < cBlockSize; ++y )
+                for ( int x = 0; x < cBlockSize; ++x, ++n )
+                {
+                    const auto vox = b * cBlockSize + Vector3i( x, y, z );
+                    block.values[n] = std::clamp( signedDistance( stock, voxelCenter_( vox ) ), -band_, band_ );
+                }
+    } );
+}
+
+StockRemovalSimulator::~StockRemovalSimulator() = default;
+
+void StockRemovalSimulator::setTool( const EndMillTool& tool )
+{
+    toolDistSq_ = EndMillToolDistanceSq( tool );
+}
+
+Vector3i StockRemovalSimulator::blockPos_( int i ) const
+{
+    const int x = i % numBlocks_.x;
+    i /= numBlocks_.x;
+    const int y = i % numBlocks_.y;
+    return { x, y, i / numBlocks_.y };
+}
+
+Vector3f StockRemovalSimulator::voxelCenter_( const Vector3i& vox ) const
+{
+    return origin_ + voxelSize_ * Vector3f( vox );
+}
+
+float StockRemovalSimulator::value_( const Vector3i& vox ) const
+{
+    if ( vox.x < 0 || vox.y < 0 || vox.z < 0 || vox.x >= dims_.x || vox.y >= dims_.y || vox.z >= dims_.z )
+        return band_;
+    const auto b = vox / cBlockSize;
+    const auto & block = blocks_[blockIndex_( b )];
+    switch ( block.state )
+    {
+    case Block::State::Outside:
+        return band_;
+    case Block::State::Inside:
+        return -band_;
+    case Block::State::Dense:
+        break;
+    }
+    const auto l = vox - b * cBlockSize;
+    return block.values[l.x + cBlockSize * ( l.y + cBlockSize * l.z )];
+}
+
+Box3f StockRemovalSimulator::gridBox() const
+{
+    return { origin_, voxelCenter_( dims_ - Vector3i::diagonal( 1 ) ) };
+}
+
+bool StockRemovalSimulator::cutBlock_( int blockId, const LineSegm3f& segm, const Box3i& voxels, float& removedVolume )
+{
+    auto & block = blocks_[blockId];
+    if ( block.state == Block::State::Outside )
+        return false;
+
+    // the fraction of voxel occupied by material
+    auto occupancy = [this]( float v )
+    {
+        return std::clamp( 0.5f - v / voxelSize_, 0.f, 1.f );
+    };
+
+    const auto b = blockPos_( blockId );
+    const auto first = b * cBlockSize;
+    const auto range = voxels.intersection( Box3i( first, first + Vector3i::diagonal( cBlockSize - 1 ) ) );
+    bool changed = false;
+    float removed = 0;
+    for ( int z = range.min.z; z <= range.max.z; ++z )
+        for ( int y = range.min.y; y <= range.max.y; ++y )
+            for ( int x = range.min.x; x <= range.max.x; ++x )
+            {
+                const int n = ( x - first.x ) + cBlockSize * ( ( y - first.y ) + cBlockSize * ( z - first.z ) );
+                const float old = block.state == Block::State::Inside ? -band_ : block.values[n];
+                if ( old >= band_ )
+                    continue;
+                const auto pos = voxelCenter_( { x, y, z } );
+                const auto proj = closestPointOnLineSegm( pos, segm );
+                const Vector2f toolPos{ ( Vector2f( pos ) - Vector2f( proj ) ).length(), pos.z - proj.z };
+                const float v = std::min( -toolDistSq_.signedDistance( toolPos ), band_ );
+                if ( v <= old )
+                    continue;
+
+                if ( block.state == Block::State::Inside )
+                {
+                    block.values.reset( new float[cBlockVoxels] );
+                    std::fill_n( block.values.get(), cBlockVoxels, -band_ );
+                    block.state = Block::State::Dense;
+                }
+                block.values[n] = v;
+                removed += occupancy( old ) - occupancy( v );
+                changed = true;
+            }
+    if ( !changed )
+        return false;
+
+    removedVolume = removed * sqr( voxelSize_ ) * voxelSize_;
+    if ( std::all_of( block.values.get(), block.values.get() + cBlockVoxels, [this]( float v ) { return v >= band_; } ) )
+    {
+        block.values.reset();
+        block.state = Block::State::Outside;
+    }
+    return true;
+}
+
+StockRemovalMove StockRemovalSimulator::move( const Vector3f& from, const Vector3f& to )
+{
+    StockRemovalMove res;
+    const LineSegm3f segm( from, to );
+    res.length = segm.length();
+
+    // the voxels, which can be touched by the tool
+    const auto & toolBox = toolDistSq_.toolBox();
+    Box3f swept;
+    swept.include( from );
+    swept.include( to );
+    swept.min += Vector3f( toolBox.min.x, toolBox.min.x, toolBox.min.y ) - Vector3f::diagonal( band_ );
+    swept.max += Vector3f( toolBox.max.x, toolBox.max.x, toolBox.max.y ) + Vector3f::diagonal( band_ );
+    Box3i voxels;
+    for ( int i = 0; i < 3; ++i )
+    {
+        voxels.min[i] = std::max( 0, (int)std::floor( ( swept.min[i] - origin_[i] ) / voxelSize_ ) );
+        voxels.max[i] = std::min( dims_[i] - 1, (int)std::ceil( ( swept.max[i] - origin_[i] ) / voxelSize_ ) );
+    }
+    if ( !voxels.valid() )
+        return res;
+
+    const Box3i blockRange( voxels.min / cBlockSize, voxels.max / cBlockSize );
+    std::vector<int> blockIds;
+    for ( int z = blockRange.min.z; z <= blockRange.max.z; ++z )
+        for ( int y = blockRange.min.y; y <= blockRange.max.y; ++y )
+            for ( int x = blockRange.min.x; x <= blockRange.max.x; ++x )
+                blockIds.push_back( blockIndex_( { x, y, z } ) );
+
+    std::vector<float> removed( blockIds.size(), 0.f );
+    std::vector<char> changed( blockIds.size(), false );
+    ParallelFor( blockIds, [&]( size_t i )
+    {
+        changed[i] = cutBlock_( blockIds[i], segm, voxels, removed[i] );
+    } );
+
+    for ( size_t i = 0; i < blockIds.size(); ++i )
+    {
+        if ( !changed[i] )
+            continue;
+        dirtyBlocks_.set( blockIds[i] );
+        res.removedVolume += removed[i];
+    }
+    removedVolume_ += res.removedVolume;
+    return res;
+}
+
+Expected<std::vector<StockRemovalMove>> StockRemovalSimulator::move( const Polyline3& path, ProgressCallback cb )
+{
+    MR_TIMER;
+    const auto contours = path.contours();
+    size_t numMoves = 0;
+    for ( const auto & c : contours )
+        numMoves += c.empty() ? 0 : c.size() - 1;
+
+    std::vector<StockRemovalMove> res;
+    res.reserve( numMoves );
+    for ( const auto & c : contours )
+    {
+        for ( size_t i = 1; i < c.size(); ++i )
+        {
+            res.push_back( move( c[i - 1], c[i] ) );
+            if ( ( res.size() % 1024 ) == 0 && !reportProgress( cb, float( res.size() ) / numMoves ) )
+                return unexpectedOperationCanceled();
+        }
+    }
+    return res;
+}
+
+Expected<BitSet> StockRemovalSimulator::updateMesh( ProgressCallback cb )
+{
+    MR_TIMER;
+    // the cells of marching cubes in a block use the voxels of next blocks as well
+    BitSet toMesh( blocks_.size() );
+    for ( auto i : dirtyBlocks_ )
+    {
+        const auto b = blockPos_( int( i ) );
+        for ( int dz = 0; dz <= std::min( b.z, 1 ); ++dz )
+            for ( int dy = 0; dy <= std::min( b.y, 1 ); ++dy )
+                for ( int dx = 0; dx <= std::min( b.x, 1 ); ++dx )
+                    toMesh.set( blockIndex_( b - Vector3i( dx, dy, dz ) ) );
+    }
+
+    auto isUniform = [&]( const Vector3i& b )
+    {
+        std::optional<Block::State> state;
+        for ( int dz = 0; dz <= 1; ++dz )
+            for ( int dy = 0; dy <= 1; ++dy )
+                for ( int dx = 0; dx <= 1; ++dx )
+                {
+                    const auto n = b + Vector3i( dx, dy, dz );
+                    const auto s = n.x < numBlocks_.x && n.y < numBlocks_.y && n.z < numBlocks_.z ? blocks_[blockIndex_( n )].state : Block::State::Outside;
+                    if ( s == Block::State::Dense || ( state && *state != s ) )
+                        return false;
+                    state = s;
+                }
+        return true;
+    };
+
+    std::atomic<bool> failed{ false };
+    if ( !BitSetParallelFor( toMesh, [&]( size_t i )
+    {
+        auto & tris = blockTriangles_[i];
+        tris.clear();
+        const auto b = blockPos_( int( i ) );
+        if ( isUniform( b ) )
+            return;
+
+        const auto first = b * cBlockSize;
+        SimpleVolume volume;
+        volume.voxelSize = Vector3f::diagonal( voxelSize_ );
+        for ( int j = 0; j < 3; ++j )
+            volume.dims[j] = std::min( cBlockSize + 1, dims_[j] - first[j] );
+        if ( volume.dims.x < 2 || volume.dims.y < 2 || volume.dims.z < 2 )
+            return;
+        volume.data.resize( size_t( volume.dims.x ) * volume.dims.y * volume.dims.z );
+        size_t n = 0;
+        for ( int z = 0; z < volume.dims.z; ++z )
+            for ( int y = 0; y < volume.dims.y; ++y )
+                for ( int x = 0; x < volume.dims.x; ++x )
+                    volume.data.vec_[n++] = value_( first + Vector3i( x, y, z ) );
+
+        auto res = marchingCubes( volume, [&tris]( const std::vector<Triangle3f>& part )
+        {
+            tris.insert( tris.end(), part.begin(), part.end() );
+            return true;
+        }, { .origin = voxelCenter_( first ), .iso = 0.f, .lessInside = true } );
+        if ( !res )
+            failed = true;
+    }, cb ) )
+        return unexpectedOperationCanceled();
+    if ( failed )
+        return unexpected( "Failed to triangulate stock block" );
+
+    dirtyBlocks_.reset();
+    dirtyBlocks_.resize( blocks_.size(), false );
+    return toMesh;
+}
+
+Expected<Mesh> StockRemovalSimulator::getMesh( ProgressCallback cb )
+{
+    MR_TIMER;
+    if ( auto updated = updateMesh( subprogress( cb, 0.0f, 0.7f ) ); !updated )
+        return unexpected( std::move( updated.error() ) );
+
+    size_t numTris = 0;
+    for ( const auto & tris : blockTriangles_ )
+        numTris += tris.size();
+    std::vector<Triangle3f> allTris;
+    allTris.reserve( numTris );
+    for ( const auto & tris : blockTriangles_ )
+        allTris.insert( allTris.end(), tris.begin(), tris.end() );
+    if ( !reportProgress( cb, 0.8f ) )
+        return unexpectedOperationCanceled();
+
+    auto mesh = Mesh::fromPointTriples( allTris, true );
+    // the vertices on the boundaries of blocks are computed separately in each block and can differ by rounding
+    MeshBuilder::uniteCloseVertices( mesh, 1e-3f * voxelSize_ );
+    if ( !reportProgress( cb, 1.0f ) )
+        return unexpectedOperationCanceled();
+    return mesh;
+}
+
+size_t StockRemovalSimulator::numDenseBlocks() const
+{
+    size_t res = 0;
+    for ( const auto & block : blocks_ )
+        if ( block.state == Block::State::Dense )
+            ++res;
+    return res;
+}
+
+size_t StockRemovalSimulator::heapBytes() const
+{
+    size_t res = blocks_.capacity() * sizeof( Block )
+        + numDenseBlocks() * cBlockVoxels * sizeof( float )
+        + dirtyBlocks_.heapBytes()
+        + blockTriangles_.capacity() * sizeof( std::vector<Triangle3f> );
+    for ( const auto & tris : blockTriangles_ )
+        res += tris.capacity() * sizeof( Triangle3f );
+    return res;
+}
+
+} // namespace MR
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "MRVoxelsFwd.h"
+#include "MRSweptVolume.h"
+
+#include "MRMesh/MRBitSet.h"
+#include "MRMesh/MRBox.h"
+#include "MRMesh/MRExpected.h"
+#include "MRMesh/MRProgressCallback.h"
+
+#include <array>
+#include <memory>
+#include <vector>
+
+namespace MR
+{
+
+/// the result of one tool movement in stock removal simulation
+struct StockRemovalMove
+{
+    /// the volume of material removed by the movement
+    float removedVolume = 0.f;
+    /// the length of tool path of the movement
+    float length = 0.f;
+
+    /// material removal rate (volume per time unit) for given feedrate (length per time unit)
+    [[nodiscard]] float removalRate( float feedrate ) const { return length > 0.f ? removedVolume * feedrate / length : 0.f; }
+};
+
+/// Simulates milling of box stock by end mill tool with vertical axis move by move
+/// \details the stock is stored as truncated signed distance in cubic blocks of voxels:
+/// only the blocks crossed by the stock surface keep dense voxel data, while the blocks fully inside or outside the material keep just their state,
+/// so the memory is proportional to the area of machined surface rather than to the volume of the stock;
+/// each movement updates only the blocks touched by the tool and marks them dirty,
+/// and the mesh of the stock is rebuilt by marching cubes only in the dirty blocks;
+/// the tool is swept along a movement in the same approximation as in \ref computeSweptVolumeWithDistanceVolume
+class StockRemovalSimulator
+{
+public:
+    /// \param stock the initial box of material
+    /// \param voxelSize the size of voxels, which defines the precision of simulation
+    MRVOXELS_API StockRemovalSimulator( const Box3f& stock, const EndMillTool& tool, float voxelSize );
+    MRVOXELS_API ~StockRemovalSimulator();
+
+    /// replaces the tool for next movements
+    MRVOXELS_API void setTool( const EndMillTool& tool );
+
+    /// removes the material swept by the tool tip moving linearly from (from) to (to)
+    MRVOXELS_API StockRemovalMove move( const Vector3f& from, const Vector3f& to );
+
+    /// removes the material swept by the tool tip moving along all edges of the tool path;
+    /// \return the results of all movements in the order of tool path edges
+    MRVOXELS_API Expected<std::vector<StockRemovalMove>> move( const Polyline3& path, ProgressCallback cb = {} );
+
+    /// the total volume of removed material since construction
+    [[nodiscard]] double removedVolume() const { return removedVolume_; }
+
+    /// the box of voxel grid, which includes the stock with some padding
+    [[nodiscard]] Box3f gridBox() const;
+
+    /// the number of voxels along each side of a block
+    static constexpr int cBlockSize = 16;
+
+    /// the blocks changed since the last update of the mesh
+    [[nodiscard]] const BitSet& dirtyBlocks() const { return dirtyBlocks_; }
+
+    /// rebuilds the triangles of all changed blocks by marching cubes;
+    /// \return the blocks, which triangles were rebuilt
+    MRVOXELS_API Expected<BitSet> updateMesh( ProgressCallback cb = {} );
+
+    /// updates the mesh in changed blocks and returns the mesh of whole stock
+    MRVOXELS_API Expected<Mesh> getMesh( ProgressCallback cb = {} );
+
+    /// the number of blocks with dense voxel data
+    [[nodiscard]] MRVOXELS_API size_t numDenseBlocks() const;
+
+    /// returns the amount of memory this object occupies on heap
+    [[nodiscard]] MRVOXELS_API size_t heapBytes() const;
+
+private:
+    struct Block;
+
+    [[nodiscard]] int blockIndex_( const Vector3i& b ) const { return b.x + numBlocks_.x * ( b.y + numBlocks_.y * b.z ); }
+    [[nodiscard]] Vector3i blockPos_( int i ) const;
+    [[nodiscard]] Vector3f voxelCenter_( const Vector3i& vox ) const;
+    [[nodiscard]] float value_( const Vector3i& vox ) const;
+
+    /// removes the material inside the tool moving along given segment in the voxels of given block within given range;
+    /// \return false if the block was not changed
+    bool cutBlock_( int blockId, const LineSegm3f& segm, const Box3i& voxels, float& removedVolume );
+
+    Vector3f origin_;
+    float voxelSize_ = 0.f;
+    /// the values are clamped in [-band_, +band_]
+    float band_ = 0.f;
+    Vector3i dims_;
+    Vector3i numBlocks_;
+    EndMillToolDistanceSq toolDistSq_;
+    std::vector<Block> blocks_;
+    BitSet dirtyBlocks_;
+    /// the triangles of the surface in each block
+    std::vector<std::vector<Triangle3f>> blockTriangles_;
+    double removedVolume_ = 0;
+};
+
+} // namespace MR
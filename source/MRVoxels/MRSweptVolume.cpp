@@ -363,73 +363,77 @@ Expected<Mesh> computeSweptVolumeWithDistanceVolume( const ComputeSweptVolumePar
     } );
 }
 
-Expected<Mesh> computeSweptVolumeWithDistanceVolume( const ComputeSweptVolumeParameters& params )
+EndMillToolDistanceSq::EndMillToolDistanceSq( const EndMillTool& tool )
+    : type_( tool.cutter.type )
+    , radius_( tool.diameter / 2.f )
+    , toolBox_( { -radius_, 0.f }, { +radius_, tool.length } )
 {
-    if ( params.toolSpec )
+    using Cutter = EndMillCutter::Type;
+    switch ( type_ )
     {
-        const auto& toolSpec = *params.toolSpec;
-        const auto radius = toolSpec.diameter / 2.f;
-        const Box2f toolBox {
-            { -radius, 0.f },
-            { +radius, toolSpec.length },
-        };
-
-        using Cutter = EndMillCutter::Type;
-        switch ( toolSpec.cutter.type )
-        {
-        case Cutter::Flat:
-            return computeSweptVolumeWithDistanceVolume( params, toolBox, [toolBox] ( const Vector2f& toolPos )
-            {
-                return getBoundarySignedDistanceSq( toolBox, toolPos );
-            } );
+    case Cutter::Flat:
+        break;
+    case Cutter::Ball:
+        center_ = { 0.f, radius_ };
+        break;
+    case Cutter::BullNose:
+        cornerRadius_ = tool.cutter.cornerRadius;
+        center_ = { radius_ - cornerRadius_, cornerRadius_ };
+        break;
+    case Cutter::Chamfer:
+        endRadius_ = tool.cutter.endDiameter / 2.f;
+        cutterHeight_ = tool.getMinimalCutLength();
+        slope_ = { { endRadius_, 0.f }, { radius_, cutterHeight_ } };
+        break;
+    case Cutter::Count:
+        MR_UNREACHABLE
+    }
+}
 
-        case Cutter::Ball:
-        {
-            const Vector2f center { 0.f, radius };
-            return computeSweptVolumeWithDistanceVolume( params, toolBox, [radius, toolBox, center] ( const Vector2f& toolPos )
-            {
-                if ( toolPos.y <= center.y )
-                    return sqrSgn( ( toolPos - center ).length() - radius );
-                else
-                    return getBoundarySignedDistanceSq( toolBox, toolPos );
-            } );
-        }
+float EndMillToolDistanceSq::operator()( const Vector2f& toolPos ) const
+{
+    using Cutter = EndMillCutter::Type;
+    switch ( type_ )
+    {
+    case Cutter::Flat:
+        return getBoundarySignedDistanceSq( toolBox_, toolPos );
 
-        case Cutter::BullNose:
-        {
-            const auto cornerRadius = toolSpec.cutter.cornerRadius;
-            const Vector2f center { radius - cornerRadius, cornerRadius };
-            return computeSweptVolumeWithDistanceVolume( params, toolBox, [cornerRadius, toolBox, center] ( const Vector2f& toolPos )
-            {
-                if ( center.x <= toolPos.x && toolPos.y <= center.y )
-                    return sqrSgn( ( toolPos - center ).length() - cornerRadius );
-                else
-                    return getBoundarySignedDistanceSq( toolBox, toolPos );
-            } );
-        }
+    case Cutter::Ball:
+        if ( toolPos.y <= center_.y )
+            return sqrSgn( ( toolPos - center_ ).length() - radius_ );
+        else
+            return getBoundarySignedDistanceSq( toolBox_, toolPos );
 
-        case Cutter::Chamfer:
-        {
-            const auto endRadius = toolSpec.cutter.endDiameter / 2.f;
-            const auto cutterHeight = toolSpec.getMinimalCutLength();
-            const LineSegm2f slope {
-                { endRadius, 0.f },
-                { radius, cutterHeight },
-            };
-            return computeSweptVolumeWithDistanceVolume( params, toolBox, [endRadius, cutterHeight, slope, toolBox] ( const Vector2f& toolPos )
-            {
-                if ( endRadius <= toolPos.x && toolPos.y <= cutterHeight )
-                    return getDistanceSq( slope, toolPos ) * ( isCcw( slope, toolPos ) ? -1.f : +1.f );
-                else
-                    return getBoundarySignedDistanceSq( toolBox, toolPos );
-            } );
-        }
+    case Cutter::BullNose:
+        if ( center_.x <= toolPos.x && toolPos.y <= center_.y )
+            return sqrSgn( ( toolPos - center_ ).length() - cornerRadius_ );
+        else
+            return getBoundarySignedDistanceSq( toolBox_, toolPos );
 
-        case Cutter::Count:
-            MR_UNREACHABLE
-        }
+    case Cutter::Chamfer:
+        if ( endRadius_ <= toolPos.x && toolPos.y <= cutterHeight_ )
+            return getDistanceSq( slope_, toolPos ) * ( isCcw( slope_, toolPos ) ? -1.f : +1.f );
+        else
+            return getBoundarySignedDistanceSq( toolBox_, toolPos );
+
+    case Cutter::Count:
         MR_UNREACHABLE
     }
+    MR_UNREACHABLE
+}
+
+float EndMillToolDistanceSq::signedDistance( const Vector2f& toolPos ) const
+{
+    return sqrtSgn( ( *this )( toolPos ) );
+}
+
+Expected<Mesh> computeSweptVolumeWithDistanceVolume( const ComputeSweptVolumeParameters& params )
+{
+    if ( params.toolSpec )
+    {
+        const EndMillToolDistanceSq toolDistSq( *params.toolSpec );
+        return computeSweptVolumeWithDistanceVolume( params, toolDistSq.toolBox(), toolDistSq );
+    }
     else
     {
         const auto outline = makeToolOutline( params.toolMesh );
@@ -2,7 +2,10 @@
 
 #include "MRVoxelsFwd.h"
 
+#include "MRMesh/MRBox.h"
+#include "MRMesh/MREndMill.h"
 #include "MRMesh/MRExpected.h"
+#include "MRMesh/MRLineSegm.h"
 #include "MRMesh/MRMeshPart.h"
 #include "MRMesh/MRPolyline.h"
 
@@ -11,14 +14,41 @@
 namespace MR
 {
 
-struct EndMillTool;
-
 /// Compute bounding box for swept volume for given tool and toolpath
 MRVOXELS_API Box3f computeWorkArea( const Polyline3& toolpath, const MeshPart& tool );
 
 /// Compute required voxel volume's dimensions for given work area
 MRVOXELS_API Box3i computeGridBox( const Box3f& workArea, float voxelSize );
 
+/// Computes squared signed distance (negative inside) from a point to the end mill tool
+/// \details the point is given in the tool's coordinates: x is the distance from the tool axis, y is the height above the tool tip
+class EndMillToolDistanceSq
+{
+public:
+    MRVOXELS_API explicit EndMillToolDistanceSq( const EndMillTool& tool );
+
+    [[nodiscard]] MRVOXELS_API float operator()( const Vector2f& toolPos ) const;
+
+    /// signed distance (negative inside) from a point in the tool's coordinates to the tool
+    [[nodiscard]] MRVOXELS_API float signedDistance( const Vector2f& toolPos ) const;
+
+    /// the bounding box of the tool's profile, where x is from -radius to +radius and y is from 0 to the tool length
+    [[nodiscard]] const Box2f& toolBox() const { return toolBox_; }
+
+private:
+    EndMillCutter::Type type_;
+    float radius_ = 0.f;
+    Box2f toolBox_;
+    /// (ball, bull nose) the center of the rounded part
+    Vector2f center_;
+    /// (bull nose) corner radius
+    float cornerRadius_ = 0.f;
+    /// (chamfer) the parameters of the slope
+    float endRadius_ = 0.f;
+    float cutterHeight_ = 0.f;
+    LineSegm2f slope_;
+};
+
 /// Parameters for computeSweptVolume* functions
 struct ComputeSweptVolumeParameters
 {
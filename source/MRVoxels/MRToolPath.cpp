@@ -24,6 +24,8 @@
 #include "MRMesh/MRInnerShell.h"
 #include "MRMesh/MRRingIterator.h"
 #include "MRMesh/MREdgeMetric.h"
+#include "MRMesh/MRParallelFor.h"
+#include "MRMesh/MRTimer.h"
 
 #include <sstream>
 #include <span>
@@ -466,6 +468,55 @@ Intervals getIntervals( const MeshPart& mp, const MeshPart* offset, const V3fIt
     return res;
 }
 
+// converts the section into the contour of points
+Contour3f sectionToContour( const Mesh& mesh, const SurfacePath& section )
+{
+    Polyline3 polyline;
+    polyline.addFromSurfacePath( mesh, section );
+    auto contours = polyline.contours();
+    if ( contours.empty() )
+        return {};
+    return std::move( contours.front() );
+}
+
+// computes the offset of all sections of one layer by the tool radius in the plane of the layer
+Contours3f offsetLayerSections( const Mesh& mesh, const PlaneSections& sections, const ToolPathParams& params )
+{
+    Polyline3 polyline;
+    for ( const auto& section : sections )
+    {
+        if ( section.size() < 2 )
+            continue;
+        polyline.addFromSurfacePath( mesh, section );
+    }
+    if ( polyline.points.empty() )
+        return {};
+
+    const auto currentZ = polyline.points.front().z;
+    auto polyline2d = polyline.toPolyline<Vector2f>();
+    const ContourToDistanceMapParams dmParams( params.voxelSize, polyline2d.contours(), params.millRadius + 3.0f * params.voxelSize, true );
+    const ContoursDistanceMapOptions dmOptions{ .signMethod = ContoursDistanceMapOptions::WindingRule, .minDist = params.millRadius - 2 * params.voxelSize, .maxDist = params.millRadius + 2 * params.voxelSize };
+    const auto dm = distanceMapFromContours( polyline2d, dmParams, dmOptions );
+    DistanceMapToWorld dmToWorld( dmParams );
+    auto offsetRes = distanceMapTo2DIsoPolyline( dm, dmToWorld, params.millRadius );
+    polyline2d = offsetRes.first;
+    polyline = polyline2d.toPolyline<Vector3f>();
+    polyline.transform( offsetRes.second * AffineXf3f::translation( { 0, 0, currentZ } ) );
+    return polyline.contours();
+}
+
+// the contour of one section prepared for linking in the tool path
+struct LayerContour
+{
+    // the section the contour was made from, null for offset contours
+    const SurfacePath* section = nullptr;
+    // empty if the section shall be skipped
+    Contour3f contour;
+    // the intervals of the contour to be processed by the tool
+    Intervals intervals;
+};
+using LayerContours = std::vector<LayerContour>;
+
 // if distance between the last point and the given one is more than critical distance
 // we should make a transit on the safe height
 void transitOverSafeZ( const Vector3f& p, ToolPathResult& res, const ToolPathParams& params, float safeZ, float currentZ, float& lastFeed )
@@ -498,6 +549,7 @@ Expected<ToolPathResult> lacingToolPath( const MeshPart& mp, const ToolPathParam
 {
     if ( cutDirection != Axis::X && cutDirection != Axis::Y )
         return unexpected( "Lacing can be done along the X or Y axis" );
+    MR_TIMER;
 
     const bool cutDirectionIsX = cutDirection == Axis::X;
     const auto cutDirectionIdx = int( cutDirection );
@@ -526,10 +578,88 @@ Expected<ToolPathResult> lacingToolPath( const MeshPart& mp, const ToolPathParam
 
     MeshEdgePoint lastEdgePoint = {};
     // bypass direction is not meaningful for this toolpath, so leave it as default
+    Timer timer( "extract sections" );
     auto allSections = extractAllSections( mesh, box, cutDirection, params.sectionStep, steps, BypassDirection::Clockwise, subprogress( params.cb, 0.25f, 0.5f ) );
     if ( allSections.empty() )
         return unexpectedOperationCanceled();
-    const auto sbp = subprogress( params.cb, 0.5f, 1.0f );
+
+    // the order of sections in each layer, their contours and the intervals over the selected area are independent of other layers,
+    // so they are computed in parallel, and only linking them in one tool path is sequential
+    timer.restart( "prepare layers" );
+    std::vector<LayerContours> layers( steps );
+    const auto prepared = ParallelFor( 0, steps, [&] ( int step )
+    {
+        // move from left to right and then from right to left to make the smoothest path
+        const bool moveForward = step & 1;
+
+        auto& sections = allSections[step];
+        // sort the sections so that the transitions between them do not intersect the original part.
+        auto compareFn = [&mesh, cutDirectionIsX, moveForward] ( const SurfacePath& a, const SurfacePath& b )
+        {
+            if ( cutDirectionIsX )
+            {
+                return moveForward ?
+                    mesh.edgePoint( a[0] ).y < mesh.edgePoint( b[0] ).y :
+                    mesh.edgePoint( a[0] ).y > mesh.edgePoint( b[0] ).y;
+            }
+            else
+            {
+                return moveForward ?
+                    mesh.edgePoint( a[0] ).x > mesh.edgePoint( b[0] ).x :
+                    mesh.edgePoint( a[0] ).x < mesh.edgePoint( b[0] ).x;
+            }
+        };
+        if ( sections.size() > 1 )
+            std::sort( sections.begin(), sections.end(), compareFn );
+
+        auto& layer = layers[step];
+        layer.resize( sections.size() );
+        // there could be many sections in one slice
+        for ( size_t i = 0; i < sections.size(); ++i )
+        {
+            const auto& section = sections[i];
+            auto& lc = layer[i];
+            lc.section = &section;
+            lc.contour = sectionToContour( mesh, section );
+            if ( lc.contour.size() < 3 )
+            {
+                lc.contour.clear();
+                continue;
+            }
+
+            if ( lc.contour.size() > section.size() )
+                lc.contour.resize( section.size() );
+            const auto& contour = lc.contour;
+
+            // we need to find the most left and the most right point on the mesh
+            // and move tol from one side to another
+            auto bottomLeftIt = contour.end();
+            auto bottomRightIt = contour.end();
+
+            for ( auto it = contour.begin(); it < contour.end(); ++it )
+            {
+                if ( bottomLeftIt == contour.end() || ( *it )[sideDirectionIdx] < ( *bottomLeftIt )[sideDirectionIdx] || ( ( *it )[sideDirectionIdx] == ( *bottomLeftIt )[sideDirectionIdx] && it->z < bottomLeftIt->z ) )
+                    bottomLeftIt = it;
+
+                if ( bottomRightIt == contour.end() || ( *it )[sideDirectionIdx] > ( *bottomRightIt )[sideDirectionIdx] || ( ( *it )[sideDirectionIdx] == ( *bottomRightIt )[sideDirectionIdx] && it->z < bottomRightIt->z ) )
+                    bottomRightIt = it;
+            }
+
+            if ( cutDirection == Axis::Y )
+            {
+                std::swap( bottomLeftIt, bottomRightIt );
+                if ( !moveForward && bottomLeftIt != contour.begin() )
+                    --bottomLeftIt;
+            }
+
+            lc.intervals = getIntervals( mp, params.offsetMesh, bottomLeftIt, bottomRightIt, contour.begin(), contour.end(), moveForward, params.millRadius );
+        }
+    }, subprogress( params.cb, 0.5f, 0.75f ) );
+    if ( !prepared )
+        return unexpectedOperationCanceled();
+
+    timer.restart( "link layers" );
+    const auto sbp = subprogress( params.cb, 0.75f, 1.0f );
 
     float lastFeed = 0;
     const bool expandToolpath = params.toolpathExpansion > 0.f;
@@ -618,8 +748,8 @@ Expected<ToolPathResult> lacingToolPath( const MeshPart& mp, const ToolPathParam
         // move from left to right and then from right to left to make the smoothest path
         const bool moveForward = step & 1;
 
-        auto& sections = allSections[step];
-        if ( sections.empty() )
+        const auto& layer = layers[step];
+        if ( layer.empty() )
         {
             if ( expandToolpath )
                 // create toolpath to the end of this section layer (step) (skip empty section)
@@ -627,64 +757,17 @@ Expected<ToolPathResult> lacingToolPath( const MeshPart& mp, const ToolPathParam
             continue;
         }
 
-        // sort the sections so that the transitions between them do not intersect the original part.
-        auto compareFn = [&mesh, cutDirectionIsX, moveForward] ( const SurfacePath& a, const SurfacePath& b )
-        {
-            if ( cutDirectionIsX )
-            {
-                return moveForward ?
-                    mesh.edgePoint( a[0] ).y < mesh.edgePoint( b[0] ).y :
-                    mesh.edgePoint( a[0] ).y > mesh.edgePoint( b[0] ).y;
-            }
-            else
-            {
-                return moveForward ?
-                    mesh.edgePoint( a[0] ).x > mesh.edgePoint( b[0] ).x :
-                    mesh.edgePoint( a[0] ).x < mesh.edgePoint( b[0] ).x;
-            }
-        };
-        if ( sections.size() > 1 )
-            std::sort( sections.begin(), sections.end(), compareFn );
-        
-        // there could be many sections in one slice
-        for ( const auto& section : sections )
+        for ( const auto& lc : layer )
         {
-            Polyline3 polyline;
-            polyline.addFromSurfacePath( mesh, section );
-            auto contours = polyline.contours();
-            auto& contour = contours.front();
-
-            if ( contour.size() < 3 )
+            const auto& contour = lc.contour;
+            if ( contour.empty() )
                 continue;
-
-            if ( contour.size() > section.size() )
-                contour.resize( section.size() );
+            const auto& section = *lc.section;
 
             if ( params.isolines )
                 params.isolines->push_back( contour );
 
-            // we need to find the most left and the most right point on the mesh
-            // and move tol from one side to another
-            auto bottomLeftIt = contour.end();
-            auto bottomRightIt = contour.end();
-
-            for ( auto it = contour.begin(); it < contour.end(); ++it )
-            {
-                if ( bottomLeftIt == contour.end() || ( *it )[sideDirectionIdx] < ( *bottomLeftIt )[sideDirectionIdx] || ( ( *it )[sideDirectionIdx] == ( *bottomLeftIt )[sideDirectionIdx] && it->z < bottomLeftIt->z ) )
-                    bottomLeftIt = it;
-
-                if ( bottomRightIt == contour.end() || ( *it )[sideDirectionIdx] > ( *bottomRightIt )[sideDirectionIdx] || ( ( *it )[sideDirectionIdx] == ( *bottomRightIt )[sideDirectionIdx] && it->z < bottomRightIt->z ) )
-                    bottomRightIt = it;
-            }
-
-            if ( cutDirection == Axis::Y )
-            {
-                std::swap( bottomLeftIt, bottomRightIt );
-                if ( !moveForward && bottomLeftIt != contour.begin() )
-                    --bottomLeftIt;
-            }
-
-            const auto intervals = getIntervals( mp, params.offsetMesh, bottomLeftIt, bottomRightIt, contour.begin(), contour.end(), moveForward, params.millRadius );
+            const auto& intervals = lc.intervals;
             if ( intervals.empty() )
                 continue;
 
@@ -793,6 +876,7 @@ Expected<ToolPathResult> lacingToolPath( const MeshPart& mp, const ToolPathParam
 
 Expected<ToolPathResult>  constantZToolPath( const MeshPart& mp, const ToolPathParams& params )
 {
+    MR_TIMER;
     ToolPathResult  res;
 
     if ( !params.offsetMesh )
@@ -819,11 +903,52 @@ Expected<ToolPathResult>  constantZToolPath( const MeshPart& mp, const ToolPathP
 
     const float critTransitionLengthSq = params.critTransitionLength * params.critTransitionLength;
 
+    Timer timer( "extract sections" );
     std::vector<PlaneSections> sections = extractAllSections( mesh, box, Axis::Z, params.sectionStep, steps, params.bypassDir, subprogress( params.cb, 0.25f, 0.5f ) );
     if ( sections.empty() )
         return unexpectedOperationCanceled();
 
-    const auto sbp = subprogress( params.cb, 0.5f, 1.0f );
+    // the contours of all layers (with offsets for flat tool) and their intervals over the selected area are independent,
+    // so they are computed in parallel, and only linking them in one tool path is sequential
+    timer.restart( "prepare layers" );
+    std::vector<LayerContours> layers( steps );
+    const auto prepared = ParallelFor( 0, steps, [&] ( int step )
+    {
+        auto& layer = layers[step];
+        if ( params.flatTool )
+        {
+            auto contours = offsetLayerSections( mesh, sections[step], params );
+            layer.resize( contours.size() );
+            for ( size_t i = 0; i < contours.size(); ++i )
+            {
+                auto& lc = layer[i];
+                lc.contour = std::move( contours[i] );
+                lc.intervals = getIntervals( mp, params.offsetMesh, lc.contour.cbegin(), lc.contour.cend(), lc.contour.cbegin(), lc.contour.cend(), true, params.millRadius );
+            }
+            return;
+        }
+
+        layer.resize( sections[step].size() );
+        for ( size_t i = 0; i < layer.size(); ++i )
+        {
+            const auto& section = sections[step][i];
+            auto& lc = layer[i];
+            lc.section = &section;
+            if ( section.size() < 2 )
+                continue;
+
+            lc.contour = sectionToContour( mesh, section );
+            if ( lc.contour.size() > section.size() )
+                lc.contour.resize( section.size() );
+            if ( mp.region && !lc.contour.empty() )
+                lc.intervals = getIntervals( mp, params.offsetMesh, lc.contour.cbegin(), lc.contour.cend(), lc.contour.cbegin(), lc.contour.cend(), true, params.millRadius );
+        }
+    }, subprogress( params.cb, 0.5f, 0.75f ) );
+    if ( !prepared )
+        return unexpectedOperationCanceled();
+
+    timer.restart( "link layers" );
+    const auto sbp = subprogress( params.cb, 0.75f, 1.0f );
 
     float lastFeed = 0;
 
@@ -853,15 +978,11 @@ Expected<ToolPathResult>  constantZToolPath( const MeshPart& mp, const ToolPathP
     };
 
     auto& commands = res.commands;
-    const auto addPointsFromInterval = [&] ( const MeshPart& mp, const ToolPathParams& params, const Contour3f& contour )
+    const auto addPointsFromIntervals = [&] ( const LayerContour& lc )
     {
-        const auto intervals = getIntervals( mp, params.offsetMesh, contour.begin(), contour.end(), contour.begin(), contour.end(), true, params.millRadius );
-        if ( intervals.empty() )
-            return;
-
-        for ( const auto& interval : intervals )
+        for ( const auto& interval : lc.intervals )
         {
-            if ( !mp.region || interval.first != contour.begin() || res.commands.empty() )
+            if ( !mp.region || interval.first != lc.contour.begin() || res.commands.empty() )
             {
                 if ( res.commands.empty() )
                     res.commands.push_back( { .type = MoveType::FastLinear, .z = safeZ } );
@@ -885,59 +1006,29 @@ Expected<ToolPathResult>  constantZToolPath( const MeshPart& mp, const ToolPathP
 
         if ( params.flatTool )
         {
-            Polyline3 polyline;
-            for ( const auto& section : sections[step] )
-            {
-                if ( section.size() < 2 )
-                    continue;
-                polyline.addFromSurfacePath( mesh, section );
-            }
-
-            // make polyline offset
-            const auto currentZ = polyline.points.front().z;
-            auto polyline2d = polyline.toPolyline<Vector2f>();
-            const ContourToDistanceMapParams dmParams( params.voxelSize, polyline2d.contours(), params.millRadius + 3.0f * params.voxelSize, true );
-            const ContoursDistanceMapOptions dmOptions{ .signMethod = ContoursDistanceMapOptions::WindingRule, .minDist = params.millRadius - 2 * params.voxelSize, .maxDist = params.millRadius + 2 * params.voxelSize };
-            const auto dm = distanceMapFromContours( polyline2d, dmParams, dmOptions );
-            DistanceMapToWorld dmToWorld( dmParams );
-            auto offsetRes = distanceMapTo2DIsoPolyline( dm, dmToWorld, params.millRadius );
-            polyline2d = offsetRes.first;
-            polyline = polyline2d.toPolyline<Vector3f>();
-            polyline.transform( offsetRes.second * AffineXf3f::translation( { 0, 0, currentZ } ) );
-
-            auto contours = polyline.contours();
-            for ( auto& contour : contours )
+            for ( const auto& lc : layers[step] )
             {
                 if ( params.isolines )
-                    params.isolines->push_back( contour );
+                    params.isolines->push_back( lc.contour );
 
-                addPointsFromInterval( mp, params, contour );
+                addPointsFromIntervals( lc );
             }
         }
         else
         {
-            for ( const auto& section : sections[step] )
+            for ( const auto& lc : layers[step] )
             {
-                if ( section.size() < 2 )
+                const auto& contour = lc.contour;
+                if ( contour.empty() )
                     continue;
-
-                Polyline3 polyline;
-                polyline.addFromSurfacePath( mesh, section );
-
-                auto contours = polyline.contours();
-                if ( contours.empty() )
-                    continue;
-
-                auto& contour = contours.front();
-                if ( contour.size() > section.size() )
-                    contour.resize( section.size() );
+                const auto& section = *lc.section;
 
                 if ( params.isolines )
                     params.isolines->push_back( contour );
 
-                if ( mp.region || params.flatTool )
+                if ( mp.region )
                 {
-                    addPointsFromInterval( mp, params, contour );
+                    addPointsFromIntervals( lc );
                     continue;
                 }
 
@@ -1021,6 +1112,7 @@ Expected<ToolPathResult>  constantZToolPath( const MeshPart& mp, const ToolPathP
 
 Expected<ToolPathResult> constantCuspToolPath( const MeshPart& mp, const ConstantCuspParams& params )
 {
+    MR_TIMER;
     ToolPathResult  res;
 
     if ( !params.offsetMesh )
@@ -1163,28 +1255,35 @@ Expected<ToolPathResult> constantCuspToolPath( const MeshPart& mp, const Constan
             }
         };
 
-        if ( !reportProgress( cb, 0.5f ) )
+        // the contours of all isolines are computed in parallel before sequential linking
+        std::vector<const SurfacePath*> isolines;
+        isolines.reserve( extract.sortedIsolines.size() );
+        for ( const auto& isoline : extract.sortedIsolines )
+            isolines.push_back( &isoline );
+        std::vector<Contour3f> isolineContours( isolines.size() );
+        const auto prepared = ParallelFor( isolineContours, [&] ( size_t i )
+        {
+            const auto& surfacePath = *isolines[i];
+            if ( surfacePath.empty() || ( !res.modifiedRegion.empty() && !res.modifiedRegion.test( mesh.topology.left( surfacePath[0].e ) ) ) )
+                return;
+            isolineContours[i] = sectionToContour( mesh, surfacePath );
+        }, subprogress( cb, 0.4f, 0.5f ) );
+        if ( !prepared )
             return stringOperationCanceled();
 
         const auto sbp = subprogress( cb, 0.5f, 1.0f );
         
         // go on in the inverse order (from the highest isoline to the lowest )
-        auto isolineIt = extract.sortedIsolines.begin();
-        for ( size_t i = 0; isolineIt != extract.sortedIsolines.end(); ++i )
+        for ( size_t i = 0; i < isolines.size(); ++i )
         {
-            if ( !reportProgress( sbp, float( i ) / extract.sortedIsolines.size() ) )
+            if ( !reportProgress( sbp, float( i ) / isolines.size() ) )
                 return stringOperationCanceled();
 
-            auto& surfacePath = *isolineIt++;
-             
-            if ( surfacePath.empty() || ( !res.modifiedRegion.empty() && !res.modifiedRegion.test( mesh.topology.left( surfacePath[0].e ) ) ) )
+            const auto& surfacePath = *isolines[i];
+            const auto& contour = isolineContours[i];
+            if ( contour.empty() )
                 continue;
 
-            Polyline3 polyline;
-            polyline.addFromSurfacePath( mesh, surfacePath );
-            const auto contours = polyline.contours();
-            const auto& contour = contours.front();
-
             if ( params.isolines )
                 params.isolines->push_back( contour );
 
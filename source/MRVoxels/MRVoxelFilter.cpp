@@ -2,6 +2,12 @@
 
 #include <MRVoxels/MRVoxelsVolume.h>
 #include <MRVoxels/MRVDBFloatGrid.h>
+#include <MRMesh/MRVolumeIndexer.h>
+#include <MRMesh/MRParallelFor.h>
+#include <MRMesh/MRParallelMinMax.h>
+#include <MRMesh/MRTimer.h>
+#include <MRPch/MRTBB.h>
+#include <variant>
 
 #pragma warning(push)
 #pragma warning(disable: 4464) //relative include path contains '..' in <tbb/parallel_for.h>
@@ -11,6 +17,355 @@
 namespace MR
 {
 
+namespace
+{
+
+/// the number of output z-slices processed sequentially by one task in separable filtering:
+/// each task additionally filters along X and Y the slices within window radius outside of its slab
+constexpr int cSlabSize = 16;
+
+/// weights of 1D gaussian kernel of given radius with sigma equal to half of the radius
+std::vector<float> gaussianKernel( int r )
+{
+    assert( r > 0 );
+    std::vector<float> w( 2 * r + 1 );
+    const float sigma = 0.5f * r;
+    float sum = 0;
+    for ( int i = -r; i <= r; ++i )
+        sum += w[i + r] = std::exp( -0.5f * sqr( i / sigma ) );
+    for ( auto & x : w )
+        x /= sum;
+    return w;
+}
+
+template <typename T>
+inline T fromFloat( float v )
+{
+    if constexpr ( std::is_same_v<T, float> )
+        return v;
+    else
+        return T( std::clamp( v + 0.5f, 0.0f, float( std::numeric_limits<T>::max() ) ) );
+}
+
+/// combines (2r+1) rows of equal length into one by 1D filter
+class RowCombiner
+{
+public:
+    RowCombiner( VoxelFilterType type, int r ) : type_( type ), count_( 2 * r + 1 )
+    {
+        if ( type == VoxelFilterType::Gaussian )
+            weights_ = gaussianKernel( r );
+        else if ( type == VoxelFilterType::Mean )
+            weights_.resize( count_, 1.0f / count_ );
+    }
+
+    int count() const { return count_; }
+
+    /// out[i] = filter( rows[0][i], ..., rows[count-1][i] ), all loops are over contiguous memory
+    void operator()( const float* const* rows, float* out, size_t n ) const
+    {
+        if ( type_ == VoxelFilterType::Minimum || type_ == VoxelFilterType::Maximum )
+        {
+            std::copy( rows[0], rows[0] + n, out );
+            for ( int k = 1; k < count_; ++k )
+            {
+                const float* row = rows[k];
+                if ( type_ == VoxelFilterType::Minimum )
+                {
+                    for ( size_t i = 0; i < n; ++i )
+                        out[i] = std::min( out[i], row[i] );
+                }
+                else
+                {
+                    for ( size_t i = 0; i < n; ++i )
+                        out[i] = std::max( out[i], row[i] );
+                }
+            }
+            return;
+        }
+
+        const float w0 = weights_[0];
+        const float* row0 = rows[0];
+        for ( size_t i = 0; i < n; ++i )
+            out[i] = w0 * row0[i];
+        for ( int k = 1; k < count_; ++k )
+        {
+            const float w = weights_[k];
+            const float* row = rows[k];
+            for ( size_t i = 0; i < n; ++i )
+                out[i] += w * row[i];
+        }
+    }
+
+private:
+    VoxelFilterType type_;
+    int count_ = 1;
+    std::vector<float> weights_;
+};
+
+/// Mean, Gaussian, Minimum and Maximum filters as three 1D passes:
+/// each z-slice is filtered along X and Y and kept in a ring buffer of (2r+1) slices, which are combined along Z into output slice
+template <typename T>
+class SeparableFilter
+{
+public:
+    struct Buffers
+    {
+        std::vector<float> paddedRow;
+        std::vector<float> sliceX;
+        std::vector<float> ring;
+        std::vector<int> ringZ;
+        std::vector<float> out;
+        std::vector<const float*> rows; ///< input rows of X and Y passes
+        std::vector<const float*> slices; ///< input slices of Z pass
+    };
+
+    SeparableFilter( const VoxelsVolume<Vector<T, VoxelId>>& src, Vector<T, VoxelId>& dst, VoxelFilterType type, int r )
+        : src_( src ), dst_( dst ), combine_( type, r ), r_( r ), sizeXY_( size_t( src.dims.x ) * src.dims.y )
+    {}
+
+    /// filters output slices [zBegin, zEnd)
+    void processSlab( int zBegin, int zEnd, Buffers& buf ) const
+    {
+        const int n = combine_.count();
+        buf.paddedRow.resize( src_.dims.x + 2 * r_ );
+        buf.sliceX.resize( sizeXY_ );
+        buf.ring.resize( n * sizeXY_ );
+        buf.ringZ.assign( n, -1 );
+        buf.out.resize( sizeXY_ );
+        buf.rows.resize( n );
+        buf.slices.resize( n );
+
+        for ( int z = zBegin; z < zEnd; ++z )
+        {
+            for ( int k = 0; k < n; ++k )
+            {
+                const int zi = std::clamp( z + k - r_, 0, src_.dims.z - 1 );
+                float* slot = buf.ring.data() + ( zi % n ) * sizeXY_;
+                if ( buf.ringZ[zi % n] != zi )
+                {
+                    loadSlice_( zi, slot, buf );
+                    buf.ringZ[zi % n] = zi;
+                }
+                buf.slices[k] = slot;
+            }
+            combine_( buf.slices.data(), buf.out.data(), sizeXY_ );
+
+            T* dst = dst_.data() + z * sizeXY_;
+            for ( size_t i = 0; i < sizeXY_; ++i )
+                dst[i] = fromFloat<T>( buf.out[i] );
+        }
+    }
+
+private:
+    /// filters given input slice along X and Y
+    void loadSlice_( int z, float* res, Buffers& buf ) const
+    {
+        const int dimX = src_.dims.x, dimY = src_.dims.y;
+        const int n = combine_.count();
+        const T* src = src_.data.data() + z * sizeXY_;
+        float* pad = buf.paddedRow.data();
+        for ( int y = 0; y < dimY; ++y )
+        {
+            const T* srcRow = src + size_t( y ) * dimX;
+            for ( int x = 0; x < dimX; ++x )
+                pad[r_ + x] = float( srcRow[x] );
+            std::fill( pad, pad + r_, pad[r_] );
+            std::fill( pad + r_ + dimX, pad + 2 * r_ + dimX, pad[r_ + dimX - 1] );
+            for ( int k = 0; k < n; ++k )
+                buf.rows[k] = pad + k;
+            combine_( buf.rows.data(), buf.sliceX.data() + size_t( y ) * dimX, dimX );
+        }
+        for ( int y = 0; y < dimY; ++y )
+        {
+            for ( int k = 0; k < n; ++k )
+                buf.rows[k] = buf.sliceX.data() + size_t( std::clamp( y + k - r_, 0, dimY - 1 ) ) * dimX;
+            combine_( buf.rows.data(), res + size_t( y ) * dimX, dimX );
+        }
+    }
+
+    const VoxelsVolume<Vector<T, VoxelId>>& src_;
+    Vector<T, VoxelId>& dst_;
+    RowCombiner combine_;
+    int r_ = 0;
+    size_t sizeXY_ = 0;
+};
+
+/// histogram of 16-bit values for fast search of median in sliding window:
+/// the median is tracked between queries since it changes little, and coarse bins of 256 values allow skipping empty ranges quickly
+class Histogram16
+{
+public:
+    Histogram16() : fine_( 1 << 16, 0 ), coarse_( 1 << 8, 0 ) {}
+
+    void add( std::uint16_t v )
+    {
+        ++fine_[v];
+        ++coarse_[v >> 8];
+        ++count_;
+        below_ += int( v < med_ ); // branchless, since the comparison is unpredictable
+    }
+
+    void remove( std::uint16_t v )
+    {
+        --fine_[v];
+        --coarse_[v >> 8];
+        --count_;
+        below_ -= int( v < med_ );
+    }
+
+    std::uint16_t median()
+    {
+        assert( count_ > 0 );
+        const int rank = count_ / 2;
+        while ( below_ + fine_[med_] <= rank )
+        {
+            if ( ( med_ & 0xFF ) == 0 && below_ + coarse_[med_ >> 8] <= rank )
+            {
+                below_ += coarse_[med_ >> 8];
+                med_ += 0x100;
+            }
+            else
+                below_ += fine_[med_++];
+        }
+        while ( below_ > rank )
+        {
+            if ( ( med_ & 0xFF ) == 0 && below_ - coarse_[( med_ >> 8 ) - 1] > rank )
+            {
+                below_ -= coarse_[( med_ >> 8 ) - 1];
+                med_ -= 0x100;
+            }
+            else
+                below_ -= fine_[--med_];
+        }
+        return std::uint16_t( med_ );
+    }
+
+private:
+    std::vector<int> fine_;
+    std::vector<int> coarse_;
+    int count_ = 0;
+    int med_ = 0; ///< last found median
+    int below_ = 0; ///< the number of values less than med_
+};
+
+template <typename T>
+struct MedianBuffers
+{
+    /// source rows in the window around current output row
+    std::vector<const T*> rows;
+    /// all values in the window around current voxel, only for float
+    std::vector<float> window;
+    /// the histogram of values in the window around current voxel, only for 16-bit values
+    std::conditional_t<std::is_same_v<T, float>, std::monostate, Histogram16> hist;
+};
+
+/// median filter in cubic window for each voxel of given output z-slice
+template <typename T>
+void medianSlice( const VoxelsVolume<Vector<T, VoxelId>>& src, Vector<T, VoxelId>& dst, int r, int z, MedianBuffers<T>& buf )
+{
+    const auto & dims = src.dims;
+    const int n = 2 * r + 1;
+    const size_t sizeXY = size_t( dims.x ) * dims.y;
+    T* out = dst.data() + z * sizeXY;
+    for ( int y = 0; y < dims.y; ++y, out += dims.x )
+    {
+        buf.rows.clear();
+        for ( int dz = -r; dz <= r; ++dz )
+            for ( int dy = -r; dy <= r; ++dy )
+                buf.rows.push_back( src.data.data() + std::clamp( z + dz, 0, dims.z - 1 ) * sizeXY + size_t( std::clamp( y + dy, 0, dims.y - 1 ) ) * dims.x );
+
+        if constexpr ( std::is_same_v<T, float> )
+        {
+            auto & window = buf.window;
+            for ( int x = 0; x < dims.x; ++x )
+            {
+                window.clear();
+                for ( const T* row : buf.rows )
+                    for ( int dx = -r; dx <= r; ++dx )
+                        window.push_back( row[std::clamp( x + dx, 0, dims.x - 1 )] );
+                const auto mid = window.begin() + window.size() / 2;
+                std::nth_element( window.begin(), mid, window.end() );
+                out[x] = *mid;
+            }
+        }
+        else
+        {
+            auto & hist = buf.hist;
+            auto add = [&]( int x )
+            {
+                x = std::clamp( x, 0, dims.x - 1 );
+                for ( const T* row : buf.rows )
+                    hist.add( row[x] );
+            };
+            auto remove = [&]( int x )
+            {
+                x = std::clamp( x, 0, dims.x - 1 );
+                for ( const T* row : buf.rows )
+                    hist.remove( row[x] );
+            };
+            for ( int dx = -r; dx <= r; ++dx )
+                add( dx );
+            for ( int x = 0; x < dims.x; ++x )
+            {
+                out[x] = hist.median();
+                remove( x - r );
+                add( x + r + 1 );
+            }
+            // restore empty histogram for the next row
+            for ( int x = dims.x - r; x < dims.x - r + n; ++x )
+                remove( x );
+        }
+    }
+}
+
+template <typename T>
+Expected<VoxelsVolumeMinMax<Vector<T, VoxelId>>> voxelFilterT( const VoxelsVolume<Vector<T, VoxelId>>& volume, VoxelFilterType type, int width, const ProgressCallback& cb )
+{
+    MR_TIMER;
+    if ( width < 1 || width % 2 == 0 )
+        return unexpected( "Width of the filtering window must be an odd positive number" );
+    const auto & dims = volume.dims;
+    if ( size_t( dims.x ) * dims.y * dims.z != volume.data.size() )
+        return unexpected( "Volume dimensions do not correspond to the number of voxels" );
+
+    VoxelsVolumeMinMax<Vector<T, VoxelId>> res;
+    res.dims = dims;
+    res.voxelSize = volume.voxelSize;
+    const int r = ( width - 1 ) / 2;
+    if ( r == 0 || volume.data.empty() )
+    {
+        res.data = volume.data;
+    }
+    else if ( type == VoxelFilterType::Median )
+    {
+        res.data.resize( volume.data.size() );
+        tbb::enumerable_thread_specific<MedianBuffers<T>> tls;
+        if ( !ParallelFor( 0, dims.z, tls, [&]( int z, MedianBuffers<T>& buf )
+        {
+            medianSlice( volume, res.data, r, z, buf );
+        }, cb, 1 ) )
+            return unexpectedOperationCanceled();
+    }
+    else
+    {
+        res.data.resize( volume.data.size() );
+        const SeparableFilter<T> filter( volume, res.data, type, r );
+        using Buffers = typename SeparableFilter<T>::Buffers;
+        tbb::enumerable_thread_specific<Buffers> tls;
+        const int numSlabs = ( dims.z + cSlabSize - 1 ) / cSlabSize;
+        if ( !ParallelFor( 0, numSlabs, tls, [&]( int slab, Buffers& buf )
+        {
+            filter.processSlab( slab * cSlabSize, std::min( ( slab + 1 ) * cSlabSize, dims.z ), buf );
+        }, cb, 1 ) )
+            return unexpectedOperationCanceled();
+    }
+
+    std::tie( res.min, res.max ) = parallelMinMax( res.data );
+    return res;
+}
+
+} // anonymous namespace
 
 VdbVolume voxelFilter( const VdbVolume& volume, VoxelFilterType type, int width )
 {
@@ -51,4 +406,14 @@ VdbVolume voxelFilter( const VdbVolume& volume, VoxelFilterType type, int width
     return res;
 }
 
-}
\ No newline at end of file
+Expected<SimpleVolumeMinMax> voxelFilter( const SimpleVolume& volume, VoxelFilterType type, int width, const ProgressCallback& cb )
+{
+    return voxelFilterT( volume, type, width, cb );
+}
+
+Expected<SimpleVolumeMinMaxU16> voxelFilter( const SimpleVolumeU16& volume, VoxelFilterType type, int width, const ProgressCallback& cb )
+{
+    return voxelFilterT( volume, type, width, cb );
+}
+
+}
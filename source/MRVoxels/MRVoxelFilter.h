@@ -1,6 +1,7 @@
 #pragma once
 
 #include "MRVoxelsFwd.h"
+#include "MRMesh/MRExpected.h"
 
 
 namespace MR
@@ -10,12 +11,22 @@ enum class VoxelFilterType : int
 {
     Median,
     Mean,
-    Gaussian
+    Gaussian,
+    Minimum, ///< morphological erosion, only for dense volumes
+    Maximum  ///< morphological dilation, only for dense volumes
 };
 
 /// Performs voxels filtering.
-/// @param type Type of fitler
+/// @param type Type of fitler, Minimum and Maximum are not supported here
 /// @param width Width of the filtering window, must be an odd number greater or equal to 1.
 MRVOXELS_API VdbVolume voxelFilter( const VdbVolume& volume, VoxelFilterType type, int width );
 
-}
\ No newline at end of file
+/// Performs filtering of dense volume: Mean, Gaussian (with sigma equal to half of window radius), Minimum and Maximum
+/// are computed by separable passes along X, Y and Z axes, and Median is computed in full cubic window (using sliding histogram for 16-bit values);
+/// the voxels outside the volume are assumed equal to the closest voxels inside;
+/// Z-slabs of the volume are processed in parallel, and the inner loops operate on whole rows and slices to be vectorized by the compiler
+/// @param width Width of the filtering window, must be an odd number greater or equal to 1.
+MRVOXELS_API Expected<SimpleVolumeMinMax> voxelFilter( const SimpleVolume& volume, VoxelFilterType type, int width, const ProgressCallback& cb = {} );
+MRVOXELS_API Expected<SimpleVolumeMinMaxU16> voxelFilter( const SimpleVolumeU16& volume, VoxelFilterType type, int width, const ProgressCallback& cb = {} );
+
+}
@@ -1114,6 +1114,75 @@ inline bool VoxelGraphCut::isGrandparent_( SeqVoxelId s, SeqVoxelId sGrand ) con
     }
 }
 
+/// returns the end of 2x2x2 block starting at given fine voxel, clipped by fine dimensions
+inline Vector3i blockEnd( const Vector3i & fineMin, const Vector3i & fineDims )
+{
+    return { std::min( fineMin.x + 2, fineDims.x ), std::min( fineMin.y + 2, fineDims.y ), std::min( fineMin.z + 2, fineDims.z ) };
+}
+
+/// returns the volume with the density averaged in 2x2x2 blocks (partial blocks on the boundary are averaged over existing voxels)
+SimpleVolume downsampleVolume( const SimpleVolume & volume, const VolumeIndexer & coarseIndexer )
+{
+    MR_TIMER;
+    const VolumeIndexer fineIndexer( volume.dims );
+    SimpleVolume res;
+    res.dims = coarseIndexer.dims();
+    res.voxelSize = 2.0f * volume.voxelSize;
+    res.data.resize( coarseIndexer.size() );
+    ParallelFor( res.data, [&] ( VoxelId cv )
+    {
+        const auto fineMin = 2 * coarseIndexer.toPos( cv );
+        const auto fineMax = blockEnd( fineMin, volume.dims );
+        float sum = 0;
+        int count = 0;
+        for ( int z = fineMin.z; z < fineMax.z; ++z )
+            for ( int y = fineMin.y; y < fineMax.y; ++y )
+                for ( int x = fineMin.x; x < fineMax.x; ++x )
+                {
+                    sum += volume.data[fineIndexer.toVoxelId( { x, y, z } )];
+                    ++count;
+                }
+        res.data[cv] = sum / count;
+    } );
+    return res;
+}
+
+/// returns the mask of coarse voxels having at least one fine voxel from given mask in their blocks
+VoxelBitSet downsampleMask( const VoxelBitSet & fineMask, const VolumeIndexer & fineIndexer, const VolumeIndexer & coarseIndexer )
+{
+    MR_TIMER;
+    VoxelBitSet res( coarseIndexer.size() );
+    BitSetParallelForAll( res, [&] ( VoxelId cv )
+    {
+        const auto fineMin = 2 * coarseIndexer.toPos( cv );
+        const auto fineMax = blockEnd( fineMin, fineIndexer.dims() );
+        for ( int z = fineMin.z; z < fineMax.z; ++z )
+            for ( int y = fineMin.y; y < fineMax.y; ++y )
+                for ( int x = fineMin.x; x < fineMax.x; ++x )
+                {
+                    if ( fineMask.test( fineIndexer.toVoxelId( { x, y, z } ) ) )
+                    {
+                        res.set( cv );
+                        return;
+                    }
+                }
+    } );
+    return res;
+}
+
+/// returns the mask of fine voxels, which coarse voxels are in given mask
+VoxelBitSet upsampleMask( const VoxelBitSet & coarseMask, const VolumeIndexer & coarseIndexer, const VolumeIndexer & fineIndexer )
+{
+    MR_TIMER;
+    VoxelBitSet res( fineIndexer.size() );
+    BitSetParallelForAll( res, [&] ( VoxelId fv )
+    {
+        if ( coarseMask.test( coarseIndexer.toVoxelId( fineIndexer.toPos( fv ) / 2 ) ) )
+            res.set( fv );
+    } );
+    return res;
+}
+
 } // anonymous namespace
 
 Expected<VoxelBitSet> segmentVolumeByGraphCut( const SimpleVolume & densityVolume, float k, const VoxelBitSet & sourceSeeds, const VoxelBitSet & sinkSeeds, ProgressCallback cb )
@@ -1193,4 +1262,53 @@ Expected<VoxelBitSet> segmentVolumeByGraphCut( const SimpleVolume & densityVolum
     return vgc.getResult( sourceSeeds );
 }
 
+Expected<VoxelBitSet> segmentVolumeByGraphCutMultiLevel( const SimpleVolume & densityVolume, float k, const VoxelBitSet & sourceSeeds, const VoxelBitSet & sinkSeeds,
+    const VoxelGraphCutMultiLevelParams & params, ProgressCallback cb )
+{
+    MR_TIMER;
+
+    const auto & dims = densityVolume.dims;
+    const Vector3i coarseDims( ( dims.x + 1 ) / 2, ( dims.y + 1 ) / 2, ( dims.z + 1 ) / 2 );
+    if ( params.levels <= 0 || std::min( { coarseDims.x, coarseDims.y, coarseDims.z } ) < params.minCoarseDim )
+        return segmentVolumeByGraphCut( densityVolume, k, sourceSeeds, sinkSeeds, cb );
+
+    const VolumeIndexer fineIndexer( dims );
+    const VolumeIndexer coarseIndexer( coarseDims );
+    auto coarseSourceSeeds = downsampleMask( sourceSeeds, fineIndexer, coarseIndexer );
+    auto coarseSinkSeeds = downsampleMask( sinkSeeds, fineIndexer, coarseIndexer );
+    // the blocks with the seeds of both kinds are classified by graph-cut
+    const auto bothSeeds = coarseSourceSeeds & coarseSinkSeeds;
+    coarseSourceSeeds -= bothSeeds;
+    coarseSinkSeeds -= bothSeeds;
+    if ( coarseSourceSeeds.none() || coarseSinkSeeds.none() )
+    {
+        spdlog::info( "VoxelGraphCut: seeds cannot be represented on coarse level, segmenting on full resolution" );
+        return segmentVolumeByGraphCut( densityVolume, k, sourceSeeds, sinkSeeds, cb );
+    }
+
+    auto coarseParams = params;
+    --coarseParams.levels;
+    // averaging splits a sharp step of density between two coarse edges, so k is doubled to keep the preference of the same boundaries
+    const auto coarseRes = segmentVolumeByGraphCutMultiLevel( downsampleVolume( densityVolume, coarseIndexer ), 2 * k,
+        coarseSourceSeeds, coarseSinkSeeds, coarseParams, subprogress( cb, 0.0f, 0.3f ) );
+    if ( !coarseRes )
+        return coarseRes;
+
+    // the voxels farther than bandWidth from the upsampled coarse cut become the seeds of corresponding side
+    auto fineSourceSeeds = upsampleMask( *coarseRes, coarseIndexer, fineIndexer );
+    auto fineSinkSeeds = fineSourceSeeds;
+    fineSinkSeeds.flip();
+    const int bandWidth = std::max( 1, params.bandWidth );
+    shrinkVoxelsMask( fineSourceSeeds, fineIndexer, bandWidth );
+    shrinkVoxelsMask( fineSinkSeeds, fineIndexer, bandWidth );
+    fineSourceSeeds -= sinkSeeds;
+    fineSourceSeeds |= sourceSeeds;
+    fineSinkSeeds -= sourceSeeds;
+    fineSinkSeeds |= sinkSeeds;
+    if ( !reportProgress( cb, 0.35f ) )
+        return unexpectedOperationCanceled();
+
+    return segmentVolumeByGraphCut( densityVolume, k, fineSourceSeeds, fineSinkSeeds, subprogress( cb, 0.35f, 1.0f ) );
+}
+
 } // namespace MR
@@ -19,4 +19,29 @@ namespace MR
  */
 MRVOXELS_API Expected<VoxelBitSet> segmentVolumeByGraphCut( const SimpleVolume& densityVolume, float k, const VoxelBitSet& sourceSeeds, const VoxelBitSet& sinkSeeds, ProgressCallback cb = {} );
 
+/// parameters of coarse-to-fine graph-cut segmentation
+struct VoxelGraphCutMultiLevelParams
+{
+    /// the number of coarse levels, each one twice smaller than the previous one along every axis;
+    /// the cut is found on the coarsest level first, and zero means the segmentation on full resolution only
+    int levels = 1;
+
+    /// the width of the band (in voxels of finer level) on both sides of the coarse cut, where the voxels are classified on finer level;
+    /// all voxels outside the band get the side of the coarse cut
+    int bandWidth = 3;
+
+    /// the coarse level is not created if any its dimension is less than this value
+    int minCoarseDim = 16;
+};
+
+/**
+ * \brief Segment voxels of given volume on two sets using graph-cut, returning source set;
+ * the volume is averaged in 2x2x2 blocks and segmented on coarse level first (recursively), then on full resolution
+ * only the voxels in the narrow band around the upsampled coarse cut are classified, which requires much less memory and time for large volumes
+ * \ingroup VoxelGroup
+ * \param k, sourceSeeds, sinkSeeds - the same as in segmentVolumeByGraphCut
+ */
+MRVOXELS_API Expected<VoxelBitSet> segmentVolumeByGraphCutMultiLevel( const SimpleVolume& densityVolume, float k, const VoxelBitSet& sourceSeeds, const VoxelBitSet& sinkSeeds,
+    const VoxelGraphCutMultiLevelParams& params = {}, ProgressCallback cb = {} );
+
 } // namespace MR
@@ -27,11 +27,13 @@ namespace MR
 class ObjectVoxels;
 
 class FloatGrid;
+class SparseGrid;
 
 MR_CANONICAL_TYPEDEFS( (template <typename T> struct), MRVOXELS_CLASS VoxelsVolumeMinMax,
     ( SimpleVolumeMinMax, VoxelsVolumeMinMax<Vector<float, VoxelId>> )
     ( SimpleVolumeMinMaxU16, VoxelsVolumeMinMax<Vector<uint16_t, VoxelId>> )
     ( VdbVolume, VoxelsVolumeMinMax<FloatGrid> )
+    ( SparseVolume, VoxelsVolumeMinMax<SparseGrid> )
 )
 
 using VdbVolumes = std::vector<VdbVolume>;
@@ -3,10 +3,59 @@
 #include "MRMesh/MRTimer.h"
 #include "MRMesh/MRVolumeIndexer.h"
 #include "MRMesh/MRParallelMinMax.h"
+#include "MRMesh/MRParallelFor.h"
 
 namespace MR
 {
 
+namespace
+{
+
+/// fills all bricks of sparse volume by the values returned from getter( pos ) in parallel
+template <typename G>
+Expected<SparseVolume> toSparseVolume( const Vector3i& dims, const Vector3f& voxelSize, G&& getter, const BrickValueGetter& brickValue, const ProgressCallback& cb )
+{
+    SparseVolume res;
+    res.dims = dims;
+    res.voxelSize = voxelSize;
+    res.data = SparseGrid( dims );
+
+    constexpr int bs = SparseGrid::cBrickSize;
+    if ( !ParallelFor( size_t( 0 ), res.data.brickCount(), [&]( size_t i )
+    {
+        const auto box = res.data.brickVoxels( i );
+        if ( brickValue )
+        {
+            if ( auto v = brickValue( box ) )
+            {
+                res.data.setBrick( i, *v );
+                return;
+            }
+        }
+        std::vector<float> values( SparseGrid::cBrickVoxels );
+        Vector3i pos;
+        for ( pos.z = box.min.z; pos.z < box.max.z; ++pos.z )
+            for ( pos.y = box.min.y; pos.y < box.max.y; ++pos.y )
+            {
+                auto * row = values.data() + ( pos.y - box.min.y ) * bs + ( pos.z - box.min.z ) * bs * bs;
+                for ( pos.x = box.min.x; pos.x < box.max.x; ++pos.x )
+                    row[pos.x - box.min.x] = getter( pos );
+            }
+        res.data.setBrick( i, std::move( values ) );
+    }, cb ) )
+        return unexpectedOperationCanceled();
+
+    const auto minMax = res.data.computeMinMax();
+    if ( minMax.valid() )
+    {
+        res.min = minMax.min;
+        res.max = minMax.max;
+    }
+    return res;
+}
+
+} // anonymous namespace
+
 Expected<SimpleVolumeMinMax> functionVolumeToSimpleVolume( const FunctionVolume& volume, const ProgressCallback& cb )
 {
     MR_TIMER;
@@ -26,4 +75,44 @@ Expected<SimpleVolumeMinMax> functionVolumeToSimpleVolume( const FunctionVolume&
     return res;
 }
 
+Expected<SparseVolume> functionVolumeToSparseVolume( const FunctionVolume& volume, const BrickValueGetter& brickValue, const ProgressCallback& cb )
+{
+    MR_TIMER;
+    return toSparseVolume( volume.dims, volume.voxelSize, volume.data, brickValue, cb );
+}
+
+Expected<SparseVolume> simpleVolumeToSparseVolume( const SimpleVolume& volume, const ProgressCallback& cb )
+{
+    MR_TIMER;
+    const VolumeIndexer indexer( volume.dims );
+    return toSparseVolume( volume.dims, volume.voxelSize, [&]( const Vector3i& pos )
+    {
+        return volume.data[indexer.toVoxelId( pos )];
+    }, {}, cb );
+}
+
+Expected<SimpleVolumeMinMax> sparseVolumeToSimpleVolume( const SparseVolume& volume, const ProgressCallback& cb )
+{
+    MR_TIMER;
+    SimpleVolumeMinMax res;
+    res.voxelSize = volume.voxelSize;
+    res.dims = volume.dims;
+    res.min = volume.min;
+    res.max = volume.max;
+    VolumeIndexer indexer( res.dims );
+    res.data.resize( indexer.size() );
+
+    if ( !ParallelFor( 0, res.dims.z, [&]( int z )
+    {
+        Vector3i pos( 0, 0, z );
+        auto i = indexer.toVoxelId( pos );
+        for ( pos.y = 0; pos.y < res.dims.y; ++pos.y )
+            for ( pos.x = 0; pos.x < res.dims.x; ++pos.x, ++i )
+                res.data[i] = volume.data.value( pos );
+    }, cb ) )
+        return unexpectedOperationCanceled();
+
+    return res;
+}
+
 } //namespace MR
@@ -2,6 +2,7 @@
 
 #include "MRVoxelsFwd.h"
 #include "MRFloatGrid.h"
+#include "MRSparseGrid.h"
 
 #include "MRMesh/MRVector3.h"
 #include "MRMesh/MRBox.h"
@@ -11,6 +12,7 @@
 #include "MRMesh/MRBitSet.h"
 
 #include <limits>
+#include <optional>
 
 namespace MR
 {
@@ -42,6 +44,12 @@ struct VoxelTraits<FloatGrid>
     using ValueType = float;
 };
 
+template <>
+struct VoxelTraits<SparseGrid>
+{
+    using ValueType = float;
+};
+
 /// represents a box in 3D space subdivided on voxels stored in T
 template <typename T>
 struct VoxelsVolume
@@ -71,4 +79,18 @@ struct VoxelsVolumeMinMax : VoxelsVolume<T>, MinMax<typename VoxelsVolume<T>::Va
 /// converts function volume into simple volume
 MRVOXELS_API Expected<SimpleVolumeMinMax> functionVolumeToSimpleVolume( const FunctionVolume& volume, const ProgressCallback& callback = {} );
 
+/// returns the value of all voxels in given brick (min including, max excluding) if it is known without evaluation of each voxel
+using BrickValueGetter = std::function<std::optional<float>( const Box3i& brickVoxels )>;
+
+/// converts function volume into sparse volume evaluating the function brick by brick in parallel;
+/// \param brickValue if provided and returns a value for a brick, then the brick becomes constant tile without evaluation of the function in its voxels
+MRVOXELS_API Expected<SparseVolume> functionVolumeToSparseVolume( const FunctionVolume& volume, const BrickValueGetter& brickValue = {},
+    const ProgressCallback& callback = {} );
+
+/// converts simple volume into sparse volume, the bricks of equal values become constant tiles
+MRVOXELS_API Expected<SparseVolume> simpleVolumeToSparseVolume( const SimpleVolume& volume, const ProgressCallback& callback = {} );
+
+/// converts sparse volume into simple volume
+MRVOXELS_API Expected<SimpleVolumeMinMax> sparseVolumeToSimpleVolume( const SparseVolume& volume, const ProgressCallback& callback = {} );
+
 } //namespace MR
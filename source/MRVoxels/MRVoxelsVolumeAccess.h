@@ -94,6 +94,36 @@ public:
     using Base::Base;
 };
 
+/// VoxelsVolumeAccessor specialization for sparse volumes
+template <>
+class VoxelsVolumeAccessor<SparseVolume>
+{
+public:
+    using VolumeType = SparseVolume;
+    using ValueType = typename VolumeType::ValueType;
+    static constexpr bool cacheEffective = false; ///< caching results of this accessor does not make any sense since it returns values from dense bricks
+
+    explicit VoxelsVolumeAccessor( const VolumeType& volume )
+        : data_( volume.data )
+    {}
+
+    ValueType get( const Vector3i& pos ) const
+    {
+        return data_.value( pos );
+    }
+
+    ValueType get( const VoxelLocation & loc ) const
+    {
+        return get( loc.pos );
+    }
+
+    /// this additional shift shall be added to integer voxel coordinates during transformation in 3D space
+    Vector3f shift() const { return Vector3f::diagonal( 0.5f ); }
+
+private:
+    const SparseGrid& data_;
+};
+
 /// VoxelsVolumeAccessor specialization for value getters
 template <typename T>
 class VoxelsVolumeAccessor<VoxelsVolume<VoxelValueGetter<T>>>